@@ -0,0 +1,149 @@
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include "bench_tools.h"
+#include "ed247_stream.h"
+#include "ed247_stream_assistant.h"
+
+//
+// Stream assistants of a fixed size stream (NAD: FixedStreamAssistant)
+// and of a variable size stream (VNAD: VNADStreamAssistant).
+//
+namespace
+{
+    const char* const ASSISTANT_STREAMS[] = { "NAD", "VNAD" };
+
+    // Value of the max size of each signal of the stream
+    std::vector<std::vector<char>> signal_values(ed247::Stream& stream)
+    {
+        std::vector<std::vector<char>> values;
+        for (const ed247::signal_ptr_t& signal : stream.get_signals()) {
+            values.emplace_back(signal->get_sample_max_size_bytes(), (char)values.size());
+        }
+        return values;
+    }
+
+    bool write_signals(ed247::Stream& stream, const std::vector<std::vector<char>>& values)
+    {
+        ed247::StreamAssistant* assistant = stream.get_assistant();
+        for (uint32_t index = 0; index < values.size(); index++) {
+            if (assistant->write(*stream.get_signals()[index], values[index].data(), values[index].size()) == false) return false;
+        }
+        return true;
+    }
+
+    // Stream payload of sample_max_number samples pushed by the assistant of the sender stream
+    std::vector<char> encode_assistant_samples(const std::string& name)
+    {
+        ed247::Stream& stream = bench::sender_stream(name);
+        write_signals(stream, signal_values(stream));
+        for (uint32_t index = 0; index < stream.get_sample_max_number(); index++) {
+            stream.get_assistant()->push(nullptr, nullptr);
+        }
+        std::vector<char> payload(stream.get_max_size());
+        payload.resize(stream.encode(payload.data(), payload.size()));
+        return payload;
+    }
+
+    void assistant_write(benchmark::State& state, const std::string& name)
+    {
+        ed247::Stream& stream = bench::sender_stream(name);
+        std::vector<std::vector<char>> values = signal_values(stream);
+
+        for (auto _ : state) {
+            if (write_signals(stream, values) == false) {
+                state.SkipWithError("Write failed");
+                break;
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * values.size());
+    }
+
+    void assistant_push(benchmark::State& state, const std::string& name)
+    {
+        ed247::Stream& stream = bench::sender_stream(name);
+        write_signals(stream, signal_values(stream));
+
+        for (auto _ : state) {
+            if (stream.get_assistant()->push(nullptr, nullptr) == false) {
+                state.SkipWithError("Push failed");
+                break;
+            }
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Pop sample_max_number samples. The stream is filled by a decode, out of the measure.
+    void assistant_pop(benchmark::State& state, const std::string& name)
+    {
+        ed247::Stream& stream = bench::receiver_stream(name);
+        std::vector<char> payload = encode_assistant_samples(name);
+        ed247_sample_details_t frame_details = LIBED247_SAMPLE_DETAILS_DEFAULT;
+        uint32_t sample_number = stream.get_sample_max_number();
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            stream.decode(payload.data(), payload.size(), frame_details);
+            state.ResumeTiming();
+            for (uint32_t index = 0; index < sample_number; index++) {
+                if (stream.get_assistant()->pop(nullptr, nullptr, nullptr, nullptr) != ED247_STATUS_SUCCESS) {
+                    state.SkipWithError("Pop failed");
+                    break;
+                }
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * sample_number);
+    }
+
+    void assistant_read(benchmark::State& state, const std::string& name)
+    {
+        ed247::Stream& stream = bench::receiver_stream(name);
+        std::vector<char> payload = encode_assistant_samples(name);
+        ed247_sample_details_t frame_details = LIBED247_SAMPLE_DETAILS_DEFAULT;
+        stream.decode(payload.data(), payload.size(), frame_details);
+        stream.get_assistant()->pop(nullptr, nullptr, nullptr, nullptr);
+
+        for (auto _ : state) {
+            for (const ed247::signal_ptr_t& signal : stream.get_signals()) {
+                const void* data;
+                uint32_t size;
+                if (stream.get_assistant()->read(*signal, &data, &size) == false) {
+                    state.SkipWithError("Read failed");
+                    break;
+                }
+                benchmark::DoNotOptimize(data);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * stream.get_signals().size());
+    }
+}
+
+void bench::register_assistant_benchmarks()
+{
+    for (const char* name : ASSISTANT_STREAMS) {
+        benchmark::RegisterBenchmark((std::string("AssistantWrite/") + name).c_str(), assistant_write, name);
+        benchmark::RegisterBenchmark((std::string("AssistantPush/") + name).c_str(), assistant_push, name);
+        benchmark::RegisterBenchmark((std::string("AssistantPop/") + name).c_str(), assistant_pop, name);
+        benchmark::RegisterBenchmark((std::string("AssistantRead/") + name).c_str(), assistant_read, name);
+    }
+}
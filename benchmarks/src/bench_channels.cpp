@@ -0,0 +1,108 @@
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include "bench_tools.h"
+#include "ed247_channel.h"
+#include "ed247_stream.h"
+
+namespace
+{
+    const ed247_timestamp_t DATA_TIMESTAMP = { 1234567, 89 };
+
+    struct pushed_stream_t {
+        ed247::Stream*    stream;
+        std::vector<char> sample;
+    };
+
+    // One sample in each output stream of the channel (the frame holds all the streams)
+    std::vector<pushed_stream_t> output_streams()
+    {
+        std::vector<pushed_stream_t> streams;
+        for (const std::string& name : bench::stream_names()) {
+            ed247::Stream& stream = bench::sender_stream(name);
+            streams.push_back(pushed_stream_t{ &stream, bench::make_sample(stream) });
+        }
+        return streams;
+    }
+
+    void push(std::vector<pushed_stream_t>& streams)
+    {
+        for (pushed_stream_t& pushed : streams) {
+            pushed.stream->push_sample(pushed.sample.data(), pushed.sample.size(), &DATA_TIMESTAMP, nullptr);
+        }
+    }
+
+    void capture_frame(ed247_context_t, ed247_channel_t, const void* frame, uint32_t frame_size, void* user_data)
+    {
+        std::vector<char>* captured = (std::vector<char>*)user_data;
+        captured->assign((const char*)frame, (const char*)frame + frame_size);
+    }
+
+    // Push a sample in each stream, then encode the multichannel frame and send it over the UDP loopback
+    void channel_encode_and_send(benchmark::State& state)
+    {
+        ed247::Channel& channel = bench::sender_channel();
+        std::vector<pushed_stream_t> streams = output_streams();
+
+        for (auto _ : state) {
+            push(streams);
+            channel.encode_and_send();
+        }
+        state.SetItemsProcessed(state.iterations() * streams.size());
+        state.counters["send_errors"] = channel.get_send_error_count();
+    }
+
+    // Decode a multichannel frame that holds a sample of each stream
+    void channel_decode(benchmark::State& state)
+    {
+        ed247::Channel& channel = bench::receiver_channel();
+        std::vector<pushed_stream_t> streams = output_streams();
+
+        // Send a frame and capture it on the receiver side
+        std::vector<char> frame;
+        bench::receiver().set_frame_recv_callback(&capture_frame, &frame);
+        push(streams);
+        bench::sender_channel().encode_and_send();
+        while (frame.empty() && bench::receiver().wait_frame(1000000) == ED247_STATUS_SUCCESS) {}
+        bench::receiver().set_frame_recv_callback(nullptr, nullptr);
+        if (frame.empty()) {
+            state.SkipWithError("No frame received");
+            return;
+        }
+
+        for (auto _ : state) {
+            if (channel.decode(frame.data(), frame.size()) == false) {
+                state.SkipWithError("Decode failed");
+                break;
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * streams.size());
+        state.SetBytesProcessed(state.iterations() * frame.size());
+    }
+}
+
+void bench::register_channel_benchmarks()
+{
+    benchmark::RegisterBenchmark("ChannelEncodeAndSend", channel_encode_and_send);
+    benchmark::RegisterBenchmark("ChannelDecode", channel_decode);
+}
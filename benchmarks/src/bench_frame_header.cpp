@@ -0,0 +1,75 @@
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include "bench_tools.h"
+#include "ed247_frame_header.h"
+
+namespace
+{
+    ed247::xml::Header header_configuration(ed247_yesno_t transport_timestamp)
+    {
+        ed247::xml::Header configuration;
+        configuration._enable = ED247_YESNO_YES;
+        configuration._transport_timestamp = transport_timestamp;
+        return configuration;
+    }
+
+    void frame_header_encode(benchmark::State& state, ed247_yesno_t transport_timestamp)
+    {
+        ed247::FrameHeader header(header_configuration(transport_timestamp), 42, "BenchChannel");
+        char frame[64];
+
+        for (auto _ : state) {
+            uint32_t frame_index = 0;
+            header.encode(frame, sizeof(frame), frame_index);
+            benchmark::DoNotOptimize(frame);
+        }
+        state.SetBytesProcessed(state.iterations() * header.get_size());
+    }
+
+    void frame_header_decode(benchmark::State& state, ed247_yesno_t transport_timestamp)
+    {
+        ed247::FrameHeader header(header_configuration(transport_timestamp), 42, "BenchChannel");
+        char frame[64];
+        uint32_t frame_index = 0;
+        header.encode(frame, sizeof(frame), frame_index);
+
+        for (auto _ : state) {
+            frame_index = 0;
+            if (header.decode(frame, sizeof(frame), frame_index) == false) {
+                state.SkipWithError("Decode failed");
+                break;
+            }
+            benchmark::DoNotOptimize(header.get_recv_frame_details());
+        }
+        state.SetBytesProcessed(state.iterations() * header.get_size());
+    }
+}
+
+void bench::register_frame_header_benchmarks()
+{
+    benchmark::RegisterBenchmark("FrameHeaderEncode", frame_header_encode, ED247_YESNO_NO);
+    benchmark::RegisterBenchmark("FrameHeaderEncode/TransportTimestamp", frame_header_encode, ED247_YESNO_YES);
+    benchmark::RegisterBenchmark("FrameHeaderDecode", frame_header_decode, ED247_YESNO_NO);
+    benchmark::RegisterBenchmark("FrameHeaderDecode/TransportTimestamp", frame_header_decode, ED247_YESNO_YES);
+}
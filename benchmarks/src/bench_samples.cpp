@@ -0,0 +1,83 @@
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include "bench_tools.h"
+#include "ed247_sample.h"
+
+namespace
+{
+    const uint32_t SAMPLE_SIZE = 64;
+
+    // Push a sample in a full ring buffer (the oldest sample is overwritten)
+    void ring_buffer_push(benchmark::State& state)
+    {
+        ed247::StreamSampleRingBuffer buffer(state.range(0), SAMPLE_SIZE);
+        std::vector<char> data(SAMPLE_SIZE, 42);
+        buffer.allocate();
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(buffer.push_back().copy(data.data(), SAMPLE_SIZE));
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(state.iterations() * SAMPLE_SIZE);
+    }
+
+    // Fill the ring buffer then pop all the samples
+    void ring_buffer_push_pop(benchmark::State& state)
+    {
+        uint32_t capacity = state.range(0);
+        ed247::StreamSampleRingBuffer buffer(capacity, SAMPLE_SIZE);
+        std::vector<char> data(SAMPLE_SIZE, 42);
+        buffer.allocate();
+
+        for (auto _ : state) {
+            for (uint32_t index = 0; index < capacity; index++) {
+                buffer.push_back().copy(data.data(), SAMPLE_SIZE);
+            }
+            while (buffer.empty() == false) {
+                benchmark::DoNotOptimize(buffer.pop_front().data());
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * capacity);
+    }
+
+    void stream_sample_copy(benchmark::State& state)
+    {
+        ed247::StreamSample source(state.range(0));
+        ed247::StreamSample destination(state.range(0));
+        std::vector<char> data(state.range(0), 42);
+        source.copy(data.data(), data.size());
+
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(destination.copy(source));
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+}
+
+void bench::register_sample_benchmarks()
+{
+    benchmark::RegisterBenchmark("StreamSampleRingBuffer/Push", ring_buffer_push)->Arg(8)->Arg(1024);
+    benchmark::RegisterBenchmark("StreamSampleRingBuffer/PushPop", ring_buffer_push_pop)->Arg(8)->Arg(1024);
+    benchmark::RegisterBenchmark("StreamSample/Copy", stream_sample_copy)->Arg(4)->Arg(64)->Arg(1500);
+}
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include "bench_tools.h"
+#include "ed247_stream.h"
+
+namespace
+{
+    const ed247_timestamp_t DATA_TIMESTAMP = { 1234567, 89 };
+
+    // Push sample_max_number samples then encode them
+    void stream_encode(benchmark::State& state, const std::string& name)
+    {
+        ed247::Stream& stream = bench::sender_stream(name);
+        std::vector<char> sample = bench::make_sample(stream);
+        std::vector<char> frame(stream.get_max_size());
+        uint32_t sample_number = stream.get_sample_max_number();
+        uint32_t frame_size = 0;
+
+        for (auto _ : state) {
+            for (uint32_t index = 0; index < sample_number; index++) {
+                stream.push_sample(sample.data(), sample.size(), &DATA_TIMESTAMP, nullptr);
+            }
+            frame_size = stream.encode(frame.data(), frame.size());
+            benchmark::DoNotOptimize(frame.data());
+        }
+        state.SetItemsProcessed(state.iterations() * sample_number);
+        state.SetBytesProcessed(state.iterations() * frame_size);
+    }
+
+    // Decode sample_max_number samples then pop them
+    void stream_decode(benchmark::State& state, const std::string& name)
+    {
+        ed247::Stream& stream = bench::receiver_stream(name);
+        std::vector<char> payload = bench::encode_stream(name);
+        ed247_sample_details_t frame_details = LIBED247_SAMPLE_DETAILS_DEFAULT;
+        uint32_t sample_number = stream.get_sample_max_number();
+
+        for (auto _ : state) {
+            if (stream.decode(payload.data(), payload.size(), frame_details) == false) {
+                state.SkipWithError("Decode failed");
+                break;
+            }
+            bool empty = false;
+            while (empty == false) {
+                benchmark::DoNotOptimize(stream.pop_sample(&empty).data());
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * sample_number);
+        state.SetBytesProcessed(state.iterations() * payload.size());
+    }
+}
+
+void bench::register_stream_benchmarks()
+{
+    for (const std::string& name : stream_names()) {
+        benchmark::RegisterBenchmark(("StreamEncode/" + name).c_str(), stream_encode, name);
+    }
+    for (const std::string& name : stream_names()) {
+        benchmark::RegisterBenchmark(("StreamDecode/" + name).c_str(), stream_decode, name);
+    }
+}
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include "bench_tools.h"
+#include "ed247_channel.h"
+#include "ed247_stream.h"
+
+namespace
+{
+    const ed247_timestamp_t DATA_TIMESTAMP = { 1234567, 89 };
+
+    ed247::Context* load(const std::string& filename)
+    {
+        return ed247::Context::create_from_filepath(std::string(BENCHMARK_CONFIG_PATH) + "/" + filename);
+    }
+}
+
+ed247::Context& bench::sender()
+{
+    static std::unique_ptr<ed247::Context> context(load("ecic_bench_sender.xml"));
+    return *context;
+}
+
+ed247::Context& bench::receiver()
+{
+    static std::unique_ptr<ed247::Context> context(load("ecic_bench_receiver.xml"));
+    return *context;
+}
+
+ed247::Stream& bench::sender_stream(const std::string& name)
+{
+    return *sender().get_stream_set().get(name);
+}
+
+ed247::Stream& bench::receiver_stream(const std::string& name)
+{
+    return *receiver().get_stream_set().get(name);
+}
+
+ed247::Channel& bench::sender_channel()
+{
+    return *sender().get_channel_set().get("BenchChannel");
+}
+
+ed247::Channel& bench::receiver_channel()
+{
+    return *receiver().get_channel_set().get("BenchChannel");
+}
+
+const std::vector<std::string>& bench::stream_names()
+{
+    static const std::vector<std::string> names = {
+        "A429", "A429_DT", "A664", "A664_DT", "A825", "A825_DT", "SERIAL", "SERIAL_DT", "ETH", "ETH_DT",
+        "DIS", "DIS_DT", "ANA", "ANA_DT", "NAD", "NAD_DT", "VNAD", "VNAD_DT"
+    };
+    return names;
+}
+
+std::vector<char> bench::make_sample(const ed247::Stream& stream)
+{
+    std::vector<char> sample(stream.get_sample_max_size_bytes());
+    for (uint32_t index = 0; index < sample.size(); index++) sample[index] = (char)index;
+    return sample;
+}
+
+std::vector<char> bench::encode_stream(const std::string& name)
+{
+    ed247::Stream& stream = sender_stream(name);
+    std::vector<char> sample = make_sample(stream);
+    for (uint32_t index = 0; index < stream.get_sample_max_number(); index++) {
+        stream.push_sample(sample.data(), sample.size(), &DATA_TIMESTAMP, nullptr);
+    }
+
+    std::vector<char> payload(stream.get_max_size());
+    payload.resize(stream.encode(payload.data(), payload.size()));
+    return payload;
+}
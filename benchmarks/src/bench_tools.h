@@ -0,0 +1,65 @@
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef _BENCH_TOOLS_H_
+#define _BENCH_TOOLS_H_
+#include "ed247_context.h"
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+
+//
+// The benchmarks run on the streams of two contexts loaded once:
+// a sender (output streams) and a receiver (input streams) of the same
+// multichannel, over the UDP loopback.
+// Each stream type has a stream named after it ("A664") and a stream with
+// data timestamps ("A664_DT").
+//
+namespace bench
+{
+    ed247::Context& sender();
+    ed247::Context& receiver();
+
+    ed247::Stream& sender_stream(const std::string& name);
+    ed247::Stream& receiver_stream(const std::string& name);
+    ed247::Channel& sender_channel();
+    ed247::Channel& receiver_channel();
+
+    // Names of the benchmark streams, with and without data timestamps
+    const std::vector<std::string>& stream_names();
+
+    // Sample of the stream max size filled with a counter
+    std::vector<char> make_sample(const ed247::Stream& stream);
+
+    // Stream payload holding sample_max_number samples, as encoded by the sender stream
+    std::vector<char> encode_stream(const std::string& name);
+
+    // Register the benchmarks of each file (called by main)
+    void register_stream_benchmarks();
+    void register_channel_benchmarks();
+    void register_frame_header_benchmarks();
+    void register_assistant_benchmarks();
+    void register_sample_benchmarks();
+}
+
+#endif
@@ -96,6 +96,74 @@ ed247_status_t ed247_get_log_level(
   return ED247_STATUS_SUCCESS;
 }
 
+ed247_status_t ed247_set_ecic_validation_cache(
+  const char * cache_filepath)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  try{
+    ed247::xml::set_validation_cache(cache_filepath);
+  }
+  LIBED247_CATCH("Set ECIC validation cache");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_set_lazy_allocation(
+  ed247_yesno_t enable)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  try{
+    ed247::Stream::set_lazy_allocation(enable == ED247_YESNO_YES);
+  }
+  LIBED247_CATCH("Set lazy allocation");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_set_transport(
+  ed247_transport_t transport)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(transport != ED247_TRANSPORT_UDP && transport != ED247_TRANSPORT_LOOPBACK && transport != ED247_TRANSPORT_SHM){
+    PRINT_ERROR(__func__ << ": Invalid transport");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::udp::ReceiverSet::set_default_transport(transport);
+  }
+  LIBED247_CATCH("Set transport");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_name_pattern_compile(
+  const char *           regex_name,
+  ed247_name_pattern_t * pattern)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!pattern) {
+    PRINT_ERROR(__func__ << ": Invalid pattern pointer");
+    return ED247_STATUS_FAILURE;
+  }
+
+  *pattern = nullptr;
+
+  try{
+    *pattern = new ed247::NamePattern(regex_name != nullptr ? std::string(regex_name) : std::string(".*"));
+  }
+  LIBED247_CATCH("Compile name pattern");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_name_pattern_free(
+  ed247_name_pattern_t pattern)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!pattern) {
+    PRINT_ERROR(__func__ << ": Invalid pattern");
+    return ED247_STATUS_FAILURE;
+  }
+  delete static_cast<ed247::NamePattern*>(pattern);
+  return ED247_STATUS_SUCCESS;
+}
+
 // Deprecated
 const char * libed247_errors()
 {
@@ -143,6 +211,28 @@ ed247_status_t ed247_load_file(
   return ED247_STATUS_SUCCESS;
 }
 
+ed247_status_t ed247_load_file_streaming(
+  const char *      ecic_file_path,
+  ed247_context_t * context)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+
+  if(!context) {
+    PRINT_ERROR(__func__ << ": Empty context pointer");
+    return ED247_STATUS_FAILURE;
+  }
+  *context = nullptr;
+  if(!ecic_file_path){
+    PRINT_ERROR(__func__ << ": Empty file");
+    return ED247_STATUS_FAILURE;
+  }
+  try {
+    *context = ed247::Context::create_from_filepath_streaming(ecic_file_path);
+  }
+  LIBED247_CATCH("Load streaming");
+  return ED247_STATUS_SUCCESS;
+}
+
 ed247_status_t ed247_load_content(
   const char *      ecic_file_content,
   ed247_context_t * context)
@@ -165,6 +255,114 @@ ed247_status_t ed247_load_content(
   return ED247_STATUS_SUCCESS;
 }
 
+namespace {
+  ed247::xml::Component::stream_filter_t make_stream_filter(ed247_stream_filter_t filter, void* user_data)
+  {
+    return [filter, user_data](const ed247::xml::Channel& channel, const ed247::xml::Stream& stream) {
+      return filter(channel._name.c_str(), stream._name.c_str(), user_data);
+    };
+  }
+}
+
+ed247_status_t ed247_load_file_filtered(
+  const char *          ecic_file_path,
+  ed247_stream_filter_t filter,
+  void *                user_data,
+  ed247_context_t *     context)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+
+  if(!context) {
+    PRINT_ERROR(__func__ << ": Empty context pointer");
+    return ED247_STATUS_FAILURE;
+  }
+  *context = nullptr;
+  if(!ecic_file_path){
+    PRINT_ERROR(__func__ << ": Empty file");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!filter){
+    PRINT_ERROR(__func__ << ": Invalid filter");
+    return ED247_STATUS_FAILURE;
+  }
+  try {
+    *context = ed247::Context::create_from_filepath(ecic_file_path, make_stream_filter(filter, user_data));
+  }
+  LIBED247_CATCH("Load filtered");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_load_content_filtered(
+  const char *          ecic_file_content,
+  ed247_stream_filter_t filter,
+  void *                user_data,
+  ed247_context_t *     context)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+
+  if(!context) {
+    PRINT_ERROR(__func__ << ": Empty context pointer");
+    return ED247_STATUS_FAILURE;
+  }
+  *context = nullptr;
+  if(!ecic_file_content) {
+    PRINT_ERROR(__func__ << ": Empty content");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!filter){
+    PRINT_ERROR(__func__ << ": Invalid filter");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    *context = ed247::Context::create_from_content(ecic_file_content, make_stream_filter(filter, user_data));
+  }
+  LIBED247_CATCH("Load content filtered");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_load_compiled(
+  const char *      compiled_file_path,
+  ed247_context_t * context)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+
+  if(!context) {
+    PRINT_ERROR(__func__ << ": Empty context pointer");
+    return ED247_STATUS_FAILURE;
+  }
+  *context = nullptr;
+  if(!compiled_file_path){
+    PRINT_ERROR(__func__ << ": Empty file");
+    return ED247_STATUS_FAILURE;
+  }
+  try {
+    *context = ed247::Context::create_from_compiled(compiled_file_path);
+  }
+  LIBED247_CATCH("Load compiled");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_compile_file(
+  const char * ecic_file_path,
+  const char * compiled_file_path)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+
+  if(!ecic_file_path){
+    PRINT_ERROR(__func__ << ": Empty file");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!compiled_file_path){
+    PRINT_ERROR(__func__ << ": Empty compiled file");
+    return ED247_STATUS_FAILURE;
+  }
+  try {
+    ed247::xml::save_compiled(*ed247::xml::load_filepath(ecic_file_path), compiled_file_path);
+  }
+  LIBED247_CATCH("Compile");
+  return ED247_STATUS_SUCCESS;
+}
+
 ed247_status_t ed247_unload(
   ed247_context_t context)
 {
@@ -223,6 +421,63 @@ ed247_status_t ed247_component_get_user_data(
   return ED247_STATUS_SUCCESS;
 }
 
+ed247_status_t ed247_component_get_memory_footprint(
+  ed247_context_t            context,
+  ed247_memory_footprint_t * footprint)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!context) {
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!footprint) {
+    PRINT_ERROR(__func__ << ": Invalid footprint");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_context = static_cast<ed247::Context*>(context);
+    *footprint = ed247_memory_footprint_t{0, 0};
+    ed247_context->add_memory_footprint(*footprint);
+  }
+  LIBED247_CATCH("Get memory footprint");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_component_set_conflation(
+  ed247_context_t context,
+  ed247_yesno_t   enable)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!context) {
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_context = static_cast<ed247::Context*>(context);
+    ed247_context->set_conflation(enable == ED247_YESNO_YES);
+  }
+  LIBED247_CATCH("Set context conflation");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_component_set_busy_poll(
+  ed247_context_t context,
+  uint32_t        spin_budget_us,
+  uint32_t        socket_busy_poll_us)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!context) {
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_context = static_cast<ed247::Context*>(context);
+    ed247_context->get_receiver_set().set_busy_poll(spin_budget_us, socket_busy_poll_us);
+  }
+  LIBED247_CATCH("Set context busy poll");
+  return ED247_STATUS_SUCCESS;
+}
+
 // Deprecated
 ed247_status_t ed247_load(
   const char * ecic_file_path,
@@ -353,6 +608,39 @@ ed247_status_t ed247_find_channels(
   return ED247_STATUS_SUCCESS;
 }
 
+ed247_status_t ed247_find_channels_with_pattern(
+  ed247_context_t       context,
+  ed247_name_pattern_t  pattern,
+  ed247_channel_list_t * channels)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!channels) {
+    PRINT_ERROR(__func__ << ": Invalid channels pointer");
+    return ED247_STATUS_FAILURE;
+  }
+
+  *channels = nullptr;
+
+  if(!context) {
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!pattern) {
+    PRINT_ERROR(__func__ << ": Invalid pattern");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::Context* ed247_context = static_cast<ed247::Context*>(context);
+    *channels =
+      ed247::client_list_container<ed247_internal_channel_list_t,
+                                   ed247::Channel,
+                                   ed247::channel_list_t>
+      ::copy(ed247_context->get_channel_set().find(*static_cast<ed247::NamePattern*>(pattern)));
+  }
+  LIBED247_CATCH("Find channels");
+  return ED247_STATUS_SUCCESS;
+}
+
 ed247_status_t ed247_get_channel(
   ed247_context_t   context,
   const char *      name,
@@ -441,6 +729,39 @@ ed247_status_t ed247_find_streams(
   return ED247_STATUS_SUCCESS;
 }
 
+ed247_status_t ed247_find_streams_with_pattern(
+  ed247_context_t       context,
+  ed247_name_pattern_t  pattern,
+  ed247_stream_list_t * streams)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!streams) {
+    PRINT_ERROR(__func__ << ": Invalid streams pointer");
+    return ED247_STATUS_FAILURE;
+  }
+
+  *streams = nullptr;
+
+  if(!context) {
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!pattern) {
+    PRINT_ERROR(__func__ << ": Invalid pattern");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::Context* ed247_context = static_cast<ed247::Context*>(context);
+    *streams =
+      ed247::client_list_container<ed247_internal_stream_list_t,
+                                   ed247::Stream,
+                                   ed247::stream_list_t>
+      ::copy(ed247_context->get_stream_set().find(*static_cast<ed247::NamePattern*>(pattern)));
+  }
+  LIBED247_CATCH("Find streams");
+  return ED247_STATUS_SUCCESS;
+}
+
 ed247_status_t ed247_get_stream(
   ed247_context_t  context,
   const char *     name,
@@ -504,35 +825,68 @@ ed247_status_t ed247_find_signals(
   return ED247_STATUS_SUCCESS;
 }
 
-ed247_status_t ed247_get_signal(
-  ed247_context_t  context,
-  const char *     name,
-  ed247_signal_t * signal)
+ed247_status_t ed247_find_signals_with_pattern(
+  ed247_context_t       context,
+  ed247_name_pattern_t  pattern,
+  ed247_signal_list_t * signals)
 {
   PRINT_DEBUG("function " << __func__ << "()");
+  if(!signals) {
+    PRINT_ERROR(__func__ << ": Invalid signals pointer");
+    return ED247_STATUS_FAILURE;
+  }
+
+  *signals = nullptr;
 
   if(!context) {
     PRINT_ERROR(__func__ << ": Invalid context");
     return ED247_STATUS_FAILURE;
   }
-  if(!name) {
-    PRINT_ERROR(__func__ << ": Invalid name");
-    return ED247_STATUS_FAILURE;
-  }
-  if(!signal) {
-    PRINT_ERROR(__func__ << ": Invalid signal pointer ");
+  if(!pattern) {
+    PRINT_ERROR(__func__ << ": Invalid pattern");
     return ED247_STATUS_FAILURE;
   }
   try{
     ed247::Context* ed247_context = static_cast<ed247::Context*>(context);
-    *signal = ed247_context->get_signal_set().get(name).get();
-    if(*signal == nullptr) {
-      PRINT_INFO("Cannot find signal '" << name << "'");
-      return ED247_STATUS_FAILURE;
-    }
-  }
-  LIBED247_CATCH("Get signal");
-  return ED247_STATUS_SUCCESS;
+    *signals =
+      ed247::client_list_container<ed247_internal_signal_list_t,
+                                   ed247::Signal,
+                                   ed247::signal_list_t>
+      ::copy(ed247_context->get_signal_set().find(*static_cast<ed247::NamePattern*>(pattern)));
+  }
+  LIBED247_CATCH("Find signals");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_get_signal(
+  ed247_context_t  context,
+  const char *     name,
+  ed247_signal_t * signal)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+
+  if(!context) {
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!name) {
+    PRINT_ERROR(__func__ << ": Invalid name");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!signal) {
+    PRINT_ERROR(__func__ << ": Invalid signal pointer ");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::Context* ed247_context = static_cast<ed247::Context*>(context);
+    *signal = ed247_context->get_signal_set().get(name).get();
+    if(*signal == nullptr) {
+      PRINT_INFO("Cannot find signal '" << name << "'");
+      return ED247_STATUS_FAILURE;
+    }
+  }
+  LIBED247_CATCH("Get signal");
+  return ED247_STATUS_SUCCESS;
 }
 
 // Deprecated
@@ -610,6 +964,89 @@ ed247_status_t ed247_wait_during(
   return ED247_STATUS_SUCCESS;
 }
 
+ed247_status_t ed247_process_pending_frames(
+  ed247_context_t       context,
+  ed247_stream_list_t * streams)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+
+  if(!context) {
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+
+  if(streams != nullptr) *streams = nullptr;
+
+  try{
+    ed247::Context* ed247_context = static_cast<ed247::Context*>(context);
+    ed247_status_t ed247_status = ed247_context->process_pending_frames();
+    if(streams != nullptr && ed247_status == ED247_STATUS_SUCCESS) {
+      *streams = ed247_context->get_client_streams_with_data();
+      ((ed247_stream_clist_base_t*)*streams)->reset_iterator();
+    }
+    return ed247_status;
+  }
+  LIBED247_CATCH("Process pending frames");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_get_readiness_fd(
+  ed247_context_t context,
+  int *           fd)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!context) {
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!fd) {
+    PRINT_ERROR(__func__ << ": Invalid fd pointer");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::Context* ed247_context = static_cast<ed247::Context*>(context);
+    *fd = ed247_context->get_receiver_set().get_readiness_fd();
+  }
+  LIBED247_CATCH("Get readiness fd");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_set_frame_recv_callback(
+  ed247_context_t             context,
+  ed247_frame_recv_callback_t callback,
+  void *                      user_data)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!context) {
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::Context* ed247_context = static_cast<ed247::Context*>(context);
+    ed247_context->set_frame_recv_callback(callback, user_data);
+  }
+  LIBED247_CATCH("Set frame receive callback");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_set_datagram_recv_callback(
+  ed247_context_t                context,
+  ed247_datagram_recv_callback_t callback,
+  void *                         user_data)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!context) {
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::Context* ed247_context = static_cast<ed247::Context*>(context);
+    ed247_context->set_datagram_recv_callback(callback, user_data);
+  }
+  LIBED247_CATCH("Set datagram receive callback");
+  return ED247_STATUS_SUCCESS;
+}
+
 ed247_status_t ed247_send_pushed_samples(
   ed247_context_t context)
 {
@@ -626,6 +1063,145 @@ ed247_status_t ed247_send_pushed_samples(
   return ED247_STATUS_SUCCESS;
 }
 
+ed247_status_t ed247_scheduler_run(
+  ed247_context_t context,
+  int32_t         duration_us)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!context){
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_context = static_cast<ed247::Context*>(context);
+    return ed247_context->get_scheduler().run(duration_us);
+  }
+  LIBED247_CATCH("Run scheduler");
+}
+
+ed247_status_t ed247_scheduler_get_stats(
+  ed247_context_t           context,
+  ed247_scheduler_stats_t * stats,
+  uint32_t *                count)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!context){
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!count){
+    PRINT_ERROR(__func__ << ": Invalid count");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!stats && *count != 0){
+    PRINT_ERROR(__func__ << ": Invalid stats");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_context = static_cast<ed247::Context*>(context);
+    const auto& scheduler_stats = ed247_context->get_scheduler().get_stats();
+    for (uint32_t index = 0; index < *count && index < scheduler_stats.size(); index++) {
+      stats[index] = scheduler_stats[index];
+    }
+    *count = scheduler_stats.size();
+  }
+  LIBED247_CATCH("Get scheduler stats");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_scheduler_reset(
+  ed247_context_t context)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!context){
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_context = static_cast<ed247::Context*>(context);
+    ed247_context->get_scheduler().reset();
+  }
+  LIBED247_CATCH("Reset scheduler");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_async_send_enable(
+  ed247_context_t context,
+  uint32_t        queue_frame_count,
+  int32_t         cpu_affinity)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!context){
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  if(queue_frame_count == 0){
+    PRINT_ERROR(__func__ << ": Invalid queue_frame_count");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_context = static_cast<ed247::Context*>(context);
+    ed247_context->enable_async_sender(queue_frame_count, cpu_affinity);
+  }
+  LIBED247_CATCH("Enable asynchronous send");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_async_send_disable(
+  ed247_context_t context)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!context){
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_context = static_cast<ed247::Context*>(context);
+    ed247_context->disable_async_sender();
+  }
+  LIBED247_CATCH("Disable asynchronous send");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_async_send_get_backlog(
+  ed247_context_t context,
+  uint32_t *      backlog)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!context){
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!backlog){
+    PRINT_ERROR(__func__ << ": Invalid backlog pointer");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_context = static_cast<ed247::Context*>(context);
+    ed247::AsyncSender* async_sender = ed247_context->get_async_sender();
+    *backlog = async_sender ? async_sender->get_backlog() : 0;
+  }
+  LIBED247_CATCH("Get asynchronous send backlog");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_async_send_flush(
+  ed247_context_t context)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!context){
+    PRINT_ERROR(__func__ << ": Invalid context");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_context = static_cast<ed247::Context*>(context);
+    ed247::AsyncSender* async_sender = ed247_context->get_async_sender();
+    if (async_sender) async_sender->flush();
+  }
+  LIBED247_CATCH("Flush asynchronous send");
+  return ED247_STATUS_SUCCESS;
+}
+
 
 /* =========================================================================
  * ED247 Context - Callbacks
@@ -837,109 +1413,318 @@ ed247_status_t ed247_channel_get_stream_list(
 {
   PRINT_DEBUG("function " << __func__ << "()");
 
-  if(!streams) {
-    PRINT_ERROR(__func__ << ": Empty info pointer");
+  if(!streams) {
+    PRINT_ERROR(__func__ << ": Empty info pointer");
+    return ED247_STATUS_FAILURE;
+  }
+
+  *streams = nullptr;
+
+  if(!channel) {
+    PRINT_ERROR(__func__ << ": Invalid channel");
+    return ED247_STATUS_FAILURE;
+  }
+
+  try{
+    ed247::Channel* ed247_channel = static_cast<ed247::Channel*>(channel);
+    *streams = ed247_channel->get_client_streams();
+    ((ed247_stream_clist_base_t*)*streams)->reset_iterator();
+  }
+  LIBED247_CATCH("Get streams info");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_channel_find_streams(
+  ed247_channel_t       channel,
+  const char *          regex_name,
+  ed247_stream_list_t * streams)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!streams) {
+    PRINT_ERROR(__func__ << ": Invalid streams pointer");
+    return ED247_STATUS_FAILURE;
+  }
+
+  *streams = nullptr;
+
+  if(!channel) {
+    PRINT_ERROR(__func__ << ": Invalid channel");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::Channel* ed247_channel = (ed247::Channel*)(channel);
+    *streams =
+      ed247::client_list_container<ed247_internal_stream_list_t,
+                                   ed247::Stream,
+                                   ed247::stream_list_t>
+      ::copy(ed247_channel->find_streams(regex_name != nullptr ? std::string(regex_name) : std::string(".*")));
+  }
+  LIBED247_CATCH("Find channel streams");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_channel_find_streams_with_pattern(
+  ed247_channel_t       channel,
+  ed247_name_pattern_t  pattern,
+  ed247_stream_list_t * streams)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!streams) {
+    PRINT_ERROR(__func__ << ": Invalid streams pointer");
+    return ED247_STATUS_FAILURE;
+  }
+
+  *streams = nullptr;
+
+  if(!channel) {
+    PRINT_ERROR(__func__ << ": Invalid channel");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!pattern) {
+    PRINT_ERROR(__func__ << ": Invalid pattern");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::Channel* ed247_channel = (ed247::Channel*)(channel);
+    *streams =
+      ed247::client_list_container<ed247_internal_stream_list_t,
+                                   ed247::Stream,
+                                   ed247::stream_list_t>
+      ::copy(ed247_channel->find_streams(*static_cast<ed247::NamePattern*>(pattern)));
+  }
+  LIBED247_CATCH("Find channel streams");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_channel_get_stream(
+  ed247_channel_t  channel,
+  const char *     name,
+  ed247_stream_t * stream)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!channel) {
+    PRINT_ERROR(__func__ << ": Invalid channel");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!name) {
+    PRINT_ERROR(__func__ << ": Invalid name");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!stream){
+    PRINT_ERROR(__func__ << ": Invalid stream pointer");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_channel = (ed247::Channel*)(channel);
+    auto && ed247_stream = ed247_channel->get_stream(name);
+    *stream = ed247_stream ? ed247_stream.get() : nullptr;
+    if(*stream == nullptr) {
+      PRINT_INFO("Cannot find channel '" << name << "'");
+      return ED247_STATUS_FAILURE;
+    }
+  }
+  LIBED247_CATCH("Get channel stream");
+  return ED247_STATUS_SUCCESS;
+}
+
+
+ed247_status_t ed247_channel_set_user_data(
+  ed247_channel_t channel,
+  void *          user_data)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+
+  if(!channel) {
+    PRINT_ERROR(__func__ << ": nvalid channel");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_channel = static_cast<ed247::Channel*>(channel);
+    ed247_channel->set_user_data(user_data);
+  }
+  LIBED247_CATCH("Set channel user data");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_channel_get_user_data(
+  ed247_channel_t channel,
+  void **         user_data)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+
+  if(!channel) {
+    PRINT_ERROR(__func__ << ": Invalid channel");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!user_data) {
+    PRINT_ERROR(__func__ << ": Invalid user_data");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_channel = static_cast<ed247::Channel*>(channel);
+    ed247_channel->get_user_data(user_data);
+  }
+  LIBED247_CATCH("Get channel user data");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_channel_get_memory_footprint(
+  ed247_channel_t            channel,
+  ed247_memory_footprint_t * footprint)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+
+  if(!channel) {
+    PRINT_ERROR(__func__ << ": Invalid channel");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!footprint) {
+    PRINT_ERROR(__func__ << ": Invalid footprint");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_channel = static_cast<ed247::Channel*>(channel);
+    *footprint = ed247_memory_footprint_t{0, 0};
+    ed247_channel->add_memory_footprint(*footprint);
+  }
+  LIBED247_CATCH("Get channel memory footprint");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_channel_send_frame(
+  ed247_channel_t channel,
+  const void *    frame,
+  uint32_t        frame_size)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+
+  if(!channel) {
+    PRINT_ERROR(__func__ << ": Invalid channel");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!frame) {
+    PRINT_ERROR(__func__ << ": Invalid frame");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_channel = static_cast<ed247::Channel*>(channel);
+    if (ed247_channel->send_frame(frame, frame_size) == false) {
+      return ED247_STATUS_FAILURE;
+    }
+  }
+  LIBED247_CATCH("Send channel frame");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_channel_send_pushed_samples(
+  ed247_channel_t channel)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+
+  if(!channel) {
+    PRINT_ERROR(__func__ << ": Invalid channel");
     return ED247_STATUS_FAILURE;
   }
+  try{
+    auto ed247_channel = static_cast<ed247::Channel*>(channel);
+    ed247_channel->send_pushed_samples();
+  }
+  LIBED247_CATCH("Send channel pushed samples");
+  return ED247_STATUS_SUCCESS;
+}
 
-  *streams = nullptr;
+ed247_status_t ed247_channel_get_send_error_count(
+  ed247_channel_t channel,
+  uint64_t *      count)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
 
   if(!channel) {
     PRINT_ERROR(__func__ << ": Invalid channel");
     return ED247_STATUS_FAILURE;
   }
-
+  if(!count) {
+    PRINT_ERROR(__func__ << ": Invalid count");
+    return ED247_STATUS_FAILURE;
+  }
   try{
-    ed247::Channel* ed247_channel = static_cast<ed247::Channel*>(channel);
-    *streams = ed247_channel->get_client_streams();
-    ((ed247_stream_clist_base_t*)*streams)->reset_iterator();
+    auto ed247_channel = static_cast<ed247::Channel*>(channel);
+    *count = ed247_channel->get_send_error_count();
   }
-  LIBED247_CATCH("Get streams info");
+  LIBED247_CATCH("Get channel send error count");
   return ED247_STATUS_SUCCESS;
 }
 
-ed247_status_t ed247_channel_find_streams(
-  ed247_channel_t       channel,
-  const char *          regex_name,
-  ed247_stream_list_t * streams)
+ed247_status_t ed247_channel_set_component_filter(
+  ed247_channel_t     channel,
+  const ed247_uid_t * component_identifiers,
+  uint32_t            count)
 {
   PRINT_DEBUG("function " << __func__ << "()");
-  if(!streams) {
-    PRINT_ERROR(__func__ << ": Invalid streams pointer");
-    return ED247_STATUS_FAILURE;
-  }
-
-  *streams = nullptr;
 
   if(!channel) {
     PRINT_ERROR(__func__ << ": Invalid channel");
     return ED247_STATUS_FAILURE;
   }
+  if(!component_identifiers && count != 0) {
+    PRINT_ERROR(__func__ << ": Invalid component identifiers");
+    return ED247_STATUS_FAILURE;
+  }
   try{
-    ed247::Channel* ed247_channel = (ed247::Channel*)(channel);
-    *streams =
-      ed247::client_list_container<ed247_internal_stream_list_t,
-                                   ed247::Stream,
-                                   ed247::stream_list_t>
-      ::copy(ed247_channel->find_streams(regex_name != nullptr ? std::string(regex_name) : std::string(".*")));
+    auto ed247_channel = static_cast<ed247::Channel*>(channel);
+    ed247_channel->set_component_filter(std::vector<ed247_uid_t>(component_identifiers, component_identifiers + count));
   }
-  LIBED247_CATCH("Find channel streams");
+  LIBED247_CATCH("Set channel component filter");
   return ED247_STATUS_SUCCESS;
 }
 
-ed247_status_t ed247_channel_get_stream(
-  ed247_channel_t  channel,
-  const char *     name,
-  ed247_stream_t * stream)
+ed247_status_t ed247_channel_get_dropped_frame_count(
+  ed247_channel_t channel,
+  uint64_t *      count)
 {
   PRINT_DEBUG("function " << __func__ << "()");
+
   if(!channel) {
     PRINT_ERROR(__func__ << ": Invalid channel");
     return ED247_STATUS_FAILURE;
   }
-  if(!name) {
-    PRINT_ERROR(__func__ << ": Invalid name");
-    return ED247_STATUS_FAILURE;
-  }
-  if(!stream){
-    PRINT_ERROR(__func__ << ": Invalid stream pointer");
+  if(!count) {
+    PRINT_ERROR(__func__ << ": Invalid count");
     return ED247_STATUS_FAILURE;
   }
   try{
-    auto ed247_channel = (ed247::Channel*)(channel);
-    auto && ed247_stream = ed247_channel->get_stream(std::string(name));
-    *stream = ed247_stream ? ed247_stream.get() : nullptr;
-    if(*stream == nullptr) {
-      PRINT_INFO("Cannot find channel '" << name << "'");
-      return ED247_STATUS_FAILURE;
-    }
+    auto ed247_channel = static_cast<ed247::Channel*>(channel);
+    *count = ed247_channel->get_dropped_frame_count();
   }
-  LIBED247_CATCH("Get channel stream");
+  LIBED247_CATCH("Get channel dropped frame count");
   return ED247_STATUS_SUCCESS;
 }
 
-
-ed247_status_t ed247_channel_set_user_data(
+ed247_status_t ed247_channel_set_socket_buffer_sizes(
   ed247_channel_t channel,
-  void *          user_data)
+  uint32_t        receive_buffer_size,
+  uint32_t        send_buffer_size)
 {
   PRINT_DEBUG("function " << __func__ << "()");
 
   if(!channel) {
-    PRINT_ERROR(__func__ << ": nvalid channel");
+    PRINT_ERROR(__func__ << ": Invalid channel");
     return ED247_STATUS_FAILURE;
   }
   try{
     auto ed247_channel = static_cast<ed247::Channel*>(channel);
-    ed247_channel->set_user_data(user_data);
+    if (ed247_channel->set_socket_buffer_sizes(receive_buffer_size, send_buffer_size) == false) {
+      PRINT_ERROR(__func__ << ": Cannot set the socket buffer sizes of channel '" << ed247_channel->get_name() << "'");
+      return ED247_STATUS_FAILURE;
+    }
   }
-  LIBED247_CATCH("Set channel user data");
+  LIBED247_CATCH("Set channel socket buffer sizes");
   return ED247_STATUS_SUCCESS;
 }
 
-ed247_status_t ed247_channel_get_user_data(
+ed247_status_t ed247_channel_get_kernel_drop_count(
   ed247_channel_t channel,
-  void **         user_data)
+  uint64_t *      count)
 {
   PRINT_DEBUG("function " << __func__ << "()");
 
@@ -947,15 +1732,15 @@ ed247_status_t ed247_channel_get_user_data(
     PRINT_ERROR(__func__ << ": Invalid channel");
     return ED247_STATUS_FAILURE;
   }
-  if(!user_data) {
-    PRINT_ERROR(__func__ << ": Invalid user_data");
+  if(!count) {
+    PRINT_ERROR(__func__ << ": Invalid count");
     return ED247_STATUS_FAILURE;
   }
   try{
     auto ed247_channel = static_cast<ed247::Channel*>(channel);
-    ed247_channel->get_user_data(user_data);
+    *count = ed247_channel->get_kernel_drop_count();
   }
-  LIBED247_CATCH("Get channel user data");
+  LIBED247_CATCH("Get channel kernel drop count");
   return ED247_STATUS_SUCCESS;
 }
 
@@ -1184,6 +1969,39 @@ ed247_status_t ed247_stream_find_signals(
   return ED247_STATUS_SUCCESS;
 }
 
+ed247_status_t ed247_stream_find_signals_with_pattern(
+  ed247_stream_t        stream,
+  ed247_name_pattern_t  pattern,
+  ed247_signal_list_t * signals)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!signals) {
+    PRINT_ERROR(__func__ << ": Invalid signals pointer");
+    return ED247_STATUS_FAILURE;
+  }
+
+  *signals = nullptr;
+
+  if(!stream) {
+    PRINT_ERROR(__func__ << ": Invalid stream");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!pattern) {
+    PRINT_ERROR(__func__ << ": Invalid pattern");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::Stream* ed247_stream = (ed247::Stream*)(stream);
+    *signals =
+      ed247::client_list_container<ed247_internal_signal_list_t,
+                                   ed247::Signal,
+                                   ed247::signal_list_t>
+      ::copy(ed247_stream->find_signals(*static_cast<ed247::NamePattern*>(pattern)));
+  }
+  LIBED247_CATCH("Find stream signals");
+  return ED247_STATUS_SUCCESS;
+}
+
 ed247_status_t ed247_stream_get_signal(
   ed247_stream_t   stream,
   const char *     name,
@@ -1205,7 +2023,7 @@ ed247_status_t ed247_stream_get_signal(
   }
   try{
     auto ed247_stream = (ed247::Stream*)(stream);
-    auto && ed247_signal = ed247_stream->get_signal(std::string(name));
+    auto && ed247_signal = ed247_stream->get_signal(name);
     *signal = ed247_signal ? ed247_signal.get() : nullptr;
     if(*signal == nullptr) {
       PRINT_INFO("Cannot find signal '" << name << "'");
@@ -1279,6 +2097,48 @@ ed247_status_t ed247_stream_get_user_data(
   return ED247_STATUS_SUCCESS;
 }
 
+ed247_status_t ed247_stream_get_memory_footprint(
+  ed247_stream_t             stream,
+  ed247_memory_footprint_t * footprint)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+
+  if(!stream) {
+    PRINT_ERROR(__func__ << ": Invalid stream");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!footprint){
+    PRINT_ERROR(__func__ << ": Invalid footprint");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_stream = static_cast<ed247::Stream*>(stream);
+    *footprint = ed247_memory_footprint_t{0, 0};
+    ed247_stream->add_memory_footprint(*footprint);
+  }
+  LIBED247_CATCH("Get stream memory footprint");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_stream_set_conflation(
+  ed247_stream_t stream,
+  ed247_yesno_t  enable)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!stream) {
+    PRINT_ERROR(__func__ << ": Invalid stream");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    auto ed247_stream = static_cast<ed247::Stream*>(stream);
+    if (ed247_stream->set_conflation(enable == ED247_YESNO_YES) == false) {
+      return ED247_STATUS_FAILURE;
+    }
+  }
+  LIBED247_CATCH("Set stream conflation");
+  return ED247_STATUS_SUCCESS;
+}
+
 // Deprecated
 ed247_status_t ed247_stream_contains_signals(
   ed247_stream_t stream,
@@ -1957,6 +2817,188 @@ ed247_status_t ed247_stream_assistant_read_signal(
   return ED247_STATUS_SUCCESS;
 }
 
+ed247_status_t ed247_stream_assistant_write_signals(
+  ed247_stream_assistant_t assistant,
+  const ed247_signal_t *   signals,
+  uint32_t                 signal_count,
+  const void *             data,
+  uint32_t                 data_size)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!assistant){
+    PRINT_ERROR(__func__ << ": Invalid assistant");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!signals){
+    PRINT_ERROR(__func__ << ": Invalid signals");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!data){
+    PRINT_ERROR(__func__ << ": Empty data pointer");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::StreamAssistant* ed247_assistant = static_cast<ed247::StreamAssistant*>(assistant);
+    if (ed247_assistant->write_signals(signals, signal_count, data, data_size) == false) {
+      return ED247_STATUS_FAILURE;
+    }
+  }
+  LIBED247_CATCH("Write signals in assistant");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_stream_assistant_read_signals(
+  ed247_stream_assistant_t assistant,
+  const ed247_signal_t *   signals,
+  uint32_t                 signal_count,
+  void *                   data,
+  uint32_t                 data_size)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!assistant){
+    PRINT_ERROR(__func__ << ": Invalid assistant");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!signals){
+    PRINT_ERROR(__func__ << ": Invalid signals");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!data){
+    PRINT_ERROR(__func__ << ": Empty data pointer");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::StreamAssistant* ed247_assistant = static_cast<ed247::StreamAssistant*>(assistant);
+    if (ed247_assistant->read_signals(signals, signal_count, data, data_size) == false) {
+      return ED247_STATUS_FAILURE;
+    }
+  }
+  LIBED247_CATCH("Read signals from assistant");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_stream_assistant_create_signal_batch(
+  ed247_stream_assistant_t assistant,
+  const ed247_signal_t *   signals,
+  uint32_t                 signal_count,
+  ed247_signal_batch_t *   batch,
+  uint32_t *               batch_size)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!batch){
+    PRINT_ERROR(__func__ << ": Invalid batch pointer");
+    return ED247_STATUS_FAILURE;
+  }
+  *batch = nullptr;
+  if(!assistant){
+    PRINT_ERROR(__func__ << ": Invalid assistant");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!signals){
+    PRINT_ERROR(__func__ << ": Invalid signals");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::StreamAssistant* ed247_assistant = static_cast<ed247::StreamAssistant*>(assistant);
+    ed247::SignalBatch* ed247_batch = ed247_assistant->create_batch(signals, signal_count);
+    if (ed247_batch == nullptr) return ED247_STATUS_FAILURE;
+    if (batch_size) *batch_size = ed247_batch->get_size();
+    *batch = ed247_batch;
+  }
+  LIBED247_CATCH("Create signal batch");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_signal_batch_write(
+  ed247_signal_batch_t batch,
+  const void *         data,
+  uint32_t             data_size)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!batch){
+    PRINT_ERROR(__func__ << ": Invalid batch");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!data){
+    PRINT_ERROR(__func__ << ": Empty data pointer");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::SignalBatch* ed247_batch = static_cast<ed247::SignalBatch*>(batch);
+    if (ed247_batch->write(data, data_size) == false) {
+      return ED247_STATUS_FAILURE;
+    }
+  }
+  LIBED247_CATCH("Write signal batch");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_signal_batch_read(
+  ed247_signal_batch_t batch,
+  void *               data,
+  uint32_t             data_size)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!batch){
+    PRINT_ERROR(__func__ << ": Invalid batch");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!data){
+    PRINT_ERROR(__func__ << ": Empty data pointer");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::SignalBatch* ed247_batch = static_cast<ed247::SignalBatch*>(batch);
+    if (ed247_batch->read(data, data_size) == false) {
+      return ED247_STATUS_FAILURE;
+    }
+  }
+  LIBED247_CATCH("Read signal batch");
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_signal_batch_free(
+  ed247_signal_batch_t batch)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!batch){
+    PRINT_ERROR(__func__ << ": Invalid batch");
+    return ED247_STATUS_FAILURE;
+  }
+  delete static_cast<ed247::SignalBatch*>(batch);
+  return ED247_STATUS_SUCCESS;
+}
+
+ed247_status_t ed247_stream_assistant_bind_signal(
+  ed247_stream_assistant_t assistant,
+  ed247_signal_t           signal,
+  ed247_nad_type_t         nad_type,
+  ed247_signal_binding_t * binding)
+{
+  PRINT_DEBUG("function " << __func__ << "()");
+  if(!assistant){
+    PRINT_ERROR(__func__ << ": Invalid assistant");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!signal){
+    PRINT_ERROR(__func__ << ": Invalid signal");
+    return ED247_STATUS_FAILURE;
+  }
+  if(!binding){
+    PRINT_ERROR(__func__ << ": Invalid binding");
+    return ED247_STATUS_FAILURE;
+  }
+  try{
+    ed247::StreamAssistant* ed247_assistant = static_cast<ed247::StreamAssistant*>(assistant);
+    ed247::Signal* ed247_signal = static_cast<ed247::Signal*>(signal);
+    if (ed247_assistant->bind_signal(*ed247_signal, nad_type, *binding) == false) {
+      return ED247_STATUS_FAILURE;
+    }
+  }
+  LIBED247_CATCH("Bind signal of assistant");
+  return ED247_STATUS_SUCCESS;
+}
+
 ed247_status_t ed247_stream_assistant_push_sample(
   ed247_stream_assistant_t  assistant,
   const ed247_timestamp_t * timestamp,
@@ -108,6 +108,17 @@ typedef enum {
     ED247_STANDARD__COUNT
 } ed247_standard_t;
 
+/**
+ * @brief Transport of the frames (see ed247_set_transport())
+ * @ingroup global
+ */
+typedef enum {
+    ED247_TRANSPORT_UDP = 0,
+    ED247_TRANSPORT_LOOPBACK,
+    ED247_TRANSPORT_SHM,
+    ED247_TRANSPORT__COUNT
+} ed247_transport_t;
+
 /**
  * @brief Unique identifier type
  * @ingroup global
@@ -212,6 +223,15 @@ typedef struct {
 } ed247_timestamp_t;
 #define LIBED247_TIMESTAMP_DEFAULT ed247_timestamp_t{0, 0}
 
+/**
+ * @brief Memory used by the samples buffers of a context, a channel or a stream
+ * @ingroup global
+ */
+typedef struct {
+    uint64_t allocated_bytes;   // Currently allocated
+    uint64_t max_bytes;         // Allocated once all buffers are used
+} ed247_memory_footprint_t;
+
 /**
  * @brief Context identifier
  * @ingroup context
@@ -260,6 +280,18 @@ typedef struct ed247_internal_signal_list_t *ed247_signal_list_t;
  */
 typedef struct ed247_internal_stream_assistant_t *ed247_stream_assistant_t;
 
+/**
+ * @brief A precompiled list of signals of a stream assistant
+ * @ingroup stream_assistant
+ */
+typedef struct ed247_internal_signal_batch_t *ed247_signal_batch_t;
+
+/**
+ * @brief A precompiled name pattern for the find functions
+ * @ingroup global
+ */
+typedef struct ed247_internal_name_pattern_t *ed247_name_pattern_t;
+
 
 /* =========================================================================
  * Global Methods
@@ -309,6 +341,85 @@ extern LIBED247_EXPORT ed247_status_t ed247_set_log_level(
 extern LIBED247_EXPORT ed247_status_t ed247_get_log_level(
     ed247_log_level_t * log_level);
 
+/**
+ * @brief Setup the ECIC validation cache
+ * @details The XSD validation is a large part of the loading time. When the cache is enabled,
+ * the content hash of each successfully loaded ECIC is recorded in the cache file, and
+ * later loads of the same content (by this process or by another run) skip the XSD validation.<br />
+ * The environment variable ED247_ECIC_VALIDATION_CACHE has the priority: This function will be ignored if it is set.
+ * @ingroup global
+ * @param[in] cache_filepath Path of the cache file. NULL or empty string to disable the cache.
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_set_ecic_validation_cache(
+    const char * cache_filepath);
+
+/**
+ * @brief Setup the samples buffers allocation of the next loaded contexts
+ * @details By default, the buffers used by the stream direction are allocated at load time.
+ * When lazy allocation is enabled, a stream buffer is allocated on first push or on first receive.
+ * This reduces the memory used by streams never exchanged, at the cost of an allocation at runtime.
+ * @ingroup global
+ * @param[in] enable ED247_YESNO_YES to enable the lazy allocation
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_set_lazy_allocation(
+    ed247_yesno_t enable);
+
+/**
+ * @brief Select the transport of the next loaded contexts
+ * @details By default, the frames are exchanged through UDP sockets (ED247_TRANSPORT_UDP).<br/>
+ * With ED247_TRANSPORT_LOOPBACK, no socket is created: the frames sent to the address of an UdpSocket are
+ * copied into the receive queues of the contexts of the same process that have an input UdpSocket on this
+ * address (or on the same port of INADDR_ANY), and delivered by their ed247_wait_frame() or ed247_wait_during().
+ * Frames sent to addresses without receiver are dropped, as in UDP. This removes the kernel costs and the port
+ * conflicts when several components are simulated in a single process.<br/>
+ * With ED247_TRANSPORT_SHM (Linux only), the frames are exchanged between the processes of the host through a
+ * ring per UdpSocket address in /dev/shm (ed247_IP_PORT). All the components of the rig shall use this transport
+ * and the input UdpSockets shall use the destination address of the emitters (INADDR_ANY is not matched). A receiver
+ * late by more than the ring capacity (1 MiB) loses the overwritten frames. The files are kept in /dev/shm and may be
+ * removed when no component is running.<br/>
+ * A context keeps the transport it has been loaded with. The readiness fd (ed247_get_readiness_fd()) and the
+ * busy poll mode are only available with the UDP transport.<br/>
+ * The environment variable ED247_TRANSPORT ("udp", "loopback" or "shm") has the priority: This function will be ignored if it is set.
+ * @ingroup global
+ * @param[in] transport Transport of the next loaded contexts
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE Invalid transport
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_set_transport(
+    ed247_transport_t transport);
+
+/**
+ * @brief Compile a name pattern to be used by the find functions (ed247_find_streams_with_pattern()...)
+ * @details `regex_name` shall follow the <b>ECMAScript</b> grammar. <br/>
+ * Compiling a pattern once and reusing it is faster than calling the regex_name based find functions. <br/>
+ * Patterns made only of literals, '.' and '.*' (i.e. "Stream1", "Stream.*", "Stream.*_IN") are matched
+ * without regular expression engine. Prefix patterns (i.e. "Stream.*") are answered by a range scan
+ * of the sorted component names.<br/>
+ * <b>This function allocates `pattern`. It has to be freed with ed247_name_pattern_free().</b>
+ * @ingroup global
+ * @param[in] regex_name The regular expression for name matching. If null, assume '.*'.
+ * @param[out] pattern The compiled pattern
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE The regular expression is invalid
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_name_pattern_compile(
+    const char *           regex_name,
+    ed247_name_pattern_t * pattern);
+
+/**
+ * @brief Free a pattern compiled by ed247_name_pattern_compile()
+ * @ingroup global
+ * @param[in] pattern The compiled pattern
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_name_pattern_free(
+    ed247_name_pattern_t pattern);
+
 
 /* =========================================================================
  * ED247 Context
@@ -338,6 +449,20 @@ extern LIBED247_EXPORT ed247_status_t ed247_load_file(
     const char *      ecic_file_path,
     ed247_context_t * context);
 
+/**
+ * @brief Loading function for large ECIC
+ * @details Same as ed247_load_file() but the ECIC is read and validated as a stream instead of
+ * being fully loaded in memory: the load-time memory does not depend on the ECIC size.
+ * @ingroup context_init
+ * @param[in] ecic_file_path The path to the ECIC configuration file
+ * @param[out] context The loaded context identifier
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE An error occurred during the load phase (xml parsing or internal loading)
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_load_file_streaming(
+    const char *      ecic_file_path,
+    ed247_context_t * context);
+
 /**
  * @brief Loading function: the entry point of the library
  * @ingroup context_init
@@ -350,6 +475,82 @@ extern LIBED247_EXPORT ed247_status_t ed247_load_content(
     const char *      ecic_file_content,
     ed247_context_t * context);
 
+/**
+ * @brief Stream filter for selective loading (see ed247_load_file_filtered())
+ * @ingroup context_init
+ * @param[in] channel_name Name of the channel of the stream
+ * @param[in] stream_name Name of the stream
+ * @param[in] user_data The user_data given to the loading function
+ * @return true if the stream shall be loaded
+ */
+typedef bool (*ed247_stream_filter_t)(const char* channel_name, const char* stream_name, void* user_data);
+
+/**
+ * @brief Loading function: only load the streams accepted by a filter
+ * @details Only accepted streams are instantiated. Channels without any accepted stream are not created
+ * and the UDP sockets that are not used by accepted streams are not opened.
+ * Filtered out streams and channels are unknown to the context (ed247_get_stream() will fail on them).
+ * @ingroup context_init
+ * @param[in] ecic_file_path The path to the ECIC configuration file
+ * @param[in] filter The stream filter, called once per stream of the ECIC
+ * @param[in] user_data Passed to each filter call
+ * @param[out] context The loaded context identifier
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE An error occurred during the load phase (xml parsing or internal loading)
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_load_file_filtered(
+    const char *          ecic_file_path,
+    ed247_stream_filter_t filter,
+    void *                user_data,
+    ed247_context_t *     context);
+
+/**
+ * @brief Loading function: only load the streams accepted by a filter
+ * @details See ed247_load_file_filtered()
+ * @ingroup context_init
+ * @param[in] ecic_file_content The content of the ECIC configuration file
+ * @param[in] filter The stream filter, called once per stream of the ECIC
+ * @param[in] user_data Passed to each filter call
+ * @param[out] context The loaded context identifier
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE An error occurred during the load phase (xml parsing or internal loading)
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_load_content_filtered(
+    const char *          ecic_file_content,
+    ed247_stream_filter_t filter,
+    void *                user_data,
+    ed247_context_t *     context);
+
+/**
+ * @brief Loading function from a precompiled ECIC
+ * @details A precompiled ECIC is a binary image of an already loaded ECIC (see ed247_compile_file()).
+ * The context is created without any XML parsing nor XSD validation.
+ * The file integrity is checked before use.
+ * @ingroup context_init
+ * @param[in] compiled_file_path The path to the precompiled ECIC
+ * @param[out] context The loaded context identifier
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE An error occurred during the load phase (invalid or corrupted file, other library version, internal loading)
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_load_compiled(
+    const char *      compiled_file_path,
+    ed247_context_t * context);
+
+/**
+ * @brief Precompile an ECIC for ed247_load_compiled()
+ * @details The ECIC is fully loaded and validated, then its binary image is written to compiled_file_path.
+ * The precompiled file can only be used by the same library version on the same platform:
+ * ed247_load_compiled() rejects a file generated by another library version.
+ * @ingroup context_init
+ * @param[in] ecic_file_path The path to the ECIC configuration file
+ * @param[in] compiled_file_path The path of the precompiled ECIC to write
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE Invalid ECIC or cannot write the precompiled file
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_compile_file(
+    const char * ecic_file_path,
+    const char * compiled_file_path);
+
 /**
  * @brief Unload resources linked to the given context
  * @ingroup context_init
@@ -385,6 +586,52 @@ extern LIBED247_EXPORT ed247_status_t ed247_component_get_user_data(
     ed247_context_t context,
     void **user_data);
 
+/**
+ * @brief Retrieve the memory used by the context buffers
+ * @details Include the receive frame buffer and all the channels buffers.
+ * @ingroup context_init
+ * @param[in] context The context identifier
+ * @param[out] footprint Memory footprint of the context
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_component_get_memory_footprint(
+    ed247_context_t            context,
+    ed247_memory_footprint_t * footprint);
+
+/**
+ * @brief Enable or disable the conflation of all input signal based streams of the context
+ * @details See ed247_stream_set_conflation().
+ * @ingroup context_init
+ * @param[in] context The context identifier
+ * @param[in] enable ED247_YESNO_YES to only keep the latest received sample of each stream
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_component_set_conflation(
+    ed247_context_t context,
+    ed247_yesno_t   enable);
+
+/**
+ * @brief Enable or disable the busy poll receive mode of the context
+ * @details In busy poll mode, ed247_wait_frame() and ed247_wait_during() poll all the input sockets
+ * without blocking (recvmmsg() on Linux) during `spin_budget_us` before falling back to a blocking wait.
+ * This removes the wake-up latency of the blocking wait at the cost of a full CPU usage: it is meant
+ * for dedicated isolated cores.<br/>
+ * If `socket_busy_poll_us` is not 0, the SO_BUSY_POLL option of the input sockets is set to this value
+ * (Linux only, may require CAP_NET_ADMIN). A failure to set it is only reported as a warning.
+ * @ingroup context_init
+ * @param[in] context The context identifier
+ * @param[in] spin_budget_us Maximum polling duration of each wait, in microseconds. 0 disables the busy poll mode.
+ * @param[in] socket_busy_poll_us Value of the SO_BUSY_POLL socket option, in microseconds. 0 to keep the system default.
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_component_set_busy_poll(
+    ed247_context_t context,
+    uint32_t        spin_budget_us,
+    uint32_t        socket_busy_poll_us);
+
 /* =========================================================================
  * ED247 Context - Global information
  * ========================================================================= */
@@ -444,6 +691,22 @@ extern LIBED247_EXPORT ed247_status_t ed247_find_channels(
     const char *           regex_name,
     ed247_channel_list_t * channels);
 
+/**
+ * @brief Same as ed247_find_channels() with a pattern compiled by ed247_name_pattern_compile().
+ * @details The channels are sorted by name.<br/>
+ * <b>This function allocates `channels`. It has to be freed with ed247_channel_list_free().</b>
+ * @ingroup context_config
+ * @param[in] context The context identifier.
+ * @param[in] pattern The compiled pattern.
+ * @param[out] channels The list of the channels. If no value, set to null.
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_find_channels_with_pattern(
+    ed247_context_t        context,
+    ed247_name_pattern_t   pattern,
+    ed247_channel_list_t * channels);
+
 /**
  * @brief Get a channel of the component
  * @ingroup context_config
@@ -490,6 +753,22 @@ extern LIBED247_EXPORT ed247_status_t ed247_find_streams(
     const char *          regex_name,
     ed247_stream_list_t * streams);
 
+/**
+ * @brief Same as ed247_find_streams() with a pattern compiled by ed247_name_pattern_compile().
+ * @details The streams are sorted by name.<br/>
+ * <b>This function allocates `streams`. It has to be freed with ed247_stream_list_free().</b>
+ * @ingroup context_config
+ * @param[in] context The context identifier
+ * @param[in] pattern The compiled pattern.
+ * @param[out] streams The list of the streams. If no value, set to null.
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_find_streams_with_pattern(
+    ed247_context_t       context,
+    ed247_name_pattern_t  pattern,
+    ed247_stream_list_t * streams);
+
 
 /**
  * @brief Get a stream of the component
@@ -523,6 +802,22 @@ extern LIBED247_EXPORT ed247_status_t ed247_find_signals(
     const char *          regex_name,
     ed247_signal_list_t * signals);
 
+/**
+ * @brief Same as ed247_find_signals() with a pattern compiled by ed247_name_pattern_compile().
+ * @details The signals are sorted by name.<br/>
+ * <b>This function allocates `signals`. It has to be freed with ed247_signal_list_free().</b>
+ * @ingroup context_config
+ * @param[in] context The context identifier
+ * @param[in] pattern The compiled pattern.
+ * @param[out] signals The list of the signals. If no value, set to null.
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_find_signals_with_pattern(
+    ed247_context_t       context,
+    ed247_name_pattern_t  pattern,
+    ed247_signal_list_t * signals);
+
 /**
  * @brief Get a signal of the component
  * @ingroup context_config
@@ -565,6 +860,115 @@ extern LIBED247_EXPORT ed247_status_t ed247_wait_frame(
     ed247_stream_list_t * streams,
     int32_t               timeout_us);
 
+/**
+ * @brief Process the frames already received, without blocking.
+ * @details This is the non-blocking counterpart of ed247_wait_frame(), meant to be called by an
+ * external event loop when the fd returned by ed247_get_readiness_fd() is readable. <br/>
+ * `streams`, if not NULL, will be set to the list of streams with incomming data available.
+ * its lifespan is the same as the `context`, but you can safely call ed247_stream_list_free().
+ * @ingroup context_io
+ * @param[in] context Context identifier
+ * @param[out] streams List of streams that received samples, can be NULL
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ * @retval ED247_STATUS_NODATA No frame was available
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_process_pending_frames(
+    ed247_context_t       context,
+    ed247_stream_list_t * streams);
+
+/**
+ * @brief Get a file descriptor that is readable when a frame is available on any input socket of the context
+ * @details The file descriptor (an epoll fd aggregating all the input sockets) can be registered in
+ * an external event loop (epoll, poll, select, asio...). When it is readable, call
+ * ed247_process_pending_frames(). The file descriptor is owned by the context: do not close it.<br/>
+ * Linux only. The io_uring engine, if any, is disabled by this call.
+ * @ingroup context_io
+ * @param[in] context Context identifier
+ * @param[out] fd The readiness file descriptor
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE Not supported on this platform
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_get_readiness_fd(
+    ed247_context_t context,
+    int *           fd);
+
+/**
+ * @brief Received frame callback function pointer.
+ * @details `frame` is the raw datagram, including the frame header. It is only valid during the call.
+ * @ingroup context_io
+ */
+typedef void (*ed247_frame_recv_callback_t)(
+    ed247_context_t context,
+    ed247_channel_t channel,
+    const void *    frame,
+    uint32_t        frame_size,
+    void *          user_data);
+
+/**
+ * @brief Set the function called for each received frame, before it is decoded.
+ * @details Meant to capture the raw traffic (see the dumper utility). The callback is called from
+ * ed247_wait_frame(), ed247_wait_during() and ed247_process_pending_frames().
+ * @ingroup context_io
+ * @param[in] context Context identifier
+ * @param[in] callback The callback function, NULL to remove it
+ * @param[in] user_data Forwarded to the callback
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_set_frame_recv_callback(
+    ed247_context_t             context,
+    ed247_frame_recv_callback_t callback,
+    void *                      user_data);
+
+/**
+ * @brief Transport information of a received datagram
+ * @details Addresses and ports are in host byte order.
+ * @ingroup context_io
+ */
+typedef struct {
+  ed247_timestamp_t timestamp;          /**< Kernel receive timestamp (see ed247_set_datagram_recv_callback()) */
+  uint32_t          source_ip;          /**< Address of the sender */
+  uint16_t          source_port;        /**< Port of the sender */
+  uint32_t          destination_ip;     /**< Address of the input UdpSocket (unicast or multicast group) */
+  uint16_t          destination_port;   /**< Port of the input UdpSocket */
+} ed247_datagram_info_t;
+
+/**
+ * @brief Received datagram callback function pointer.
+ * @details `frame` is the UDP payload, including the frame header. `frame` and `info` are only valid during the call.
+ * `channel` is the channel that decodes the datagram. If several channels share the UdpSocket address, it is the
+ * first one that accepts it, NULL if none of them does.
+ * @ingroup context_io
+ */
+typedef void (*ed247_datagram_recv_callback_t)(
+    ed247_context_t               context,
+    ed247_channel_t               channel,
+    const ed247_datagram_info_t * info,
+    const void *                  frame,
+    uint32_t                      frame_size,
+    void *                        user_data);
+
+/**
+ * @brief Set the function called for each received datagram, before it is decoded.
+ * @details Same as ed247_set_frame_recv_callback() with the transport information of the datagram, but called
+ * exactly once per received datagram, including the ones that no channel decodes (see ed247_datagram_recv_callback_t).
+ * Meant to record the traffic (see the recorder utility).<br/>
+ * While a callback is set, the kernel receive timestamps of the input sockets are enabled (Linux). On other platforms,
+ * or if the kernel does not provide it, the timestamp is ed247_get_receive_timestamp(). The io_uring engine, if any,
+ * is disabled by this call.
+ * @ingroup context_io
+ * @param[in] context Context identifier
+ * @param[in] callback The callback function, NULL to remove it
+ * @param[in] user_data Forwarded to the callback
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_set_datagram_recv_callback(
+    ed247_context_t                context,
+    ed247_datagram_recv_callback_t callback,
+    void *                         user_data);
+
 /**
  * @brief Blocks until duration is elapsed. Processing all received frames.
  * @details `streams`, if not NULL, will be set to the list of streams with incomming data available.
@@ -597,6 +1001,121 @@ extern LIBED247_EXPORT ed247_status_t ed247_wait_during(
 extern LIBED247_EXPORT ed247_status_t ed247_send_pushed_samples(
     ed247_context_t context);
 
+/**
+ * @brief Statistics of a group of streams of the cyclic scheduler
+ * @details The jitter is the delay between a deadline and the effective push of the group.
+ * @ingroup context_io
+ */
+typedef struct {
+    uint32_t period_us;         // Sampling period of the group streams
+    uint32_t stream_count;      // Number of streams in the group
+    uint64_t cycle_count;       // Number of served deadlines
+    uint64_t missed_count;      // Number of skipped deadlines (late by more than a period)
+    uint32_t jitter_min_us;
+    uint32_t jitter_max_us;
+    uint32_t jitter_mean_us;
+} ed247_scheduler_stats_t;
+
+/**
+ * @brief Run the cyclic scheduler of the output signal based streams during a given duration.
+ * @details The output streams with signals are grouped by their sampling period (SamplingPeriodUs).
+ * On each deadline of a group, the stream assistants of the group whose signals have been written
+ * are pushed and the channels of the group are sent. This replaces the application loop around
+ * ed247_stream_assistants_written_push_samples() and ed247_send_pushed_samples().<br/>
+ * Deadlines are absolute, so the wake-up delays do not accumulate, and the first deadlines of the
+ * groups are spread over the shortest period so the sends do not burst. The deadlines continue
+ * from one call to the next one.<br/>
+ * Between deadlines, the received frames are processed the same way as ed247_wait_during().
+ * @ingroup context_io
+ * @param[in] context Context identifier
+ * @param[in] duration_us Duration value, in microseconds
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_scheduler_run(
+    ed247_context_t context,
+    int32_t         duration_us);
+
+/**
+ * @brief Retrieve the statistics of the cyclic scheduler groups
+ * @details Groups are sorted by period.
+ * @ingroup context_io
+ * @param[in] context Context identifier
+ * @param[out] stats Array of `*count` entries, filled with the statistics of the first groups. May be NULL if `*count` is 0.
+ * @param[in,out] count Size of the stats array. Set to the number of groups.
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_scheduler_get_stats(
+    ed247_context_t           context,
+    ed247_scheduler_stats_t * stats,
+    uint32_t *                count);
+
+/**
+ * @brief Reset the cyclic scheduler
+ * @details The statistics are cleared and the deadlines restart on next ed247_scheduler_run().
+ * @ingroup context_io
+ * @param[in] context Context identifier
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_scheduler_reset(
+    ed247_context_t context);
+
+/**
+ * @brief Enable the asynchronous send mode
+ * @details Once enabled, the frames encoded by ed247_send_pushed_samples() (or by the channels
+ * served by ed247_scheduler_run()) are copied in a lock-free queue and the sendto() system calls
+ * are performed by a background sender thread. The calling thread only encodes the frames.<br/>
+ * If the queue is full, the caller waits for the sender thread to free a slot.<br/>
+ * Calling this function again replaces the sender thread once the queued frames have been sent.
+ * @ingroup context_io
+ * @param[in] context Context identifier
+ * @param[in] queue_frame_count Number of frames the queue can hold (shall not be 0)
+ * @param[in] cpu_affinity CPU the sender thread is pinned on, or -1 to let the system choose (Linux only)
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_async_send_enable(
+    ed247_context_t context,
+    uint32_t        queue_frame_count,
+    int32_t         cpu_affinity);
+
+/**
+ * @brief Disable the asynchronous send mode
+ * @details The queued frames are sent before the sender thread is stopped.
+ * Following frames are sent by the calling thread.
+ * @ingroup context_io
+ * @param[in] context Context identifier
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_async_send_disable(
+    ed247_context_t context);
+
+/**
+ * @brief Get the number of frames queued and not yet sent by the sender thread
+ * @ingroup context_io
+ * @param[in] context Context identifier
+ * @param[out] backlog Number of queued frames (0 if the asynchronous send mode is disabled)
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_async_send_get_backlog(
+    ed247_context_t context,
+    uint32_t *      backlog);
+
+/**
+ * @brief Wait until all the queued frames have been sent by the sender thread
+ * @details Does nothing if the asynchronous send mode is disabled.
+ * @ingroup context_io
+ * @param[in] context Context identifier
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_async_send_flush(
+    ed247_context_t context);
+
 
 /* =========================================================================
  * ED247 Context - Callbacks
@@ -809,6 +1328,21 @@ extern LIBED247_EXPORT ed247_status_t ed247_channel_find_streams(
     const char *          regex_name,
     ed247_stream_list_t * streams);
 
+/**
+ * @brief Same as ed247_channel_find_streams() with a pattern compiled by ed247_name_pattern_compile().
+ * @details <b>This function allocates `streams`. It has to be freed with ed247_stream_list_free().</b>
+ * @ingroup channel
+ * @param[in] channel The channel identifier
+ * @param[in] pattern The compiled pattern.
+ * @param[out] streams The list of the streams. If no value, set to null.
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_channel_find_streams_with_pattern(
+    ed247_channel_t       channel,
+    ed247_name_pattern_t  pattern,
+    ed247_stream_list_t * streams);
+
 /**
  * @brief get a channel stream.
  * @ingroup channel
@@ -848,6 +1382,135 @@ extern LIBED247_EXPORT ed247_status_t ed247_channel_get_user_data(
     ed247_channel_t channel,
     void **         user_data);
 
+/**
+ * @brief Retrieve the memory used by the channel buffers
+ * @details Include the frame buffer and the buffers of all the channel streams.
+ * @ingroup channel
+ * @param[in] channel The channel identifier
+ * @param[out] footprint Memory footprint of the channel
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_channel_get_memory_footprint(
+    ed247_channel_t            channel,
+    ed247_memory_footprint_t * footprint);
+
+/**
+ * @brief Send a raw frame to all the output UdpSockets of the channel
+ * @details The frame is sent as is: it shall include the frame header. Meant to replay a recorded traffic
+ * (see the replayer utility).<br/>
+ * Like the frames of ed247_send_pushed_samples(), the frame is queued if the asynchronous sender is enabled:
+ * the queue slots are sized for the largest frame of the context channels, so a larger frame is rejected.
+ * If the io_uring engine is used, the frame is queued until the next ed247_send_pushed_samples() or
+ * ed247_channel_send_pushed_samples().
+ * @ingroup channel
+ * @param[in] channel The channel identifier
+ * @param[in] frame The frame to send
+ * @param[in] frame_size Size of the frame
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE The frame is too large
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_channel_send_frame(
+    ed247_channel_t channel,
+    const void *    frame,
+    uint32_t        frame_size);
+
+/**
+ * @brief Send the samples pushed in the streams of the channel
+ * @details Same as ed247_send_pushed_samples() for a single channel: if the io_uring engine is used,
+ * the frames queued by the context (including the ones of ed247_channel_send_frame()) are submitted.<br/>
+ * Different channels of a context can be pushed and sent from different threads, as long as the
+ * asynchronous sender and the io_uring engine are not used (they have a single producer queue).
+ * @ingroup channel
+ * @param[in] channel The channel identifier
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_channel_send_pushed_samples(
+    ed247_channel_t channel);
+
+/**
+ * @brief Get the number of frames of the channel that failed to be sent
+ * @details A frame sent to several output UdpSockets counts once per failed socket.
+ * The failures of the io_uring engine are not counted.
+ * @ingroup channel
+ * @param[in] channel The channel identifier
+ * @param[out] count Number of send failures since the context was loaded
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_channel_get_send_error_count(
+    ed247_channel_t channel,
+    uint64_t *      count);
+
+/**
+ * @brief Only decode the received frames of the given components
+ * @details The component identifier of the frame header (see ed247_sample_details_t) is checked right after the
+ * header is decoded: the frames of the other components are dropped before their streams are decoded, and counted
+ * (see ed247_channel_get_dropped_frame_count()). The channel shall have a frame header.<br/>
+ * An empty list (count 0) accepts all the components (default).
+ * @ingroup channel
+ * @param[in] channel The channel identifier
+ * @param[in] component_identifiers Accepted component identifiers. May be NULL if count is 0.
+ * @param[in] count Number of component identifiers
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE The channel has no frame header
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_channel_set_component_filter(
+    ed247_channel_t     channel,
+    const ed247_uid_t * component_identifiers,
+    uint32_t            count);
+
+/**
+ * @brief Get the number of received frames dropped by the channel
+ * @details A frame is dropped when its component is not accepted (see ed247_channel_set_component_filter()) or,
+ * for a MultiChannel, when it contains none of the streams of the channel.
+ * @ingroup channel
+ * @param[in] channel The channel identifier
+ * @param[out] count Number of dropped frames since the context was loaded
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_channel_get_dropped_frame_count(
+    ed247_channel_t channel,
+    uint64_t *      count);
+
+/**
+ * @brief Set the kernel buffer sizes (SO_RCVBUF/SO_SNDBUF) of the UdpSockets of the channel
+ * @details A size of 0 keeps the current size of the sockets. On Linux, the SO_RCVBUFFORCE/SO_SNDBUFFORCE variants
+ * are tried first so that a process with CAP_NET_ADMIN may exceed net.core.rmem_max/wmem_max; otherwise the sizes
+ * are capped by the system and a warning is printed.<br/>
+ * A socket shared by several channels is resized for all of them.
+ * @ingroup channel
+ * @param[in] channel The channel identifier
+ * @param[in] receive_buffer_size Receive buffer size in bytes of the input sockets (0: unchanged)
+ * @param[in] send_buffer_size Send buffer size in bytes of the output sockets (0: unchanged)
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE A size cannot be set
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_channel_set_socket_buffer_sizes(
+    ed247_channel_t channel,
+    uint32_t        receive_buffer_size,
+    uint32_t        send_buffer_size);
+
+/**
+ * @brief Get the number of frames dropped by the kernel on the input UdpSockets of the channel
+ * @details The kernel drops the frames that do not fit in the receive buffer of a socket (see
+ * ed247_channel_set_socket_buffer_sizes()). The count is reported by the kernel (Linux SO_RXQ_OVFL) along with the
+ * received frames, so it is only updated when a frame is received. It is always 0 on other systems and with the
+ * io_uring engine.<br/>
+ * The drops are counted per socket: when several channels receive on the same UdpSocket address, each of them
+ * reports all the drops of the shared socket, so their counts shall not be summed.
+ * @ingroup channel
+ * @param[in] channel The channel identifier
+ * @param[out] count Number of frames dropped by the kernel since the sockets were created
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_channel_get_kernel_drop_count(
+    ed247_channel_t channel,
+    uint64_t *      count);
+
 
 /* =========================================================================
  * Channel - List
@@ -973,6 +1636,21 @@ extern LIBED247_EXPORT ed247_status_t ed247_stream_find_signals(
     const char *          regex_name,
     ed247_signal_list_t * signals);
 
+/**
+ * @brief Same as ed247_stream_find_signals() with a pattern compiled by ed247_name_pattern_compile().
+ * @details <b>This function allocates `signals`. It has to be freed with ed247_signal_list_free().</b>
+ * @ingroup stream
+ * @param[in] stream The stream identifier
+ * @param[in] pattern The compiled pattern.
+ * @param[out] signals The list of the signals. If no value, set to null.
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_stream_find_signals_with_pattern(
+    ed247_stream_t        stream,
+    ed247_name_pattern_t  pattern,
+    ed247_signal_list_t * signals);
+
 /**
  * @brief Get a signal of the stream.
  * @ingroup stream
@@ -1024,6 +1702,35 @@ extern LIBED247_EXPORT ed247_status_t ed247_stream_get_user_data(
     ed247_stream_t stream,
     void **        user_data);
 
+/**
+ * @brief Retrieve the memory used by the stream buffers
+ * @details Include the samples stacks and the stream assistant buffers.
+ * @ingroup stream
+ * @param[in] stream The stream identifier
+ * @param[out] footprint Memory footprint of the stream
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_stream_get_memory_footprint(
+    ed247_stream_t             stream,
+    ed247_memory_footprint_t * footprint);
+
+/**
+ * @brief Enable or disable the conflation of a signal based stream
+ * @details When conflation is enabled, a received sample replaces the previous one instead of
+ * being queued: at most one sample can be popped and only the latest state of the signals is
+ * kept. The older samples of a received frame are not even copied.<br/>
+ * Enabling the conflation drops the samples already received but the newest one.
+ * @ingroup stream
+ * @param[in] stream The stream identifier. Shall be a signal based stream to enable conflation.
+ * @param[in] enable ED247_YESNO_YES to only keep the latest received sample
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_stream_set_conflation(
+    ed247_stream_t stream,
+    ed247_yesno_t  enable);
+
 
 /* =========================================================================
  * Stream - Read & Write
@@ -1444,6 +2151,145 @@ extern LIBED247_EXPORT ed247_status_t ed247_stream_assistant_read_signal(
     const void **            signal_sample_data,
     uint32_t *               signal_sample_size);
 
+/**
+ * @brief Write several signals into the assistant sample buffer in a single call.
+ * @details
+ * Equivalent to call ed247_stream_assistant_write_signal() for each signal.
+ * The signal values are read from `data` in the order of `signals`, packed without padding:
+ * each value has the size of ed247_signal_get_sample_max_size_bytes(). <br/>
+ * Only available for fixed size streams (DISCRETE, ANALOGUE and NAD).
+ * @ingroup stream_assistant
+ * @param[in] assistant Assistant identifier
+ * @param[in] signals Array of signal identifiers
+ * @param[in] signal_count Number of signals
+ * @param[in] data Packed signal values
+ * @param[in] data_size Size of data
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_stream_assistant_write_signals(
+    ed247_stream_assistant_t assistant,
+    const ed247_signal_t *   signals,
+    uint32_t                 signal_count,
+    const void *             data,
+    uint32_t                 data_size);
+
+/**
+ * @brief Read several signals from the assistant sample buffer in a single call.
+ * @details
+ * Equivalent to call ed247_stream_assistant_read_signal() for each signal.
+ * The signal values are copied into `data` in the order of `signals`, packed without padding:
+ * each value has the size of ed247_signal_get_sample_max_size_bytes(). <br/>
+ * Only available for fixed size streams (DISCRETE, ANALOGUE and NAD).
+ * @ingroup stream_assistant
+ * @param[in] assistant Assistant identifier
+ * @param[in] signals Array of signal identifiers
+ * @param[in] signal_count Number of signals
+ * @param[out] data Packed signal values
+ * @param[in] data_size Size of data
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_stream_assistant_read_signals(
+    ed247_stream_assistant_t assistant,
+    const ed247_signal_t *   signals,
+    uint32_t                 signal_count,
+    void *                   data,
+    uint32_t                 data_size);
+
+/**
+ * @brief Precompile a list of signals for ed247_signal_batch_read() and ed247_signal_batch_write().
+ * @details
+ * The signal values are packed the same way as ed247_stream_assistant_read_signals(). The batch
+ * resolves the signal offsets once and merges the signals contiguous in the stream sample, so each
+ * read or write is done with a few memory copies. <br/>
+ * Only available for fixed size streams (DISCRETE, ANALOGUE and NAD).<br/>
+ * <b>This function allocates `batch`. It has to be freed with ed247_signal_batch_free().</b>
+ * @ingroup stream_assistant
+ * @param[in] assistant Assistant identifier
+ * @param[in] signals Array of signal identifiers. All of them shall belong to the assistant stream.
+ * @param[in] signal_count Number of signals
+ * @param[out] batch The batch identifier
+ * @param[out] batch_size If not NULL, set to the size of the packed values
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_stream_assistant_create_signal_batch(
+    ed247_stream_assistant_t assistant,
+    const ed247_signal_t *   signals,
+    uint32_t                 signal_count,
+    ed247_signal_batch_t *   batch,
+    uint32_t *               batch_size);
+
+/**
+ * @brief Write the signals of a batch into the assistant sample buffer.
+ * @ingroup stream_assistant
+ * @param[in] batch The batch identifier
+ * @param[in] data Packed signal values
+ * @param[in] data_size Size of data
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_signal_batch_write(
+    ed247_signal_batch_t batch,
+    const void *         data,
+    uint32_t             data_size);
+
+/**
+ * @brief Read the signals of a batch from the assistant sample buffer.
+ * @ingroup stream_assistant
+ * @param[in] batch The batch identifier
+ * @param[out] data Packed signal values
+ * @param[in] data_size Size of data
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_signal_batch_read(
+    ed247_signal_batch_t batch,
+    void *               data,
+    uint32_t             data_size);
+
+/**
+ * @brief Free a batch created by ed247_stream_assistant_create_signal_batch()
+ * @ingroup stream_assistant
+ * @param[in] batch The batch identifier
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_signal_batch_free(
+    ed247_signal_batch_t batch);
+
+/**
+ * @brief Location of a signal in the assistant sample buffer (see ed247_stream_assistant_bind_signal())
+ * @ingroup stream_assistant
+ */
+typedef struct {
+    void *   data;          // First byte of the signal. Network byte order for output streams, host byte order once popped.
+    bool *   was_written;   // Set it to true once data is written (see ed247_stream_assistant_was_written())
+    uint32_t size;          // Size of the signal in bytes
+} ed247_signal_binding_t;
+
+/**
+ * @brief Resolve the location of a signal in the assistant sample buffer, for direct access.
+ * @details
+ * The location stays valid as long as the context is loaded. Writing the binding data is equivalent to
+ * ed247_stream_assistant_write_signal() once the values are in network byte order. <br/>
+ * This is the entry point of the typed C++ accessors of ed247_signal_accessor.h. <br/>
+ * Only available for fixed size streams (DISCRETE, ANALOGUE and NAD).
+ * @ingroup stream_assistant
+ * @param[in] assistant Assistant identifier
+ * @param[in] signal Signal identifier. It shall belong to the assistant stream.
+ * @param[in] nad_type Expected type of the signal values: ED247_NAD_TYPE_FLOAT32 for ANALOGUE, ED247_NAD_TYPE_UINT8 for DISCRETE
+ * @param[out] binding The signal location
+ * @retval ED247_STATUS_SUCCESS
+ * @retval ED247_STATUS_FAILURE The signal is not part of the stream or its type is not nad_type
+ */
+extern LIBED247_EXPORT ed247_status_t ed247_stream_assistant_bind_signal(
+    ed247_stream_assistant_t assistant,
+    ed247_signal_t           signal,
+    ed247_nad_type_t         nad_type,
+    ed247_signal_binding_t * binding);
+
 
 /**
  * @brief Push the assistant sample buffer on the stream stack.
@@ -0,0 +1,151 @@
+/* -*- mode: c++; c-basic-offset: 2 -*-  */
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include "ed247_async_sender.h"
+#include "ed247_cominterface.h"
+#include "ed247_logs.h"
+#include <cstring>
+#include <chrono>
+#ifdef __linux__
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+namespace {
+  // Time the sender thread sleeps when the queue is empty before checking it again.
+  // The producer wakes it up sooner when it push a frame.
+  const std::chrono::milliseconds IDLE_TIMEOUT(10);
+}
+
+ed247::AsyncSender::AsyncSender(uint32_t queue_frame_count, uint32_t frame_capacity, int32_t cpu_affinity) :
+  _frame_capacity(frame_capacity),
+  _payloads((size_t)queue_frame_count * frame_capacity),
+  _slots(queue_frame_count),
+  _head(0),
+  _tail(0),
+  _sleeping(false),
+  _stop(false),
+  _full_count(0)
+{
+  if (queue_frame_count == 0) {
+    THROW_ED247_ERROR("Asynchronous sender: the queue shall contain at least one frame");
+  }
+  MEMCHECK_NEW(this, "AsyncSender");
+
+  for (uint32_t index = 0; index < queue_frame_count; index++) {
+    _slots[index].payload = _payloads.data() + (size_t)index * frame_capacity;
+  }
+
+  _thread = std::thread(&AsyncSender::run, this);
+
+  if (cpu_affinity >= 0) {
+#ifdef __linux__
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu_affinity, &cpu_set);
+    if (pthread_setaffinity_np(_thread.native_handle(), sizeof(cpu_set), &cpu_set) != 0) {
+      PRINT_WARNING("Asynchronous sender: failed to pin the sender thread on CPU " << cpu_affinity);
+    }
+#else
+    PRINT_WARNING("Asynchronous sender: CPU affinity is not supported on this platform");
+#endif
+  }
+
+  PRINT_DEBUG("Asynchronous sender: " << queue_frame_count << " frames of " << frame_capacity << " bytes");
+}
+
+ed247::AsyncSender::~AsyncSender()
+{
+  flush();
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _wake_up.notify_one();
+  _thread.join();
+  if (_full_count != 0) {
+    PRINT_DEBUG("Asynchronous sender: the queue has been full " << _full_count << " times");
+  }
+  MEMCHECK_DEL(this, "AsyncSender");
+}
+
+void ed247::AsyncSender::push(udp::ComInterface* com_interface, const void* payload, uint32_t payload_size)
+{
+  if (payload_size > _frame_capacity) {
+    THROW_ED247_ERROR("Asynchronous sender: frame of " << payload_size << " bytes exceed the slot size (" << _frame_capacity << " bytes)");
+  }
+
+  uint64_t head = _head.load(std::memory_order_relaxed);
+  if (head - _tail.load(std::memory_order_acquire) == _slots.size()) {
+    _full_count++;
+    while (head - _tail.load(std::memory_order_acquire) == _slots.size()) {
+      std::this_thread::yield();
+    }
+  }
+
+  slot_t& slot = _slots[head % _slots.size()];
+  slot.com_interface = com_interface;
+  slot.size = payload_size;
+  memcpy(slot.payload, payload, payload_size);
+  _head.store(head + 1);
+
+  if (_sleeping.load()) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _wake_up.notify_one();
+  }
+}
+
+void ed247::AsyncSender::flush()
+{
+  uint64_t head = _head.load(std::memory_order_relaxed);
+  while (_tail.load(std::memory_order_acquire) != head) {
+    std::this_thread::yield();
+  }
+}
+
+void ed247::AsyncSender::run()
+{
+  while (true) {
+    uint64_t tail = _tail.load(std::memory_order_relaxed);
+
+    if (tail == _head.load(std::memory_order_acquire)) {
+      // Empty queue: sleep until a push() or the destructor wake us up
+      std::unique_lock<std::mutex> lock(_mutex);
+      _sleeping = true;
+      _wake_up.wait_for(lock, IDLE_TIMEOUT, [this, tail]() { return _stop || tail != _head.load(); });
+      _sleeping = false;
+      if (_stop && tail == _head.load()) return;
+      continue;
+    }
+
+    slot_t& slot = _slots[tail % _slots.size()];
+    try {
+      slot.com_interface->send_frame_now(slot.payload, slot.size);
+    }
+    catch(std::exception& e) {
+      PRINT_ERROR("Asynchronous sender: " << e.what());
+    }
+    _tail.store(tail + 1, std::memory_order_release);
+  }
+}
@@ -0,0 +1,96 @@
+/* -*- mode: c++; c-basic-offset: 2 -*-  */
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef _ED247_ASYNC_SENDER_H_
+#define _ED247_ASYNC_SENDER_H_
+#include "ed247.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ed247
+{
+  namespace udp {
+    class ComInterface;
+  }
+
+  //
+  // Asynchronous sender
+  // Frames encoded by the caller thread are copied in a single producer / single consumer
+  // ring of preallocated slots. A background thread pops them and performs the sendto().
+  // The producer never takes a lock: the mutex is only used to wake up the sender thread
+  // when it sleeps on an empty queue.
+  //
+  class AsyncSender
+  {
+  public:
+    // frame_capacity: size of the largest frame to be sent
+    // cpu_affinity: CPU the sender thread is pinned on (-1 for none)
+    AsyncSender(uint32_t queue_frame_count, uint32_t frame_capacity, int32_t cpu_affinity);
+    ~AsyncSender();
+
+    AsyncSender(const AsyncSender &)             = delete;
+    AsyncSender& operator=(const AsyncSender &)  = delete;
+
+    // Copy the frame in the queue. Wait for a free slot if the queue is full.
+    // Shall always be called from the same thread.
+    void push(udp::ComInterface* com_interface, const void* payload, uint32_t payload_size);
+
+    // Wait until all queued frames have been sent
+    void flush();
+
+    // Number of frames queued and not yet sent
+    uint32_t get_backlog() const { return (uint32_t)(_head.load() - _tail.load()); }
+
+    // Size of the largest frame push() accepts
+    uint32_t get_frame_capacity() const { return _frame_capacity; }
+
+  private:
+    struct slot_t {
+      udp::ComInterface* com_interface;
+      uint32_t           size;
+      char*              payload;
+    };
+
+    void run();
+
+    uint32_t               _frame_capacity;
+    std::vector<char>      _payloads;
+    std::vector<slot_t>    _slots;
+
+    std::atomic<uint64_t>  _head;        // Next slot to fill (written by producer only)
+    std::atomic<uint64_t>  _tail;        // Next slot to send (written by sender thread only)
+    std::atomic<bool>      _sleeping;
+    std::atomic<bool>      _stop;
+    uint64_t               _full_count;  // Number of push() that had to wait for a free slot
+
+    std::mutex             _mutex;
+    std::condition_variable _wake_up;
+    std::thread            _thread;
+  };
+}
+
+#endif
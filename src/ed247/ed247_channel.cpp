@@ -26,7 +26,7 @@
 #include "ed247_context.h"
 #include "ed247_client_list.h"
 #include "ed247_logs.h"
-#include <regex>
+#include <algorithm>
 
 typedef uint16_t stream_size_t;
 
@@ -53,7 +53,9 @@ ed247::Channel::Channel(Context* context, const xml::Channel* configuration) :
   _user_data(NULL),
   _client_streams(ed247::ClientStreamList::wrap(_streams))
 {
+  // The frame buffer is only used to encode output streams
   uint32_t capacity = 0;
+  bool has_output_stream = false;
   capacity += _header.get_size();
 
   for(auto& stream_configuration : configuration->_stream_list)
@@ -64,8 +66,13 @@ ed247::Channel::Channel(Context* context, const xml::Channel* configuration) :
     if (result.second == false) {
       THROW_ED247_ERROR("Stream [" << stream->get_name() << "] uses an UID already registered in Channel [" << get_name() << "]");
     }
+    _streams_by_name.emplace(stream->get_name().c_str(), stream);
+    if (stream->get_uid() >= _streams_by_uid.size()) _streams_by_uid.resize(stream->get_uid() + 1, nullptr);
+    _streams_by_uid[stream->get_uid()] = stream.get();
 
     // Compute buffer capacity
+    if((stream->get_direction() & ED247_DIRECTION_OUT) == 0) continue;
+    has_output_stream = true;
     if(_configuration->_is_simple_channel == false) {
       capacity += sizeof(ed247_uid_t) + sizeof(stream_size_t);
     }
@@ -74,9 +81,11 @@ ed247::Channel::Channel(Context* context, const xml::Channel* configuration) :
 
   // Load the ComInterface and connect decode()
   _com_interface.load(configuration->_com_interface,
-                      std::bind(&Channel::decode, this, std::placeholders::_1, std::placeholders::_2));
+                      std::bind(&Channel::decode, this, std::placeholders::_1, std::placeholders::_2),
+                      std::bind(&Channel::match_frame, this, std::placeholders::_1, std::placeholders::_2),
+                      this);
 
-  _buffer.allocate(capacity);
+  if (has_output_stream) _buffer.allocate(capacity);
 
   MEMCHECK_NEW(this, "Channel " << _configuration->_name);
 }
@@ -86,33 +95,41 @@ ed247::Channel::~Channel()
   MEMCHECK_DEL(this, "Channel " << _configuration->_name);
 }
 
+void ed247::Channel::add_memory_footprint(ed247_memory_footprint_t& footprint) const
+{
+  footprint.allocated_bytes += _buffer.capacity();
+  footprint.max_bytes += _buffer.capacity();
+  for (auto& pair : _streams) {
+    pair.second->add_memory_footprint(footprint);
+  }
+}
 
 
-ed247::stream_list_t ed247::Channel::find_streams(std::string strregex)
+
+ed247::stream_list_t ed247::Channel::find_streams(const NamePattern& pattern)
 {
-  std::regex reg(strregex);
   stream_list_t founds;
+  if (pattern.kind() == NamePattern::Kind::Exact) {
+    stream_ptr_t stream = get_stream(pattern.literal_prefix());
+    if (stream) founds.push_back(stream);
+    return founds;
+  }
   map_uid_stream_t::iterator iter = _streams.begin();
   for(iter = _streams.begin() ; iter != _streams.end() ; iter++){
     if(!iter->second) {
       THROW_ED247_ERROR("Channel '" << get_name() << "': contains an invalid Stream at [" << iter->first << "]");
     }
-    if(std::regex_match(iter->second->get_name(), reg)){
+    if(pattern.match(iter->second->get_name())){
       founds.push_back(iter->second);
     }
   }
   return founds;
 }
 
-ed247::stream_ptr_t ed247::Channel::get_stream(std::string str_name)
+ed247::stream_ptr_t ed247::Channel::get_stream(const char* name)
 {
-  map_uid_stream_t::iterator iter = _streams.begin();
-  for(iter = _streams.begin() ; iter != _streams.end() ; iter++){
-    if(!iter->second) {
-      THROW_ED247_ERROR("Channel '" << get_name() << "': contains an invalid Stream at [" << iter->first << "]");
-    }
-    if(iter->second->get_name() == str_name) return iter->second;
-  }
+  auto iter = _streams_by_name.find(name);
+  if (iter != _streams_by_name.end()) return iter->second;
   return nullptr;
 }
 
@@ -189,13 +206,29 @@ void ed247::Channel::encode_and_send()
 }
 
 
+void ed247::Channel::send_pushed_samples()
+{
+  encode_and_send();
+  _context->get_receiver_set().submit_sends();
+}
+
 
 bool ed247::Channel::decode(const char* frame, uint32_t frame_size)
 {
   uint32_t frame_index = 0;
 
+  _context->notify_frame_received(this, frame, frame_size);
+
   if (_header.decode(frame, frame_size, frame_index) == false) return false;
 
+  // Frames of the other components are dropped before their streams are decoded
+  if (_accepted_components.empty() == false &&
+      std::binary_search(_accepted_components.begin(), _accepted_components.end(),
+                         _header.get_recv_frame_details().component_identifier) == false) {
+    _dropped_frame_count.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
   if(_configuration->_is_simple_channel)
   {
     // Simple channel
@@ -207,6 +240,7 @@ bool ed247::Channel::decode(const char* frame, uint32_t frame_size)
   else
   {
     // MultiChannel
+    uint32_t decoded_stream_count = 0;
     while(frame_index < frame_size) {
 
       // Decode header
@@ -225,24 +259,71 @@ bool ed247::Channel::decode(const char* frame, uint32_t frame_size)
                     frame_index << ". A stream of size " << stream_sample_size << " is expected.");
         return false;
       }
-      map_uid_stream_t::iterator istream = _streams.find(stream_uid);
-      if (istream != _streams.end()) {
-        if (istream->second->decode(frame + frame_index, stream_sample_size, _header.get_recv_frame_details()) == false) {
+      Stream* stream = (stream_uid < _streams_by_uid.size()) ? _streams_by_uid[stream_uid] : nullptr;
+      if (stream != nullptr) {
+        if (stream->decode(frame + frame_index, stream_sample_size, _header.get_recv_frame_details()) == false) {
           // Decode goes wrong. We cannot decode remaining data
           PRINT_ERROR("Channel '" << get_name() << ": Cannot decode stream " << stream_uid);
           return false;
         }
+        decoded_stream_count++;
       } else {
         // We don't known this stream.
         // This is not an error: it might be for another receiver. We process the next stream.
       }
       frame_index += stream_sample_size;
     }
+    if (decoded_stream_count == 0) _dropped_frame_count.fetch_add(1, std::memory_order_relaxed);
   }
 
   return true;
 }
 
+bool ed247::Channel::send_frame(const void* frame, uint32_t frame_size)
+{
+  if (frame_size > udp::Receiver::MAX_FRAME_SIZE) {
+    PRINT_ERROR("Channel '" << get_name() << "': Cannot send a frame of " << frame_size << " bytes (max "
+                << udp::Receiver::MAX_FRAME_SIZE << ")");
+    return false;
+  }
+  // The slots of the asynchronous sender are sized for the frames encoded by the channels
+  AsyncSender* async_sender = _context->get_async_sender();
+  if (async_sender != nullptr && frame_size > async_sender->get_frame_capacity()) {
+    PRINT_ERROR("Channel '" << get_name() << "': Cannot send a frame of " << frame_size << " bytes: the asynchronous sender "
+                << "slots are of " << async_sender->get_frame_capacity() << " bytes");
+    return false;
+  }
+  _com_interface.send_frame(frame, frame_size);
+  return true;
+}
+
+bool ed247::Channel::match_frame(const char* frame, uint32_t frame_size) const
+{
+  // A simple channel frame has no stream UID
+  if (_configuration->_is_simple_channel) return true;
+
+  // Accept the frame if any of its streams is a stream of the channel. decode() skips the other ones.
+  uint32_t frame_index = _header.get_size();
+  while (frame_index < frame_size) {
+    // Let decode() report the frames that are too short
+    if (frame_size - frame_index < sizeof(ed247_uid_t) + sizeof(stream_size_t)) return true;
+    ed247_uid_t stream_uid = ntohs(*(ed247_uid_t*)(frame + frame_index));
+    if (stream_uid < _streams_by_uid.size() && _streams_by_uid[stream_uid] != nullptr) return true;
+    frame_index += sizeof(ed247_uid_t);
+    frame_index += sizeof(stream_size_t) + ntohs(*(stream_size_t*)(frame + frame_index));
+  }
+  return false;
+}
+
+void ed247::Channel::set_component_filter(const std::vector<ed247_uid_t>& component_identifiers)
+{
+  if (component_identifiers.empty() == false && _header.get_size() == 0) {
+    THROW_ED247_ERROR("Channel '" << get_name() << "': the component filter requires a frame header");
+  }
+  _accepted_components = component_identifiers;
+  std::sort(_accepted_components.begin(), _accepted_components.end());
+}
+
 
 //
 // ChannelSet
@@ -264,6 +345,7 @@ ed247::channel_ptr_t ed247::ChannelSet::create(const ed247::xml::Channel* config
   channel_ptr_t channel = std::make_shared<Channel>(_context, configuration);
   auto result = _channels.emplace(std::make_pair(configuration->_name, channel));
   if (result.second == false) THROW_ED247_ERROR("Channel [" << configuration->_name << "] already exist !");
+  _sorted_channels.insert(result.first->first.c_str(), result.first->second);
   return result.first->second;
 }
 
@@ -274,14 +356,9 @@ ed247::channel_ptr_t ed247::ChannelSet::get(std::string name)
   return nullptr;
 }
 
-ed247::channel_list_t ed247::ChannelSet::find(std::string str_regex)
+ed247::channel_list_t ed247::ChannelSet::find(const NamePattern& pattern) const
 {
-  std::regex reg(str_regex);
   channel_list_t founds;
-  for(auto& channel_pair : _channels) {
-    if(std::regex_match(channel_pair.first, reg)) {
-      founds.push_back(channel_pair.second);
-    }
-  }
+  pattern.select(_sorted_channels, founds);
   return founds;
 }
@@ -29,6 +29,8 @@
 #include "ed247_cominterface.h"
 #include "ed247_stream.h"
 #include "ed247_frame_header.h"
+#include "ed247_name_index.h"
+#include <atomic>
 
 // base structures for C API
 struct ed247_internal_channel_t {};
@@ -42,6 +44,7 @@ namespace ed247
   {
   public:
     using map_uid_stream_t = std::unordered_map<ed247_uid_t, stream_ptr_t>;
+    using map_name_stream_t = name_index_t<stream_ptr_t>;
 
     Channel(Context* context, const xml::Channel* configuration);
     ~Channel();
@@ -59,8 +62,10 @@ namespace ed247
     void get_user_data(void **user_data) { *user_data = _user_data; }
 
     // Stream access
-    stream_list_t find_streams(std::string strregex);
-    stream_ptr_t get_stream(std::string str_name);
+    stream_list_t find_streams(const std::string& strregex) { return find_streams(NamePattern(strregex)); }
+    stream_list_t find_streams(const NamePattern& pattern);
+    stream_ptr_t get_stream(const char* name);
+    stream_ptr_t get_stream(const std::string& name) { return get_stream(name.c_str()); }
     ed247_internal_stream_list_t* get_client_streams() { return _client_streams.get(); }
 
     // Encode the channel and send it.
@@ -68,18 +73,58 @@ namespace ed247
     // In some cases, this function may send severals packets.
     void encode_and_send();
 
+    // Encode and send the channel, then submit the sends queued by the io_uring engine
+    // (ed247_channel_send_pushed_samples(), Context::send_pushed_samples() submits once for all channels)
+    void send_pushed_samples();
+
+    // Send a raw frame (header included) to all the ComInterface emitters
+    // Return false if the frame is too large for an UDP datagram or for the asynchronous sender slots.
+    bool send_frame(const void* frame, uint32_t frame_size);
+
+    // Number of frames that failed to be sent (see ComInterface::get_send_error_count())
+    uint64_t get_send_error_count() const { return _com_interface.get_send_error_count(); }
+
+    // Size of the largest frame this channel may send (0 if it has no output stream)
+    uint32_t get_frame_capacity() const { return _buffer.capacity(); }
+
     // Decode frame and fill streams data
     // Return false if the frame cannot be decoded
     bool decode(const char* frame, uint32_t frame_size);
 
+    // Return true if frame may be for this channel: one of the stream UIDs of a MultiChannel frame
+    // shall be one of its streams. Used to dispatch the frames of an address shared by several channels.
+    bool match_frame(const char* frame, uint32_t frame_size) const;
+
+    // Only decode the frames whose header component identifier is in component_identifiers (all if empty).
+    // Throw if the channel has no header.
+    void set_component_filter(const std::vector<ed247_uid_t>& component_identifiers);
+
+    // Number of received frames dropped by the component filter or without any stream of the channel
+    uint64_t get_dropped_frame_count() const { return _dropped_frame_count.load(std::memory_order_relaxed); }
+
+    // Set the kernel buffer sizes of the ComInterface sockets (see ComInterface::set_socket_buffer_sizes())
+    bool set_socket_buffer_sizes(uint32_t receive_buffer_size, uint32_t send_buffer_size) {
+      return _com_interface.set_socket_buffer_sizes(receive_buffer_size, send_buffer_size);
+    }
+
+    // Number of frames dropped by the kernel on the ComInterface receive sockets
+    uint64_t get_kernel_drop_count() const { return _com_interface.get_kernel_drop_count(); }
+
+    // Add the frame buffer and the streams buffers to footprint
+    void add_memory_footprint(ed247_memory_footprint_t& footprint) const;
+
   private:
     Context*            _context;
     const xml::Channel* _configuration;
     udp::ComInterface   _com_interface;
-    map_uid_stream_t    _streams;
-    FrameHeader         _header;
-    Sample              _buffer;
-    void*               _user_data;
+    map_uid_stream_t         _streams;
+    map_name_stream_t        _streams_by_name;
+    std::vector<Stream*>     _streams_by_uid;         // Index is the UID, nullptr if unknown: dispatch without lookup
+    std::vector<ed247_uid_t> _accepted_components;    // Sorted. Empty: all accepted.
+    std::atomic<uint64_t>    _dropped_frame_count{0};
+    FrameHeader              _header;
+    Sample                   _buffer;
+    void*                    _user_data;
 
     std::unique_ptr<ed247_internal_stream_list_t> _client_streams;
 
@@ -101,14 +146,19 @@ namespace ed247
     channel_ptr_t create(const xml::Channel* configuration);
 
     channel_ptr_t get(std::string str_name);
-    channel_list_t find(std::string str_regex);
+    channel_list_t find(const std::string& str_regex) const { return find(NamePattern(str_regex)); }
+    channel_list_t find(const NamePattern& pattern) const;
+
+    // Sort the name index once all the channels are created
+    void sort_names() { _sorted_channels.sort(); }
 
     channel_map_t& channels()  { return _channels;        }
     uint32_t size() const      { return _channels.size(); }
 
   private:
-    Context*            _context;
-    channel_map_t      _channels;
+    Context*                       _context;
+    channel_map_t                  _channels;
+    SortedNameIndex<channel_ptr_t> _sorted_channels;
   };
 
 }
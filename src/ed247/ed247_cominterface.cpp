@@ -23,11 +23,18 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  *****************************************************************************/
 #include "ed247_cominterface.h"
+#include "ed247_transport.h"
 #include "ed247_context.h"
 #include "ed247_time.h"
 #include "ed247_logs.h"
+#ifdef ED247_IO_URING_ENABLED
+# include "ed247_uring.h"
+#endif
 #include <unistd.h>
 #include <fcntl.h>
+#ifdef __linux__
+# include <sys/epoll.h>
+#endif
 #include <unordered_map>
 #include <unordered_set>
 
@@ -101,18 +108,6 @@ namespace ed247 {
       THROW_ED247_ERROR("[" << address << "] " << m << " (" << error << ")"); \
     }
 
-    struct socket_address_hash {
-      size_t operator()(const socket_address_t& socket_address) const {
-        return std::hash<uint32_t>()(socket_address.sin_addr.s_addr) ^ std::hash<uint16_t>()(socket_address.sin_port);
-      }
-    };
-
-    struct socket_address_equal_to {
-      bool operator()(const socket_address_t& a, const socket_address_t& b) const {
-        return a.sin_addr.s_addr == b.sin_addr.s_addr && a.sin_port == b.sin_port;
-      }
-    };
-
     struct system_socket_map_t {
 
       // Return an existing socket or create a new one
@@ -233,7 +228,9 @@ ed247::udp::ComInterface::~ComInterface()
 }
 
 void ed247::udp::ComInterface::load(const xml::ComInterface& configuration,
-                                    Receiver::receive_callback_t receive_callback)
+                                    Receiver::receive_callback_t receive_callback,
+                                    Receiver::frame_filter_t frame_filter,
+                                    Channel* channel)
 {
 #ifdef _WIN32
   static bool winsocks_initialized = false;
@@ -255,10 +252,9 @@ void ed247::udp::ComInterface::load(const xml::ComInterface& configuration,
     {
       socket_address_t from_address(destination_address);
 
-      _context->get_receiver_set().emplace(new Receiver(_context,
-                                                        from_address,
-                                                        multicast_interface,
-                                                        receive_callback));
+      Receiver* receiver = new Receiver(_context, from_address, multicast_interface, receive_callback, frame_filter, channel);
+      _context->get_receiver_set().emplace(receiver);
+      _receivers.push_back(receiver);
       break;
     }
 
@@ -284,12 +280,65 @@ void ed247::udp::ComInterface::load(const xml::ComInterface& configuration,
 }
 
 void ed247::udp::ComInterface::send_frame(const void* payload, const uint32_t payload_size)
+{
+  AsyncSender* async_sender = _context->get_async_sender();
+  if (async_sender) {
+    async_sender->push(this, payload, payload_size);
+    return;
+  }
+#ifdef ED247_IO_URING_ENABLED
+  UringEngine* uring = _context->get_receiver_set().get_uring();
+  if (uring) {
+    for(auto emitter = _emitters.begin() ; emitter != _emitters.end(); emitter++) {
+      uring->queue_send((*emitter)->get_socket(), (*emitter)->get_destination_address(), payload, payload_size);
+    }
+    return;
+  }
+#endif
+  send_frame_now(payload, payload_size);
+}
+
+void ed247::udp::ComInterface::send_frame_now(const void* payload, const uint32_t payload_size)
 {
   for(auto emitter = _emitters.begin() ; emitter != _emitters.end(); emitter++) {
     (*emitter)->send_frame(payload, payload_size);
   }
 }
 
+uint64_t ed247::udp::ComInterface::get_send_error_count() const
+{
+  uint64_t count = 0;
+  for(auto& emitter : _emitters) {
+    count += emitter->get_send_error_count();
+  }
+  return count;
+}
+
+bool ed247::udp::ComInterface::set_socket_buffer_sizes(uint32_t receive_buffer_size, uint32_t send_buffer_size)
+{
+  bool success = true;
+  if (receive_buffer_size != 0) {
+    for(Receiver* receiver : _receivers) {
+      success &= receiver->set_receive_buffer_size(receive_buffer_size);
+    }
+  }
+  if (send_buffer_size != 0) {
+    for(auto& emitter : _emitters) {
+      success &= emitter->set_send_buffer_size(send_buffer_size);
+    }
+  }
+  return success;
+}
+
+uint64_t ed247::udp::ComInterface::get_kernel_drop_count() const
+{
+  uint64_t count = 0;
+  for(Receiver* receiver : _receivers) {
+    count += receiver->get_kernel_drop_count();
+  }
+  return count;
+}
+
 
 //
 // Transceiver
@@ -313,12 +362,40 @@ ed247::udp::Transceiver::Transceiver(Context* context, const socket_address_t& s
   }
 
   MEMCHECK_NEW(this, "Transceiver " << _socket_address);
-  _socket = system_socket_map.create(_socket_address, enableReuseAddr);
+  if (_context->get_receiver_set().get_transport() == nullptr) {
+    _socket = system_socket_map.create(_socket_address, enableReuseAddr);
+  }
 }
 
 ed247::udp::Transceiver::~Transceiver() {
   MEMCHECK_DEL(this, "Transceiver " << _socket_address);
-  system_socket_map.release(_socket_address);
+  if (_socket != INVALID_SOCKET) system_socket_map.release(_socket_address);
+}
+
+bool ed247::udp::Transceiver::set_socket_buffer_size(int option, int force_option, const char* option_name, uint32_t size)
+{
+  if (_socket == INVALID_SOCKET) return false;
+  int value = size;
+  if (force_option == 0 || setsockopt(_socket, SOL_SOCKET, force_option, (const char*)&value, sizeof(value)) != 0) {
+    if (setsockopt(_socket, SOL_SOCKET, option, (const char*)&value, sizeof(value)) != 0) {
+      PRINT_WARNING("Failed to set " << option_name << " to " << size << " on socket " << _socket_address << " (" << ed247_get_system_error() << ")");
+      return false;
+    }
+  }
+
+  // Linux doubles the requested size (bookkeeping overhead) and caps it to the system maximum
+  int actual_size = 0;
+  socklen_t actual_size_length = sizeof(actual_size);
+  if (getsockopt(_socket, SOL_SOCKET, option, (char*)&actual_size, &actual_size_length) == 0) {
+    PRINT_DEBUG("[SOCKET] " << _socket_address << " " << option_name << ": " << actual_size << " bytes (requested " << size << ")");
+#ifdef __linux__
+    if ((uint32_t)actual_size / 2 < size) {
+      PRINT_WARNING(option_name << " of socket " << _socket_address << " is limited to " << actual_size / 2
+                    << " bytes by the system maximum (net.core.rmem_max/wmem_max)");
+    }
+#endif
+  }
+  return true;
 }
 
 //
@@ -328,7 +405,7 @@ ed247::udp::Emitter::Emitter(Context* context, socket_address_t from_address, so
   Transceiver(context, from_address),
   _destination_address(destination_address)
 {
-  if(_destination_address.is_multicast()) {
+  if(_destination_address.is_multicast() && _socket != INVALID_SOCKET) {
     int sockerr = 0;
 
     // Set outgoing interface
@@ -348,12 +425,30 @@ ed247::udp::Emitter::Emitter(Context* context, socket_address_t from_address, so
 }
 
 
+bool ed247::udp::Emitter::set_send_buffer_size(uint32_t size)
+{
+#if defined(__linux__) && defined(SO_SNDBUFFORCE)
+  return set_socket_buffer_size(SO_SNDBUF, SO_SNDBUFFORCE, "SO_SNDBUF", size);
+#else
+  return set_socket_buffer_size(SO_SNDBUF, 0, "SO_SNDBUF", size);
+#endif
+}
+
 void ed247::udp::Emitter::send_frame(const void* payload, const uint32_t payload_size)
 {
+  FrameTransport* transport = _context->get_receiver_set().get_transport();
+  if (transport) {
+    if (transport->send_frame(_socket_address, _destination_address, payload, payload_size) == false) {
+      _send_error_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    return;
+  }
+
   PRINT_CRAZY("sendto() from (" << _socket_address << ") to (" << _destination_address << "), size " << payload_size << "b [" << hex_stream(payload, payload_size) << "]");
   int32_t sent_size = sendto(_socket, (const char *)payload, payload_size, 0, (struct sockaddr *)&_destination_address, sizeof(struct sockaddr_in));
   if(sent_size < 0 || (uint32_t)sent_size != payload_size) {
     PRINT_ERROR("Failed to send frame from socket socket [" << _socket_address << "] to [" << _destination_address << "] (" << ed247_get_system_error() << ")");
+    _send_error_count.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
@@ -363,12 +458,16 @@ void ed247::udp::Emitter::send_frame(const void* payload, const uint32_t payload
 ed247::udp::Receiver::Receiver(Context* context,
                                socket_address_t from_address,
                                socket_address_t multicast_interface,
-                               receive_callback_t callback) :
+                               receive_callback_t callback,
+                               frame_filter_t frame_filter,
+                               Channel* channel) :
   Transceiver(context, from_address),
   _receive_callback(callback),
+  _frame_filter(frame_filter),
+  _channel(channel),
   _receive_frame(context->get_receiver_set().get_receive_frame())
 {
-  if (from_address.is_multicast()) {
+  if (from_address.is_multicast() && _socket != INVALID_SOCKET) {
     // In multicast: join the group 'from_address' on interface 'multicast_interface'.
     int sockerr = 0;
     struct ip_mreq imreq;
@@ -378,6 +477,13 @@ ed247::udp::Receiver::Receiver(Context* context,
     sockerr = setsockopt(_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, (const char *)&imreq, sizeof(struct ip_mreq));
     if (sockerr) THROW_SOCKET_ERROR(_socket_address, "Failed to join the multicast group " << from_address << ".");
   }
+
+#if defined(__linux__) && defined(SO_RXQ_OVFL)
+  // Report the kernel drops in the ancillary data of the received frames
+  if (_socket != INVALID_SOCKET && setsockopt(_socket, SOL_SOCKET, SO_RXQ_OVFL, (const char*)&one, sizeof(one)) != 0) {
+    PRINT_WARNING("Failed to set SO_RXQ_OVFL on socket " << _socket_address << " (" << ed247_get_system_error() << ")");
+  }
+#endif
 }
 
 void ed247::udp::Receiver::receive()
@@ -385,13 +491,17 @@ void ed247::udp::Receiver::receive()
   int recv_result = 0;
   bool frame_received = false;
   do {
-    recv_result = ::recvfrom(_socket, _receive_frame.payload, MAX_FRAME_SIZE, 0, nullptr, 0);
+    if (_context->get_receiver_set().is_datagram_info_enabled()) {
+      recv_result = receive_datagram();
+    } else {
+      recv_result = receive_frame();
+    }
     if(recv_result <= 0) break;
     frame_received = true;
 
     _receive_frame.size = recv_result;
     PRINT_CRAZY("Received frame of " << _receive_frame.size << " bytes: [" << hex_stream(_receive_frame.payload, _receive_frame.size) << "]");
-    _receive_callback(_receive_frame.payload, _receive_frame.size);
+    deliver_frame(_receive_frame.payload, _receive_frame.size);
   } while(recv_result > 0);
 
   if(frame_received == false && recv_result <= 0) {
@@ -399,28 +509,415 @@ void ed247::udp::Receiver::receive()
   }
 }
 
+uint32_t ed247::udp::Receiver::poll()
+{
+  uint32_t frame_count = 0;
+  if (_context->get_receiver_set().is_datagram_info_enabled()) {
+    while(receive_datagram() > 0) {
+      deliver_frame(_receive_frame.payload, _receive_frame.size);
+      frame_count++;
+    }
+    return frame_count;
+  }
+#ifdef __linux__
+  ReceiverSet::receive_batch_t& batch = _context->get_receiver_set().get_receive_batch();
+  int recv_result = 0;
+  do {
+    for (mmsghdr& header : batch.headers) {
+      header.msg_hdr.msg_controllen = sizeof(ReceiverSet::receive_batch_t::control_t);
+    }
+    recv_result = ::recvmmsg(_socket, batch.headers.data(), batch.headers.size(), MSG_DONTWAIT, nullptr);
+    // The drop count is cumulative: the last frame has the latest one
+    if (recv_result > 0) update_kernel_drop_count(batch.headers[recv_result - 1].msg_hdr);
+    for (int index = 0; index < recv_result; index++) {
+      PRINT_CRAZY("Received frame of " << batch.headers[index].msg_len << " bytes: ["
+                  << hex_stream(batch.frames[index].payload, batch.headers[index].msg_len) << "]");
+      deliver_frame(batch.frames[index].payload, batch.headers[index].msg_len);
+    }
+    if (recv_result > 0) frame_count += recv_result;
+  } while(recv_result == (int)batch.headers.size());
+
+  if (recv_result < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+    PRINT_ERROR("recvmmsg() failed on socket " << _socket_address << ". " << ed247_get_system_error());
+  }
+#else
+  int recv_result = 0;
+  while((recv_result = ::recvfrom(_socket, _receive_frame.payload, MAX_FRAME_SIZE, 0, nullptr, 0)) > 0) {
+    _receive_frame.size = recv_result;
+    deliver_frame(_receive_frame.payload, _receive_frame.size);
+    frame_count++;
+  }
+#endif
+  return frame_count;
+}
+
+void ed247::udp::Receiver::deliver_frame(const char* payload, uint32_t size)
+{
+  if (_siblings.empty()) {
+    _context->notify_datagram_received(_channel, payload, size);
+    _receive_callback(payload, size);
+  } else {
+    dispatch_frame(payload, size);
+  }
+}
+
+void ed247::udp::Receiver::dispatch_frame(const char* payload, uint32_t size)
+{
+  // The datagram is notified once, with the first channel that accepts it
+  bool delivered = false;
+  auto deliver = [&](Receiver* receiver) {
+    if (receiver->_frame_filter != nullptr && receiver->_frame_filter(payload, size) == false) return;
+    if (delivered == false) {
+      _context->notify_datagram_received(receiver->_channel, payload, size);
+      delivered = true;
+    }
+    receiver->_receive_callback(payload, size);
+  };
+  deliver(this);
+  for (Receiver* sibling : _siblings) {
+    deliver(sibling);
+  }
+  if (delivered == false) {
+    _context->notify_datagram_received(nullptr, payload, size);
+    PRINT_DEBUG("Frame of " << size << " bytes received on " << _socket_address << " is for none of its channels");
+  }
+}
+
+int ed247::udp::Receiver::receive_frame()
+{
+#ifdef __linux__
+  char control[CMSG_SPACE(sizeof(uint32_t))];
+  struct iovec iov;
+  iov.iov_base = _receive_frame.payload;
+  iov.iov_len = MAX_FRAME_SIZE;
+  struct msghdr header;
+  memset(&header, 0, sizeof(header));
+  header.msg_iov = &iov;
+  header.msg_iovlen = 1;
+  header.msg_control = control;
+  header.msg_controllen = sizeof(control);
+
+  int recv_result = ::recvmsg(_socket, &header, 0);
+  if (recv_result > 0) update_kernel_drop_count(header);
+  return recv_result;
+#else
+  return ::recvfrom(_socket, _receive_frame.payload, MAX_FRAME_SIZE, 0, nullptr, 0);
+#endif
+}
+
+#ifdef __linux__
+void ed247::udp::Receiver::update_kernel_drop_count(const msghdr& header)
+{
+#ifdef SO_RXQ_OVFL
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr; cmsg = CMSG_NXTHDR((msghdr*)&header, cmsg)) {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL) {
+      memcpy(&_kernel_drop_count, CMSG_DATA(cmsg), sizeof(_kernel_drop_count));
+    }
+  }
+#else
+  (void)header;
+#endif
+}
+#endif
+
+int ed247::udp::Receiver::receive_datagram()
+{
+  ed247_datagram_info_t& info = _context->get_receiver_set().get_datagram_info();
+  sockaddr_in source_address;
+  bool kernel_timestamp = false;
+  memset(&source_address, 0, sizeof(source_address));
+
+#ifdef __unix__
+  char control[CMSG_SPACE(sizeof(struct timespec)) + CMSG_SPACE(sizeof(uint32_t))];
+  struct iovec iov;
+  iov.iov_base = _receive_frame.payload;
+  iov.iov_len = MAX_FRAME_SIZE;
+  struct msghdr header;
+  memset(&header, 0, sizeof(header));
+  header.msg_name = &source_address;
+  header.msg_namelen = sizeof(source_address);
+  header.msg_iov = &iov;
+  header.msg_iovlen = 1;
+  header.msg_control = control;
+  header.msg_controllen = sizeof(control);
+
+  int recv_result = ::recvmsg(_socket, &header, 0);
+  if (recv_result <= 0) return recv_result;
+
+#ifdef __linux__
+  update_kernel_drop_count(header);
+#endif
+#ifdef SCM_TIMESTAMPNS
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr; cmsg = CMSG_NXTHDR(&header, cmsg)) {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+      struct timespec timestamp;
+      memcpy(&timestamp, CMSG_DATA(cmsg), sizeof(timestamp));
+      info.timestamp.epoch_s = timestamp.tv_sec;
+      info.timestamp.offset_ns = timestamp.tv_nsec;
+      kernel_timestamp = true;
+    }
+  }
+#endif
+#else
+  int source_address_size = sizeof(source_address);
+  int recv_result = ::recvfrom(_socket, _receive_frame.payload, MAX_FRAME_SIZE, 0, (sockaddr*)&source_address, &source_address_size);
+  if (recv_result <= 0) return recv_result;
+#endif
+
+  _receive_frame.size = recv_result;
+  if (kernel_timestamp == false) ed247_get_receive_timestamp(&info.timestamp);
+  info.source_ip = ntohl(source_address.sin_addr.s_addr);
+  info.source_port = ntohs(source_address.sin_port);
+  info.destination_ip = ntohl(_socket_address.sin_addr.s_addr);
+  info.destination_port = ntohs(_socket_address.sin_port);
+  return recv_result;
+}
+
+bool ed247::udp::Receiver::set_socket_timestamps(bool enable)
+{
+  if (_socket == INVALID_SOCKET) return false;
+#if defined(__linux__) && defined(SO_TIMESTAMPNS)
+  int value = enable ? 1 : 0;
+  if (setsockopt(_socket, SOL_SOCKET, SO_TIMESTAMPNS, (const char*)&value, sizeof(value)) != 0) {
+    PRINT_WARNING("Failed to set SO_TIMESTAMPNS on socket " << _socket_address << " (" << ed247_get_system_error() << ")");
+    return false;
+  }
+  return true;
+#else
+  (void)enable;
+  return false;
+#endif
+}
+
+bool ed247::udp::Receiver::set_receive_buffer_size(uint32_t size)
+{
+#if defined(__linux__) && defined(SO_RCVBUFFORCE)
+  return set_socket_buffer_size(SO_RCVBUF, SO_RCVBUFFORCE, "SO_RCVBUF", size);
+#else
+  return set_socket_buffer_size(SO_RCVBUF, 0, "SO_RCVBUF", size);
+#endif
+}
+
+bool ed247::udp::Receiver::set_socket_busy_poll(uint32_t busy_poll_us)
+{
+  if (_socket == INVALID_SOCKET) return false;
+#if defined(__linux__) && defined(SO_BUSY_POLL)
+  int value = busy_poll_us;
+  if (setsockopt(_socket, SOL_SOCKET, SO_BUSY_POLL, (const char*)&value, sizeof(value)) != 0) {
+    PRINT_WARNING("Failed to set SO_BUSY_POLL on socket " << _socket_address << " (" << ed247_get_system_error() << ")");
+    return false;
+  }
+  return true;
+#else
+  PRINT_WARNING("SO_BUSY_POLL is not supported on this platform");
+  return false;
+#endif
+}
+
 //
 // ReceiverSet
 //
+ed247_transport_t ed247::udp::ReceiverSet::_default_transport = ED247_TRANSPORT_UDP;
+
 ed247::udp::ReceiverSet::ReceiverSet()
 {
   MEMCHECK_NEW(this, "udp::ReceiverSet");
   FD_ZERO(&_select_options.fd);
   _select_options.nfds = 0;
+
+  ed247_transport_t transport = _default_transport;
+  const char* env_transport;
+#ifdef _MSC_VER
+  size_t len;
+  _dupenv_s(&env_transport, &len, ENV_VAR_TRANSPORT);
+#else
+  env_transport = getenv(ENV_VAR_TRANSPORT);
+#endif
+  if (env_transport && *env_transport) {
+    if (strcmp(env_transport, "udp") == 0) {
+      transport = ED247_TRANSPORT_UDP;
+    } else if (strcmp(env_transport, "loopback") == 0) {
+      transport = ED247_TRANSPORT_LOOPBACK;
+    } else if (strcmp(env_transport, "shm") == 0) {
+      transport = ED247_TRANSPORT_SHM;
+    } else {
+      PRINT_WARNING("Invalid " << ENV_VAR_TRANSPORT << " value '" << env_transport << "'. Ignored.");
+    }
+  }
+
+  if (transport == ED247_TRANSPORT_LOOPBACK) {
+    _transport.reset(new LoopbackTransport(*this));
+    PRINT_DEBUG("UDP: using the in-process loopback transport");
+    return;
+  }
+  if (transport == ED247_TRANSPORT_SHM) {
+#ifdef __linux__
+    _transport.reset(new ShmTransport(*this));
+    PRINT_DEBUG("UDP: using the shared memory transport");
+    return;
+#else
+    THROW_ED247_ERROR("The shared memory transport is not supported on this platform");
+#endif
+  }
+
+#ifdef ED247_IO_URING_ENABLED
+  if (UringEngine::is_enabled()) {
+    try {
+      _uring.reset(new UringEngine());
+      PRINT_DEBUG("UDP: using io_uring engine");
+    }
+    catch(std::exception& e) {
+      PRINT_WARNING(e.what() << ". Fall back to select().");
+    }
+  }
+#endif
 }
 
 ed247::udp::ReceiverSet::~ReceiverSet()
 {
+  // Stop the deliveries to the receivers before they are destroyed
+  _transport.reset();
+  if (_epoll_fd != -1) close(_epoll_fd);
   MEMCHECK_DEL(this, "udp::ReceiverSet");
 }
 
 void ed247::udp::ReceiverSet::emplace(Receiver* receiver)
 {
+  _receivers.emplace_back(receiver);
+  for (Receiver* socket_receiver : _socket_receivers) {
+    if (socket_address_equal_to()(socket_receiver->get_socket_address(), receiver->get_socket_address())) {
+      socket_receiver->add_sibling(receiver);
+      return;
+    }
+  }
+  _socket_receivers.push_back(receiver);
+
+  if (_transport) {
+    _transport->add_receiver(receiver);
+    return;
+  }
+
   ed247_socket_t socket = receiver->get_socket();
   _select_options.nfds = (std::max)((int)(socket+1), _select_options.nfds);
   FD_SET(socket, &_select_options.fd);
 
-  _receivers.emplace_back(receiver);
+  if (_socket_busy_poll_us != 0) receiver->set_socket_busy_poll(_socket_busy_poll_us);
+  if (_datagram_info_enabled) receiver->set_socket_timestamps(true);
+#ifdef __linux__
+  if (_epoll_fd != -1) {
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = socket;
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, socket, &event) != 0) {
+      THROW_ED247_ERROR("Failed to add socket " << socket << " to the readiness fd (" << ed247_get_system_error() << ")");
+    }
+  }
+#endif
+#ifdef ED247_IO_URING_ENABLED
+  if (_uring) _uring->add_receiver(receiver);
+#endif
+}
+
+void ed247::udp::ReceiverSet::set_busy_poll(uint32_t spin_budget_us, uint32_t socket_busy_poll_us)
+{
+  if (_transport) {
+    if (spin_budget_us != 0) PRINT_WARNING("The busy poll mode is only available with the UDP transport");
+    return;
+  }
+
+  _spin_budget_us = spin_budget_us;
+  _socket_busy_poll_us = socket_busy_poll_us;
+
+  if (socket_busy_poll_us != 0) {
+    for(auto& receiver : _socket_receivers) {
+      receiver->set_socket_busy_poll(socket_busy_poll_us);
+    }
+  }
+
+#ifdef __linux__
+  if (spin_budget_us != 0 && _receive_batch.frames.empty()) {
+    _receive_batch.frames.resize(receive_batch_t::SIZE);
+    _receive_batch.iovecs.resize(receive_batch_t::SIZE);
+    _receive_batch.controls.resize(receive_batch_t::SIZE);
+    _receive_batch.headers.resize(receive_batch_t::SIZE);
+    for (uint32_t index = 0; index < receive_batch_t::SIZE; index++) {
+      _receive_batch.iovecs[index].iov_base = _receive_batch.frames[index].payload;
+      _receive_batch.iovecs[index].iov_len = Receiver::MAX_FRAME_SIZE;
+      memset(&_receive_batch.headers[index], 0, sizeof(mmsghdr));
+      _receive_batch.headers[index].msg_hdr.msg_iov = &_receive_batch.iovecs[index];
+      _receive_batch.headers[index].msg_hdr.msg_iovlen = 1;
+      _receive_batch.headers[index].msg_hdr.msg_control = _receive_batch.controls[index].data;
+    }
+  }
+#endif
+
+  if (spin_budget_us != 0) disable_uring("busy poll mode");
+}
+
+void ed247::udp::ReceiverSet::set_datagram_info_enabled(bool enable)
+{
+  if (enable == _datagram_info_enabled) return;
+  // The frames delivered by the io_uring engine when it stops have no datagram information
+  if (enable) disable_uring("datagram recording");
+  _datagram_info_enabled = enable;
+  for(auto& receiver : _socket_receivers) {
+    receiver->set_socket_timestamps(enable);
+  }
+}
+
+void ed247::udp::ReceiverSet::disable_uring(const char* reason)
+{
+#ifdef ED247_IO_URING_ENABLED
+  if (_uring) {
+    PRINT_DEBUG("UDP: " << reason << " replaces the io_uring engine");
+    // Detached first: the frames delivered by stop() may be answered by sends of the other engine
+    std::unique_ptr<UringEngine> uring(std::move(_uring));
+    uring->stop();
+  }
+#else
+  (void)reason;
+#endif
+}
+
+int ed247::udp::ReceiverSet::get_readiness_fd()
+{
+  if (_transport) {
+    THROW_ED247_ERROR("The readiness fd is only available with the UDP transport");
+  }
+#ifdef __linux__
+  if (_epoll_fd == -1) {
+    disable_uring("readiness fd");
+    _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (_epoll_fd == -1) {
+      THROW_ED247_ERROR("Failed to create the readiness fd (" << ed247_get_system_error() << ")");
+    }
+    for(auto& receiver : _socket_receivers) {
+      struct epoll_event event;
+      event.events = EPOLLIN;
+      event.data.fd = receiver->get_socket();
+      if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, receiver->get_socket(), &event) != 0) {
+        THROW_ED247_ERROR("Failed to add socket " << receiver->get_socket() << " to the readiness fd (" << ed247_get_system_error() << ")");
+      }
+    }
+  }
+  return _epoll_fd;
+#else
+  THROW_ED247_ERROR("The readiness fd is not supported on this platform");
+#endif
+}
+
+ed247_status_t ed247::udp::ReceiverSet::process_pending_frames()
+{
+  if (_select_options.nfds <= 0 && _transport == nullptr) return ED247_STATUS_NODATA;
+  ed247_status_t status = wait_frame(0);
+  return (status == ED247_STATUS_TIMEOUT) ? ED247_STATUS_NODATA : status;
+}
+
+void ed247::udp::ReceiverSet::submit_sends()
+{
+#ifdef ED247_IO_URING_ENABLED
+  if (_uring) _uring->submit();
+#endif
 }
 
 
@@ -428,6 +925,8 @@ ed247_status_t ed247::udp::ReceiverSet::wait_frame(int32_t timeout_us)
 {
   PRINT_CRAZY("UDP: Waiting for first frame to be received");
 
+  if (_transport) return _transport->wait_frame(timeout_us);
+
   if (_select_options.nfds <= 0) {
     PRINT_DEBUG("wait_frame: No socket opened in reading (no input messages in ECIC ?)");
     // Select will fail on Windows without errors. Simulate the wait for nothing.
@@ -435,6 +934,30 @@ ed247_status_t ed247::udp::ReceiverSet::wait_frame(int32_t timeout_us)
     return ED247_STATUS_TIMEOUT;
   };
 
+  if (_spin_budget_us != 0) {
+    // Busy poll: spin on all the receivers, then fall back to select() for the remaining timeout
+    uint64_t begin_us = get_monotonic_time_us();
+    uint64_t spin_us = (timeout_us >= 0 && (uint32_t)timeout_us < _spin_budget_us) ? timeout_us : _spin_budget_us;
+    uint64_t elapsed_us = 0;
+    do {
+      uint32_t frame_count = 0;
+      for(auto & receiver : _socket_receivers) {
+        frame_count += receiver->poll();
+      }
+      if (frame_count != 0) return ED247_STATUS_SUCCESS;
+      elapsed_us = get_monotonic_time_us() - begin_us;
+    } while(elapsed_us < spin_us);
+
+    if (timeout_us >= 0) {
+      if (elapsed_us >= (uint64_t)timeout_us) return ED247_STATUS_TIMEOUT;
+      timeout_us -= elapsed_us;
+    }
+  }
+
+#ifdef ED247_IO_URING_ENABLED
+  if (_uring) return _uring->wait_frame(timeout_us);
+#endif
+
   ed247_status_t  status = ED247_STATUS_TIMEOUT;
   struct ::timeval timeout;
   int select_status = 1;
@@ -452,7 +975,7 @@ ed247_status_t ed247::udp::ReceiverSet::wait_frame(int32_t timeout_us)
     if(select_status > 0){
       // Something received, call the associated receiver
       PRINT_CRAZY("Data received !");
-      for(auto & receiver : _receivers) {
+      for(auto & receiver : _socket_receivers) {
         const auto & socket = receiver->get_socket();
         if(socket != INVALID_SOCKET && FD_ISSET(socket, &select_fd)){
           receiver->receive();
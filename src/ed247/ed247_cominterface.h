@@ -27,12 +27,14 @@
 #include "ed247_xml.h"
 #include "ed247_friend_test.h"
 #include <functional>
+#include <atomic>
 
 // Networking
 #ifdef __unix__
 # include <sys/socket.h>
 # include <netinet/in.h>
 # include <sys/select.h>
+# include <sys/uio.h>
 using ed247_socket_t = int;
 # define INVALID_SOCKET (-1)
 #elif _WIN32
@@ -55,6 +57,18 @@ namespace ed247 {
       bool is_unicast() const;
       bool is_any_addr() const;
     };
+
+    struct socket_address_hash {
+      size_t operator()(const socket_address_t& socket_address) const {
+        return std::hash<uint32_t>()(socket_address.sin_addr.s_addr) ^ std::hash<uint16_t>()(socket_address.sin_port);
+      }
+    };
+
+    struct socket_address_equal_to {
+      bool operator()(const socket_address_t& a, const socket_address_t& b) const {
+        return a.sin_addr.s_addr == b.sin_addr.s_addr && a.sin_port == b.sin_port;
+      }
+    };
   }
 }
 std::ostream& operator<<(std::ostream & os, const ed247::udp::socket_address_t& socket_address);
@@ -64,12 +78,19 @@ std::ostream& operator<<(std::ostream & os, const ed247::udp::socket_address_t&
 namespace ed247 {
 
   class Context;
+  class Channel;
 
   namespace udp {
 
+#ifdef ED247_IO_URING_ENABLED
+    class UringEngine;
+#endif
+    class FrameTransport;
+
     //
     // Transceiver (aka ECIC UdpSocket)
     // Hold a system socket and prepare it for transceiving.
+    // There is no system socket (INVALID_SOCKET) if the context uses another transport than UDP.
     // base class for emitter and receiver.
     //
     class Transceiver {
@@ -81,8 +102,13 @@ namespace ed247 {
       Transceiver& operator=(const Transceiver&) = delete;
 
       const ed247_socket_t& get_socket() const { return _socket; }
+      const socket_address_t& get_socket_address() const { return _socket_address; }
 
     protected:
+      // Set a buffer size option of the system socket. The force option, if any, is tried first: it may exceed
+      // the system maximum if the process has the CAP_NET_ADMIN capability. Return false on failure.
+      bool set_socket_buffer_size(int option, int force_option, const char* option_name, uint32_t size);
+
       Context*         _context;
       socket_address_t _socket_address;           // Where the packets come from (regardless direction)
       ed247_socket_t   _socket{INVALID_SOCKET};   // Where the packets come from (regardless direction)
@@ -94,8 +120,17 @@ namespace ed247 {
       Emitter(Context* context, socket_address_t from_address, socket_address_t destination_address, uint16_t multicast_ttl = 1);
       void send_frame(const void* payload, const uint32_t payload_size);
 
+      const socket_address_t& get_destination_address() const { return _destination_address; }
+
+      // Set the SO_SNDBUF of the socket (SO_SNDBUFFORCE if permitted). Return false on failure.
+      bool set_send_buffer_size(uint32_t size);
+
+      // Number of failed send_frame(). May be updated by the asynchronous sender thread.
+      uint64_t get_send_error_count() const { return _send_error_count.load(std::memory_order_relaxed); }
+
     private:
-      socket_address_t _destination_address;
+      socket_address_t      _destination_address;
+      std::atomic<uint64_t> _send_error_count{0};
     };
 
     class Receiver : public Transceiver
@@ -110,15 +145,65 @@ namespace ed247 {
 
       using receive_callback_t = std::function<void(const char* payload, uint32_t size)>;
 
-      Receiver(Context*         context,
-               socket_address_t from_address,
-               socket_address_t multicast_interface,
-               receive_callback_t callback);
+      // Return true if the frame is for this receiver (see add_sibling())
+      using frame_filter_t = std::function<bool(const char* payload, uint32_t size)>;
+
+      Receiver(Context*           context,
+               socket_address_t   from_address,
+               socket_address_t   multicast_interface,
+               receive_callback_t callback,
+               frame_filter_t     frame_filter = nullptr,
+               Channel*           channel = nullptr);
       void receive();
 
+      // Receive the pending frames without blocking (busy poll mode).
+      // Return the number of received frames.
+      uint32_t poll();
+
+      // Enable the SO_BUSY_POLL option of the socket (Linux only). Return false on failure.
+      bool set_socket_busy_poll(uint32_t busy_poll_us);
+
+      // Notify the datagram to the context (see Context::notify_datagram_received()) and call the receive callback.
+      // Also used to deliver the frames received by another engine (see UringEngine).
+      void deliver_frame(const char* payload, uint32_t size);
+
+      // Receivers of the same ReceiverSet that listen the same address share the system socket: only the
+      // first one receives, and dispatches each frame to the receivers (itself included) whose frame filter
+      // accepts it. The siblings are not owned.
+      void add_sibling(Receiver* receiver) { _siblings.push_back(receiver); receiver->_dispatcher = this; }
+
+      // Enable the kernel receive timestamps of the socket (SO_TIMESTAMPNS, Linux only). Return false on failure.
+      bool set_socket_timestamps(bool enable);
+
+      // Set the SO_RCVBUF of the socket (SO_RCVBUFFORCE if permitted). Return false on failure.
+      bool set_receive_buffer_size(uint32_t size);
+
+      // Number of frames dropped by the kernel because the socket receive buffer was full (SO_RXQ_OVFL, Linux only).
+      // Updated by each received frame, except with the io_uring engine. Shared by the siblings: the kernel counts the
+      // drops per socket, so the ComInterface of each channel sharing this socket reports all of them.
+      uint64_t get_kernel_drop_count() const { return (_dispatcher ? _dispatcher : this)->_kernel_drop_count; }
+
     private:
-      receive_callback_t  _receive_callback;
-      frame_t&            _receive_frame;     // Reference to ReceiverSet::_receive_frame
+      // Receive a frame in _receive_frame. Same return value than recvfrom().
+      int receive_frame();
+
+      // Receive a frame and fill ReceiverSet::get_datagram_info(). Same return value than recvfrom().
+      int receive_datagram();
+
+#ifdef __linux__
+      // Read the SO_RXQ_OVFL ancillary data of a received message
+      void update_kernel_drop_count(const msghdr& header);
+#endif
+
+      void dispatch_frame(const char* payload, uint32_t size);
+
+      receive_callback_t     _receive_callback;
+      frame_filter_t         _frame_filter;
+      Channel*               _channel;           // Channel notified with the received datagrams
+      std::vector<Receiver*> _siblings;
+      Receiver*              _dispatcher{nullptr};   // Receiver that dispatches the frames to this sibling
+      uint32_t               _kernel_drop_count{0};
+      frame_t&               _receive_frame;     // Reference to ReceiverSet::_receive_frame
 
       ED247_FRIEND_TEST();
     };
@@ -137,7 +222,15 @@ namespace ed247 {
       ReceiverSet& operator=(const ReceiverSet &)  = delete;
       ReceiverSet& operator=(ReceiverSet &&)       = delete;
 
+      // Transport of the next created ReceiverSets. The environment variable has the priority.
+      static constexpr const char* ENV_VAR_TRANSPORT = "ED247_TRANSPORT";
+      static void set_default_transport(ed247_transport_t transport) { _default_transport = transport; }
+
+      // Transport used instead of the UDP sockets (nullptr for UDP)
+      FrameTransport* get_transport() { return _transport.get(); }
+
       // Add receiver and take onership
+      // A receiver of an address already listened becomes a sibling of the first one (see Receiver::add_sibling()).
       void emplace(Receiver* receiver);
 
       // Receive frames from all registered receivers.
@@ -145,13 +238,72 @@ namespace ed247 {
       ed247_status_t wait_frame(int32_t timeout_us);
       ed247_status_t wait_during(int32_t duration_us);
 
+      // Process the frames already received, without blocking.
+      // Return ED247_STATUS_NODATA if there was no frame.
+      ed247_status_t process_pending_frames();
+
+      // File descriptor readable when a frame is available on any receiver (Linux epoll).
+      // Created on first call. The readiness fd replaces the io_uring engine.
+      // Throw if not supported (including with another transport than UDP).
+      int get_readiness_fd();
+
+      // Busy poll mode: wait_frame() polls all the receivers without blocking during
+      // spin_budget_us before falling back to a blocking wait. 0 disables the mode.
+      // If socket_busy_poll_us is not 0, the SO_BUSY_POLL option of the sockets is set (Linux only).
+      // The busy poll mode replaces the io_uring engine. It is ignored with another transport than UDP.
+      void set_busy_poll(uint32_t spin_budget_us, uint32_t socket_busy_poll_us);
+
+#ifdef __linux__
+      // Buffers of recvmmsg() (busy poll mode)
+      struct receive_batch_t {
+        static const uint32_t SIZE{8};
+        struct control_t { char data[CMSG_SPACE(sizeof(uint32_t))]; };
+        std::vector<Receiver::frame_t> frames;
+        std::vector<iovec>             iovecs;
+        std::vector<control_t>         controls;   // SO_RXQ_OVFL
+        std::vector<mmsghdr>           headers;
+      };
+      receive_batch_t& get_receive_batch() { return _receive_batch; }
+#endif
+
+      // Datagram information: while enabled, the receivers fill the transport information of each
+      // received frame before calling their receive callback (see ed247_set_datagram_recv_callback()).
+      // The datagram information replaces the io_uring engine.
+      void set_datagram_info_enabled(bool enable);
+      bool is_datagram_info_enabled() const            { return _datagram_info_enabled; }
+      ed247_datagram_info_t& get_datagram_info()       { return _datagram_info;         }
+
+      // Submit the frames queued by ComInterface::send_frame() (io_uring engine only)
+      void submit_sends();
+
+#ifdef ED247_IO_URING_ENABLED
+      UringEngine* get_uring() { return _uring.get(); }
+#endif
+
       // Frame to be used by the receivers.
       // All receivers of the same set will share the same memory to prevent 65k alloc per receiver
       Receiver::frame_t& get_receive_frame() { return _receive_frame; }
 
     private:
+      void disable_uring(const char* reason);
+
+      static ed247_transport_t               _default_transport;
+
+      std::unique_ptr<FrameTransport>        _transport;
       std::vector<std::unique_ptr<Receiver>> _receivers;
+      std::vector<Receiver*>                 _socket_receivers;   // First receiver of each address
       Receiver::frame_t                      _receive_frame;
+      int                                    _epoll_fd{-1};
+      uint32_t                               _spin_budget_us{0};
+      uint32_t                               _socket_busy_poll_us{0};
+      bool                                   _datagram_info_enabled{false};
+      ed247_datagram_info_t                  _datagram_info{};
+#ifdef __linux__
+      receive_batch_t                        _receive_batch;
+#endif
+#ifdef ED247_IO_URING_ENABLED
+      std::unique_ptr<UringEngine>           _uring;
+#endif
 
       struct select_options_s {
         fd_set fd;
@@ -174,19 +326,36 @@ namespace ed247 {
       // Load configuration and
       // - store emmiters
       // - store receivers in context_receiver_set,
-      // - set receive_callback on each of them.
+      // - set receive_callback, frame_filter and channel on each of them.
       void load(const xml::ComInterface& configuration,
-                Receiver::receive_callback_t receive_callback);
+                Receiver::receive_callback_t receive_callback,
+                Receiver::frame_filter_t frame_filter = nullptr,
+                Channel* channel = nullptr);
 
       // Send a frame to all ComInterface emitters
+      // If the context asynchronous sender is enabled, the frame is queued and sent by its thread.
+      // If the io_uring engine is used, the frame is queued until ReceiverSet::submit_sends().
       void send_frame(const void* payload, const uint32_t payload_size);
 
+      // Send a frame to all ComInterface emitters from the calling thread
+      void send_frame_now(const void* payload, const uint32_t payload_size);
+
+      // Sum of the send errors of the emitters
+      uint64_t get_send_error_count() const;
+
+      // Set the socket buffer sizes of the receivers and of the emitters (0: unchanged). Return false on failure.
+      bool set_socket_buffer_sizes(uint32_t receive_buffer_size, uint32_t send_buffer_size);
+
+      // Sum of the kernel drops of the receivers (see Receiver::get_kernel_drop_count())
+      uint64_t get_kernel_drop_count() const;
+
       ComInterface(Context* context);
       ~ComInterface();
 
     private:
       Context*                              _context;
       std::vector<std::unique_ptr<Emitter>> _emitters;
+      std::vector<Receiver*>                _receivers;    // Owned by the context ReceiverSet
     };
 
 
@@ -26,6 +26,7 @@
 #include "ed247_client_list.h"
 #include "ed247_logs.h"
 #include "ed247_stream_assistant.h"
+#include <algorithm>
 
 //
 // Client lists (ed247.h interface)
@@ -67,21 +68,40 @@ namespace ed247 {
 // Context
 //
 
-ed247::Context* ed247::Context::create_from_filepath(std::string ecic_filepath)
+ed247::Context* ed247::Context::create_from_filepath(std::string ecic_filepath,
+                                                     const xml::Component::stream_filter_t& filter)
 {
   PRINT_DEBUG("ECIC filepath [" << ecic_filepath << "]");
-  Context* context = new Context(xml::load_filepath(ecic_filepath));
+  Context* context = new Context(xml::load_filepath(ecic_filepath), filter);
   return context;
 }
 
-ed247::Context* ed247::Context::create_from_content(std::string ecic_content)
+ed247::Context* ed247::Context::create_from_filepath_streaming(std::string ecic_filepath,
+                                                               const xml::Component::stream_filter_t& filter)
+{
+  PRINT_DEBUG("ECIC filepath [" << ecic_filepath << "] (streaming)");
+  Context* context = new Context(xml::load_filepath_streaming(ecic_filepath), filter);
+  return context;
+}
+
+ed247::Context* ed247::Context::create_from_content(std::string ecic_content,
+                                                    const xml::Component::stream_filter_t& filter)
 {
   PRINT_DEBUG("ECIC content [" << ecic_content << "]");
-  Context* context = new Context(xml::load_content(ecic_content));
+  Context* context = new Context(xml::load_content(ecic_content), filter);
+  return context;
+}
+
+ed247::Context* ed247::Context::create_from_compiled(std::string compiled_filepath,
+                                                     const xml::Component::stream_filter_t& filter)
+{
+  PRINT_DEBUG("Compiled ECIC filepath [" << compiled_filepath << "]");
+  Context* context = new Context(xml::load_compiled(compiled_filepath), filter);
   return context;
 }
 
-ed247::Context::Context(std::unique_ptr<ed247::xml::Component>&& configuration):
+ed247::Context::Context(std::unique_ptr<ed247::xml::Component>&& configuration,
+                        const xml::Component::stream_filter_t& filter):
   _configuration(std::move(configuration)),
   _stream_set(this),
   _channel_set(this),
@@ -89,9 +109,16 @@ ed247::Context::Context(std::unique_ptr<ed247::xml::Component>&& configuration):
   _client_streams_with_data(new ed247::ClientStreamListWithData(_stream_set.streams())),
   _client_channels(ed247::ClientChannelList::wrap(_channel_set.channels()))
 {
+  if (filter) _configuration->filter_streams(filter);
+
   for(const xml::Channel& channel_configuration: _configuration->_channel_list) {
     _channel_set.create(&channel_configuration);
   }
+
+  // The name indexes are complete: sort them once so that the finds do not modify them
+  _channel_set.sort_names();
+  _stream_set.sort_names();
+  _signal_set.sort_names();
 }
 
 bool ed247::Context::stream_assistants_written_push_samples(const ed247_timestamp_t* data_timestamp)
@@ -107,6 +134,8 @@ bool ed247::Context::stream_assistants_written_push_samples(const ed247_timestam
 bool ed247::Context::stream_assistants_pop_samples()
 {
   for(auto& stream : _stream_set.get_streams_signals_input()) {
+    // Only the newest sample will remain in the assistant: do not convert the others
+    stream->drop_old_samples();
     bool empty = false;
     while (empty == false) {
       if (stream->get_assistant()->pop(nullptr, nullptr, nullptr, &empty) == ED247_STATUS_FAILURE) {
@@ -117,12 +146,35 @@ bool ed247::Context::stream_assistants_pop_samples()
   return true;
 }
 
+void ed247::Context::set_conflation(bool enable)
+{
+  for(auto& stream : _stream_set.get_streams_signals_input()) {
+    stream->set_conflation(enable);
+  }
+}
+
+void ed247::Context::add_memory_footprint(ed247_memory_footprint_t& footprint)
+{
+  footprint.allocated_bytes += sizeof(udp::Receiver::frame_t);
+  footprint.max_bytes += sizeof(udp::Receiver::frame_t);
+  for(auto& channel : _channel_set.channels()) {
+    channel.second->add_memory_footprint(footprint);
+  }
+}
 
 void ed247::Context::send_pushed_samples()
 {
   for(auto& channel : _channel_set.channels()) {
     channel.second->encode_and_send();
   }
+  _receiver_set.submit_sends();
+}
+
+void ed247::Context::set_datagram_recv_callback(ed247_datagram_recv_callback_t callback, void* user_data)
+{
+  _receiver_set.set_datagram_info_enabled(callback != nullptr);
+  _datagram_recv_callback = callback;
+  _datagram_recv_user_data = user_data;
 }
 
 ed247_status_t ed247::Context::wait_frame(int32_t timeout_us)
@@ -134,3 +186,20 @@ ed247_status_t ed247::Context::wait_during(int32_t duration_us)
 {
   return _receiver_set.wait_during(duration_us);
 }
+
+void ed247::Context::enable_async_sender(uint32_t queue_frame_count, int32_t cpu_affinity)
+{
+  uint32_t frame_capacity = 0;
+  for(auto& channel : _channel_set.channels()) {
+    frame_capacity = std::max(frame_capacity, channel.second->get_frame_capacity());
+  }
+  // Flush the previous sender before replacing it
+  _async_sender.reset();
+  _async_sender.reset(new AsyncSender(queue_frame_count, frame_capacity, cpu_affinity));
+}
+
+ed247::Scheduler& ed247::Context::get_scheduler()
+{
+  if (!_scheduler) _scheduler.reset(new Scheduler(this));
+  return *_scheduler;
+}
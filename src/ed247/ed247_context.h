@@ -26,6 +26,8 @@
 #define _ED247_CONTEXT_H_
 #include "ed247_xml.h"
 #include "ed247_channel.h"
+#include "ed247_scheduler.h"
+#include "ed247_async_sender.h"
 
 // base structures for C API
 struct ed247_internal_context_t {};
@@ -36,8 +38,15 @@ namespace ed247
   class Context : public ed247_internal_context_t
   {
   public:
-    static Context* create_from_filepath(std::string ecic_filepath);
-    static Context* create_from_content(std::string ecic_content);
+    // If filter is set, only the accepted streams are instantiated (see xml::Component::filter_streams())
+    static Context* create_from_filepath(std::string ecic_filepath,
+                                         const xml::Component::stream_filter_t& filter = nullptr);
+    static Context* create_from_filepath_streaming(std::string ecic_filepath,
+                                                   const xml::Component::stream_filter_t& filter = nullptr);
+    static Context* create_from_content(std::string ecic_content,
+                                        const xml::Component::stream_filter_t& filter = nullptr);
+    static Context* create_from_compiled(std::string compiled_filepath,
+                                         const xml::Component::stream_filter_t& filter = nullptr);
 
     Context(const Context &)             = delete;
     Context(Context &&)                  = delete;
@@ -59,6 +68,9 @@ namespace ed247
     void set_user_data(void *user_data)  { _user_data = user_data;  }
     void get_user_data(void **user_data) { *user_data = _user_data; }
 
+    // Lazy allocation of the samples stacks, as set when the load started (see Stream::set_lazy_allocation())
+    bool is_lazy_allocation() const      { return _lazy_allocation; }
+
 
     // Content access
     udp::ReceiverSet& get_receiver_set() { return _receiver_set; }
@@ -83,18 +95,63 @@ namespace ed247
     // Return false only for fatal error (see stream::push_sample() for details)
     bool stream_assistants_pop_samples();
 
+    // Enable or disable the conflation of all input signal based streams (see Stream::set_conflation())
+    void set_conflation(bool enable);
+
     // Send all pushed streams in their respective channels/CommInterface
     void send_pushed_samples();
 
     // Receive frames and fill associated streams
     ed247_status_t wait_frame(int32_t timeout_us);
     ed247_status_t wait_during(int32_t duration_us);
+    ed247_status_t process_pending_frames() { return _receiver_set.process_pending_frames(); }
+
+    // Raw frame capture (see ed247_set_frame_recv_callback())
+    void set_frame_recv_callback(ed247_frame_recv_callback_t callback, void* user_data)
+    {
+      _frame_recv_callback = callback;
+      _frame_recv_user_data = user_data;
+    }
+    void notify_frame_received(Channel* channel, const char* frame, uint32_t frame_size)
+    {
+      if (_frame_recv_callback) _frame_recv_callback(this, channel, frame, frame_size, _frame_recv_user_data);
+    }
+
+    // Traffic recording: called once per received datagram, before the frame filters of the channels.
+    // channel is the first one that accepts the datagram, nullptr if none.
+    void notify_datagram_received(Channel* channel, const char* frame, uint32_t frame_size)
+    {
+      if (_datagram_recv_callback) {
+        _datagram_recv_callback(this, channel, &_receiver_set.get_datagram_info(), frame, frame_size, _datagram_recv_user_data);
+      }
+    }
+
+    // Traffic recording (see ed247_set_datagram_recv_callback())
+    // Enable the datagram information of the receivers while a callback is set.
+    void set_datagram_recv_callback(ed247_datagram_recv_callback_t callback, void* user_data);
+
+    // Cyclic scheduler of the output signal based streams. Created on first call.
+    Scheduler& get_scheduler();
+
+    // Asynchronous sender of the frames (see AsyncSender). Disabled by default.
+    // Disabling it flushes the queued frames.
+    void enable_async_sender(uint32_t queue_frame_count, int32_t cpu_affinity);
+    void disable_async_sender()            { _async_sender.reset();      }
+    AsyncSender* get_async_sender()        { return _async_sender.get(); }
+
+    // Add the receive frame and all the channels buffers to footprint
+    void add_memory_footprint(ed247_memory_footprint_t& footprint);
 
   private:
-    Context(std::unique_ptr<xml::Component>&& configuration);
+    Context(std::unique_ptr<xml::Component>&& configuration, const xml::Component::stream_filter_t& filter = nullptr);
 
     std::unique_ptr<xml::Component>  _configuration;
     void*                            _user_data;
+    const bool                       _lazy_allocation{Stream::get_lazy_allocation()};
+    ed247_frame_recv_callback_t      _frame_recv_callback{nullptr};
+    void*                            _frame_recv_user_data{nullptr};
+    ed247_datagram_recv_callback_t   _datagram_recv_callback{nullptr};
+    void*                            _datagram_recv_user_data{nullptr};
 
     udp::ReceiverSet                 _receiver_set;
     SignalSet                        _signal_set;
@@ -105,6 +162,11 @@ namespace ed247
     std::unique_ptr<ed247_internal_stream_list_t>  _client_streams_with_data;
     std::unique_ptr<ed247_internal_channel_list_t> _client_channels;
 
+    std::unique_ptr<Scheduler>       _scheduler;
+
+    // Declared after the channels: destroyed (thus flushed) before them
+    std::unique_ptr<AsyncSender>     _async_sender;
+
     ED247_FRIEND_TEST();
   };
 
@@ -0,0 +1,77 @@
+/* -*- mode: c++; c-basic-offset: 2 -*-  */
+//
+// Define name_index_t: a hash map indexed by C strings.
+// Allows to lookup an object by name without building a std::string.
+//
+// Define SortedNameIndex: objects sorted by name.
+// Allows to answer prefix queries by a range scan.
+//
+#ifndef _ED247_NAME_INDEX_H_
+#define _ED247_NAME_INDEX_H_
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+namespace ed247
+{
+  // FNV-1a of a null-terminated string
+  struct cstring_hash
+  {
+    size_t operator()(const char* str) const
+    {
+      uint64_t hash = 0xcbf29ce484222325ULL;
+      for (; *str != '\0'; str++) {
+        hash = (hash ^ (uint8_t)*str) * 0x100000001b3ULL;
+      }
+      return (size_t)hash;
+    }
+  };
+
+  struct cstring_equal
+  {
+    bool operator()(const char* lhs, const char* rhs) const { return strcmp(lhs, rhs) == 0; }
+  };
+
+  // Keys are not copied: they shall point to names that outlive the index (i.e. configuration names).
+  template<typename T>
+  using name_index_t = std::unordered_map<const char*, T, cstring_hash, cstring_equal>;
+
+  // Keys are not copied: they shall point to names that outlive the index (i.e. configuration names).
+  // sort() shall be called after the last insertion (i.e. at the end of the load): lookups do not
+  // modify the index, so they may run concurrently.
+  template<typename T>
+  class SortedNameIndex
+  {
+  public:
+    void insert(const char* name, const T& value)
+    {
+      _entries.emplace_back(name, value);
+    }
+
+    void sort()
+    {
+      std::sort(_entries.begin(), _entries.end(),
+                [](const entry_t& lhs, const entry_t& rhs) { return strcmp(lhs.first, rhs.first) < 0; });
+    }
+
+    // Call func(name, value) for each entry whose name starts with prefix, in name order.
+    template<typename Func>
+    void for_each_prefix(const std::string& prefix, Func func) const
+    {
+      auto iter = std::lower_bound(_entries.begin(), _entries.end(), prefix.c_str(),
+                                   [](const entry_t& entry, const char* name) { return strcmp(entry.first, name) < 0; });
+      for (; iter != _entries.end() && strncmp(iter->first, prefix.c_str(), prefix.size()) == 0; iter++) {
+        func(iter->first, iter->second);
+      }
+    }
+
+  private:
+    typedef std::pair<const char*, T> entry_t;
+    std::vector<entry_t> _entries;
+  };
+}
+
+#endif
@@ -0,0 +1,129 @@
+/* -*- mode: c++; c-basic-offset: 2 -*-  */
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include "ed247_name_pattern.h"
+#include <cctype>
+
+ed247::NamePattern::NamePattern(const std::string& regex)
+{
+  if (parse_glob(regex) == false) {
+    _kind = Kind::Regex;
+    _prefix.clear();
+    _glob.clear();
+    _regex = std::regex(regex);
+    return;
+  }
+
+  // Literal prefix
+  auto first_wildcard = _glob.begin();
+  while (first_wildcard != _glob.end() && *first_wildcard >= 0) {
+    _prefix += (char)*first_wildcard;
+    first_wildcard++;
+  }
+
+  if (first_wildcard == _glob.end()) {
+    _kind = Kind::Exact;
+  } else if (*first_wildcard == GLOB_STAR && first_wildcard + 1 == _glob.end()) {
+    _kind = Kind::Prefix;
+  } else {
+    _kind = Kind::Glob;
+  }
+}
+
+// Return false if regex contains other things than literals, '.' and '.*'
+bool ed247::NamePattern::parse_glob(const std::string& regex)
+{
+  for (size_t pos = 0; pos < regex.size(); pos++) {
+    char c = regex[pos];
+    switch (c) {
+    case '.':
+      if (pos + 1 < regex.size() && regex[pos + 1] == '*') {
+        // Consecutive stars are equivalent to a single one
+        if (_glob.empty() || _glob.back() != GLOB_STAR) _glob.push_back(GLOB_STAR);
+        pos++;
+      } else {
+        _glob.push_back(GLOB_ANY);
+      }
+      break;
+
+    case '\\':
+      // Only escaped punctuations are literals (\d, \w, \b... are classes or assertions)
+      if (pos + 1 >= regex.size() || isalnum((unsigned char)regex[pos + 1])) return false;
+      _glob.push_back((unsigned char)regex[++pos]);
+      break;
+
+    case '[': case ']': case '{': case '}': case '(': case ')':
+    case '*': case '+': case '?': case '^': case '$': case '|':
+      return false;
+
+    default:
+      _glob.push_back((unsigned char)c);
+    }
+  }
+  return true;
+}
+
+bool ed247::NamePattern::match(const char* name) const
+{
+  switch (_kind) {
+  case Kind::Exact:
+    return strcmp(name, _prefix.c_str()) == 0;
+  case Kind::Prefix:
+    return strncmp(name, _prefix.c_str(), _prefix.size()) == 0;
+  case Kind::Glob:
+    return match_glob(name);
+  default:
+    return std::regex_match(name, _regex);
+  }
+}
+
+// Wildcard matching with a single backtracking point (the last star)
+bool ed247::NamePattern::match_glob(const char* name) const
+{
+  size_t glob_pos = 0;
+  size_t star_glob_pos = std::string::npos;
+  const char* star_name = nullptr;
+
+  while (*name != '\0') {
+    if (glob_pos < _glob.size() && _glob[glob_pos] == GLOB_STAR) {
+      star_glob_pos = ++glob_pos;
+      star_name = name;
+    }
+    else if (glob_pos < _glob.size() && (_glob[glob_pos] == GLOB_ANY || _glob[glob_pos] == (unsigned char)*name)) {
+      glob_pos++;
+      name++;
+    }
+    else if (star_glob_pos != std::string::npos) {
+      // Let the last star consume one more character
+      glob_pos = star_glob_pos;
+      name = ++star_name;
+    }
+    else {
+      return false;
+    }
+  }
+
+  while (glob_pos < _glob.size() && _glob[glob_pos] == GLOB_STAR) glob_pos++;
+  return glob_pos == _glob.size();
+}
@@ -0,0 +1,90 @@
+/* -*- mode: c++; c-basic-offset: 2 -*-  */
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef _ED247_NAME_PATTERN_H_
+#define _ED247_NAME_PATTERN_H_
+#include "ed247.h"
+#include "ed247_name_index.h"
+#include <regex>
+#include <string>
+#include <vector>
+
+// base structure for C API
+struct ed247_internal_name_pattern_t {};
+
+namespace ed247
+{
+  //
+  // Precompiled find_*() pattern.
+  // The pattern is a regular expression matching whole names (same as std::regex_match).
+  // Most patterns used to find ECIC elements are made of literals, '.' and '.*'. They are
+  // matched without std::regex:
+  // - Exact:  "Stream1"           -> string comparison
+  // - Prefix: "Stream.*"          -> prefix comparison (range scan in a SortedNameIndex)
+  // - Glob:   "Stream.*_IN", "A.B" -> wildcard matching
+  // Other patterns are compiled once in a std::regex.
+  //
+  class NamePattern : public ed247_internal_name_pattern_t
+  {
+  public:
+    enum class Kind { Exact, Prefix, Glob, Regex };
+
+    // Throw if regex is invalid
+    explicit NamePattern(const std::string& regex);
+
+    Kind kind() const                          { return _kind;   }
+
+    // All matching names start with this literal. For Exact patterns, this is the whole name.
+    const std::string& literal_prefix() const  { return _prefix; }
+
+    bool match(const char* name) const;
+    bool match(const std::string& name) const  { return match(name.c_str()); }
+
+    // Append to founds the values of index whose name match
+    template<typename T>
+    void select(const SortedNameIndex<T>& index, std::vector<T>& founds) const
+    {
+      index.for_each_prefix(_prefix, [this, &founds](const char* name, const T& value) {
+          if (_kind == Kind::Prefix || match(name)) founds.push_back(value);
+        });
+    }
+
+  private:
+    // Glob tokens: a character or one of these values
+    enum : int {
+      GLOB_ANY  = -1,     // '.'
+      GLOB_STAR = -2      // '.*'
+    };
+
+    Kind             _kind;
+    std::string      _prefix;
+    std::vector<int> _glob;
+    std::regex       _regex;
+
+    bool parse_glob(const std::string& regex);
+    bool match_glob(const char* name) const;
+  };
+}
+
+#endif
@@ -81,16 +81,13 @@ bool ed247::StreamSample::copy(const StreamSample & sample)
 //
 
 ed247::StreamSampleRingBuffer::StreamSampleRingBuffer(uint32_t capacity, uint32_t samples_capacity) :
+  _capacity(capacity),
   _samples_capacity(samples_capacity),
   _index_read(0),
   _index_write(0),
   _index_size(0)
 {
   MEMCHECK_NEW(this, "StreamSampleRingBuffer");
-  _samples.reserve(capacity);
-  for (uint32_t i = 0; i < capacity; i++) {
-    _samples.emplace_back(StreamSample(samples_capacity));
-  }
 }
 
 ed247::StreamSampleRingBuffer::~StreamSampleRingBuffer()
@@ -99,12 +96,22 @@ ed247::StreamSampleRingBuffer::~StreamSampleRingBuffer()
 }
 
 
+void ed247::StreamSampleRingBuffer::allocate()
+{
+  if (allocated() || _capacity == 0) return;
+  _samples.reserve(_capacity);
+  for (uint32_t i = 0; i < _capacity; i++) {
+    _samples.emplace_back(StreamSample(_samples_capacity));
+  }
+}
+
 ed247::StreamSample& ed247::StreamSampleRingBuffer::push_back()
 {
+  allocate();
   uint32_t index_current = _index_write;
-  _index_write = (_index_write + 1) % _samples.size();
-  if (_index_size >= _samples.size()) {
-    _index_read = (_index_read + 1) % _samples.size();
+  _index_write = (_index_write + 1) % _capacity;
+  if (_index_size >= _capacity) {
+    _index_read = (_index_read + 1) % _capacity;
   } else {
     _index_size++;
   }
@@ -113,12 +120,21 @@ ed247::StreamSample& ed247::StreamSampleRingBuffer::push_back()
 
 ed247::StreamSample& ed247::StreamSampleRingBuffer::pop_front()
 {
+  allocate();
   if (_index_size == 0) {
     return _samples[_index_read];
   } else {
     uint32_t index_current = _index_read;
-    _index_read = (_index_read+1) % _samples.size();
+    _index_read = (_index_read+1) % _capacity;
     _index_size--;
     return _samples[index_current];
   }
 }
+
+void ed247::StreamSampleRingBuffer::drop_front(uint32_t count)
+{
+  if (count > _index_size) count = _index_size;
+  if (count == 0) return;
+  _index_read = (_index_read + count) % _capacity;
+  _index_size -= count;
+}
@@ -103,17 +103,26 @@ namespace ed247
 
   //
   // preallocated ring buffer
+  // Memory is allocated either by allocate() or on first access.
   //
   class StreamSampleRingBuffer {
   public:
     StreamSampleRingBuffer(uint32_t capacity, uint32_t samples_capacity);
     ~StreamSampleRingBuffer();
 
-    uint32_t capacity() const         { return _samples.size();                }
+    // Allocate all the samples. Do nothing if already allocated.
+    void allocate();
+    bool allocated() const            { return _samples.empty() == false;      }
+
+    uint32_t capacity() const         { return _capacity;                      }
     uint32_t samples_capacity() const { return _samples_capacity;              }
     uint32_t size() const             { return _index_size;                    }
     bool empty() const                { return _index_size == 0;               }
-    bool full() const                 { return _index_size >= _samples.size(); }
+    bool full() const                 { return _index_size >= _capacity;       }
+
+    // Memory footprint of the sample payloads, currently allocated and once allocated
+    uint64_t allocated_bytes() const  { return allocated() ? max_bytes() : 0;  }
+    uint64_t max_bytes() const        { return (uint64_t)_capacity * _samples_capacity; }
 
     // "push" a new sample.
     // If ring buffer is full, override the oldest sample.
@@ -125,26 +134,33 @@ namespace ed247
     // if ring buffer is empty, return an arbitrary sample. (i.e. call empty() before)
     StreamSample& pop_front();
 
+    // Remove the count oldest samples (at most size())
+    void drop_front(uint32_t count);
+    void clear()                      { drop_front(_index_size);               }
+
     // Return the oldest sample without removing it.
     // if ring buffer is empty, return an arbitrary sample. (i.e. call empty() before)
-    StreamSample& front() { return _samples[_index_read]; }
+    StreamSample& front() { allocate(); return _samples[_index_read]; }
 
     // Return the last pushed sample
     // if ring buffer is empty, return an arbitrary sample. (i.e. call empty() before)
     StreamSample& back()
     {
-      return _samples[_index_write == 0 ? (_samples.size()-1) : (_index_write-1)];
+      allocate();
+      return _samples[_index_write == 0 ? (_capacity-1) : (_index_write-1)];
     }
 
     // Return the oldest + index sample
     // index is not checked. May have undefined behavior.
     StreamSample& at(uint32_t index)
     {
-      return _samples[(_index_read + index) % _samples.size()];
+      allocate();
+      return _samples[(_index_read + index) % _capacity];
     }
 
   private:
     std::vector<StreamSample>  _samples;
+    uint32_t                   _capacity;
     uint32_t                   _samples_capacity;
     uint32_t                   _index_read;
     uint32_t                   _index_write;
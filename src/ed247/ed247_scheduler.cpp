@@ -0,0 +1,148 @@
+/* -*- mode: c++; c-basic-offset: 2 -*-  */
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include "ed247_scheduler.h"
+#include "ed247_context.h"
+#include "ed247_stream_assistant.h"
+#include "ed247_time.h"
+#include "ed247_logs.h"
+#include <algorithm>
+#include <limits>
+
+ed247::Scheduler::Scheduler(Context* context) :
+  _context(context),
+  _started(false)
+{
+  MEMCHECK_NEW(this, "Scheduler");
+
+  for (auto& stream : _context->get_stream_set().get_streams_signals_output()) {
+    uint32_t period_us = stream->get_sampling_period_us();
+    if (period_us == 0) continue;
+
+    auto group = std::find_if(_groups.begin(), _groups.end(), [period_us](const group_t& g) { return g.period_us == period_us; });
+    if (group == _groups.end()) {
+      _groups.push_back(group_t{ period_us, 0, 0, {}, {}, 0 });
+      group = _groups.end() - 1;
+    }
+    group->streams.push_back(stream.get());
+
+    Channel* channel = static_cast<Channel*>(stream->get_api_channel());
+    if (std::find(group->channels.begin(), group->channels.end(), channel) == group->channels.end()) {
+      group->channels.push_back(channel);
+    }
+  }
+
+  // Spread the first deadlines of the groups over the shortest period
+  std::sort(_groups.begin(), _groups.end(), [](const group_t& a, const group_t& b) { return a.period_us < b.period_us; });
+  for (uint32_t index = 0; index < _groups.size(); index++) {
+    _groups[index].phase_us = (uint64_t)_groups.front().period_us * index / _groups.size();
+    PRINT_DEBUG("Scheduler: group of " << _groups[index].streams.size() << " streams every " << _groups[index].period_us
+                << "us (phase " << _groups[index].phase_us << "us)");
+  }
+
+  reset();
+}
+
+ed247::Scheduler::~Scheduler()
+{
+  MEMCHECK_DEL(this, "Scheduler");
+}
+
+void ed247::Scheduler::reset()
+{
+  _started = false;
+  _stats.clear();
+  for (group_t& group : _groups) {
+    group.jitter_sum_us = 0;
+    ed247_scheduler_stats_t stats;
+    stats.period_us = group.period_us;
+    stats.stream_count = group.streams.size();
+    stats.cycle_count = 0;
+    stats.missed_count = 0;
+    stats.jitter_min_us = 0;
+    stats.jitter_max_us = 0;
+    stats.jitter_mean_us = 0;
+    _stats.push_back(stats);
+  }
+}
+
+ed247_status_t ed247::Scheduler::run(int32_t duration_us)
+{
+  uint64_t now_us = get_monotonic_time_us();
+  uint64_t end_us = now_us + (duration_us > 0 ? duration_us : 0);
+
+  if (_started == false) {
+    for (group_t& group : _groups) group.deadline_us = now_us + group.phase_us;
+    _started = true;
+  }
+
+  while (true) {
+    // Earliest deadline
+    uint32_t next = 0;
+    for (uint32_t index = 1; index < _groups.size(); index++) {
+      if (_groups[index].deadline_us < _groups[next].deadline_us) next = index;
+    }
+    uint64_t wake_up_us = (_groups.empty() || _groups[next].deadline_us > end_us) ? end_us : _groups[next].deadline_us;
+
+    if (wake_up_us > now_us) {
+      if (_context->wait_during(wake_up_us - now_us) == ED247_STATUS_FAILURE) return ED247_STATUS_FAILURE;
+      now_us = get_monotonic_time_us();
+    }
+
+    if (_groups.empty() || _groups[next].deadline_us > end_us) break;
+    if (serve(_groups[next], _stats[next], now_us) == false) return ED247_STATUS_FAILURE;
+  }
+
+  return ED247_STATUS_SUCCESS;
+}
+
+bool ed247::Scheduler::serve(group_t& group, ed247_scheduler_stats_t& stats, uint64_t now_us)
+{
+  uint64_t jitter_us = (now_us > group.deadline_us) ? now_us - group.deadline_us : 0;
+  if (jitter_us > std::numeric_limits<uint32_t>::max()) jitter_us = std::numeric_limits<uint32_t>::max();
+
+  for (Stream* stream : group.streams) {
+    if (stream->get_assistant()->push_if_was_written(nullptr, nullptr) == false) return false;
+  }
+  for (Channel* channel : group.channels) {
+    channel->encode_and_send();
+  }
+  _context->get_receiver_set().submit_sends();
+
+  stats.cycle_count++;
+  group.jitter_sum_us += jitter_us;
+  stats.jitter_min_us = (stats.cycle_count == 1) ? (uint32_t)jitter_us : std::min(stats.jitter_min_us, (uint32_t)jitter_us);
+  stats.jitter_max_us = std::max(stats.jitter_max_us, (uint32_t)jitter_us);
+  stats.jitter_mean_us = (uint32_t)(group.jitter_sum_us / stats.cycle_count);
+
+  // Absolute deadlines: the delay of this cycle does not shift the next ones.
+  // The deadlines missed by more than a period are skipped.
+  group.deadline_us += group.period_us;
+  if (group.deadline_us < now_us) {
+    uint64_t missed = (now_us - group.deadline_us) / group.period_us + 1;
+    stats.missed_count += missed;
+    group.deadline_us += missed * group.period_us;
+  }
+  return true;
+}
@@ -0,0 +1,80 @@
+/* -*- mode: c++; c-basic-offset: 2 -*-  */
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef _ED247_SCHEDULER_H_
+#define _ED247_SCHEDULER_H_
+#include "ed247.h"
+#include "ed247_stream.h"
+#include <vector>
+
+namespace ed247
+{
+  class Context;
+  class Channel;
+
+  //
+  // Cyclic scheduler of the output signal based streams.
+  // Streams are grouped by sampling period. On each deadline of a group, the written
+  // assistants of the group are pushed and the channels of the group are sent.
+  // Deadlines are absolute (next = previous + period): wake-up delays do not accumulate.
+  // Groups are phase shifted so the groups of different periods do not send at the same time.
+  //
+  class Scheduler
+  {
+  public:
+    Scheduler(Context* context);
+    ~Scheduler();
+
+    Scheduler(const Scheduler &)             = delete;
+    Scheduler& operator=(const Scheduler &)  = delete;
+
+    // Serve the deadlines elapsing during duration_us.
+    // Received frames are processed while waiting (see Context::wait_during()).
+    ed247_status_t run(int32_t duration_us);
+
+    // Deadlines restart on next run() and statistics are cleared
+    void reset();
+
+    const std::vector<ed247_scheduler_stats_t>& get_stats() const { return _stats; }
+
+  private:
+    struct group_t {
+      uint32_t              period_us;
+      uint64_t              phase_us;       // Offset of the first deadline
+      uint64_t              deadline_us;    // Next deadline (monotonic time)
+      std::vector<Stream*>  streams;
+      std::vector<Channel*> channels;
+      uint64_t              jitter_sum_us;
+    };
+
+    bool serve(group_t& group, ed247_scheduler_stats_t& stats, uint64_t now_us);
+
+    Context*                             _context;
+    std::vector<group_t>                 _groups;
+    std::vector<ed247_scheduler_stats_t> _stats;       // Same index than _groups
+    bool                                 _started;
+  };
+}
+
+#endif
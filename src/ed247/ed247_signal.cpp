@@ -23,13 +23,26 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  *****************************************************************************/
 #include "ed247_signal.h"
+#include "ed247_swap_copy.h"
 #include "ed247_logs.h"
-#include <regex>
+
+ed247::Signal::swap_copy_t ed247::get_swap_copy(ed247_nad_type_t nad_type)
+{
+  switch (xml::Signal::get_nad_type_size(nad_type)) {
+  case 1: return &swap_copy<1>;
+  case 2: return &swap_copy<2>;
+  case 4: return &swap_copy<4>;
+  case 8: return &swap_copy<8>;
+  default:
+    THROW_ED247_ERROR("Unexpected NAD type: " << nad_type);
+  }
+}
 
 ed247::Signal::Signal(const xml::Signal* configuration, ed247_internal_stream_t* ed247_api_stream) :
   _configuration(configuration),
   _ed247_api_stream(ed247_api_stream),
-  _user_data(nullptr)
+  _user_data(nullptr),
+  _swap_copy(ed247::get_swap_copy(configuration->_nad_type))
 {
   MEMCHECK_NEW(this, "Signal " << _configuration->_name);
 }
@@ -55,6 +68,7 @@ ed247::signal_ptr_t ed247::SignalSet::create(const xml::Signal* configuration, e
                                                 signal_ptr_t(new Signal(configuration, ed247_api_stream))));
 
   if (result.second == false) THROW_ED247_ERROR("Signal [" << configuration->_name << "] already exist !");
+  _sorted_signals.insert(result.first->first.c_str(), result.first->second);
 
   return result.first->second;
 }
@@ -66,15 +80,10 @@ ed247::signal_ptr_t ed247::SignalSet::get(const std::string& name)
   return nullptr;
 }
 
-ed247::signal_list_t ed247::SignalSet::find(const std::string& str_regex)
+ed247::signal_list_t ed247::SignalSet::find(const NamePattern& pattern) const
 {
-  std::regex reg(str_regex);
   signal_list_t founds;
-  for(auto& signal_pair : _signals) {
-    if(std::regex_match(signal_pair.first, reg)) {
-      founds.push_back(signal_pair.second);
-    }
-  }
+  pattern.select(_sorted_signals, founds);
   return founds;
 }
 
@@ -27,6 +27,7 @@
 #include "ed247.h"
 #include "ed247_xml.h"
 #include "ed247_friend_test.h"
+#include "ed247_name_pattern.h"
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -66,9 +67,14 @@ namespace ed247
     uint32_t get_vnad_max_number() const                     { return _configuration->_vnad_max_number;             }
     uint32_t get_sample_max_size_bytes() const               { return _configuration->get_sample_max_size_bytes();  }
 
+    // Copy a payload of values of the signal NAD type, swapping their byte order.
+    // The swap width is resolved once, at signal creation (see ed247_swap_copy.h).
+    typedef void (*swap_copy_t)(const char* source_data, char* dest_data, uint32_t size);
+    swap_copy_t get_swap_copy() const                        { return _swap_copy;                                   }
+
 
     // implementation of ed247_signal_get_stream()
-    ed247_internal_stream_t* get_api_stream() { return _ed247_api_stream; }
+    ed247_internal_stream_t* get_api_stream() const { return _ed247_api_stream; }
 
     // Handle user-data
     void set_user_data(void *user_data)  { _user_data = user_data;  }
@@ -79,6 +85,7 @@ namespace ed247
     const xml::Signal*       _configuration;
     ed247_internal_stream_t* _ed247_api_stream;  // Needed for API method ed247_signal_get_stream()
     void*                    _user_data;
+    swap_copy_t              _swap_copy;
   };
 
 
@@ -91,7 +98,11 @@ namespace ed247
   public:
     signal_ptr_t create(const xml::Signal* configuration, ed247_internal_stream_t* ed247_api_stream);
     signal_ptr_t get(const std::string& name);
-    signal_list_t find(const std::string& regex);
+    signal_list_t find(const std::string& regex) const { return find(NamePattern(regex)); }
+    signal_list_t find(const NamePattern& pattern) const;
+
+    // Sort the name index once all the signals are created
+    void sort_names() { _sorted_signals.sort(); }
 
     SignalSet();
     ~SignalSet();
@@ -102,6 +113,7 @@ namespace ed247
   protected:
     ED247_FRIEND_TEST();
     std::unordered_map<std::string, signal_ptr_t> _signals;
+    SortedNameIndex<signal_ptr_t>                 _sorted_signals;
   };
 }
 
@@ -0,0 +1,116 @@
+/* -*- mode: c++; c-basic-offset: 2 -*-  */
+/******************************************************************************
+ *
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+//
+// Typed signal accessors (C++ only, header only)
+//
+// SignalAccessor<NAD_TYPE>: read/write native values of a signal directly in
+// the stream assistant buffer. The signal location is resolved once, when the
+// accessor is bound (see ed247_stream_assistant_bind_signal()), so there is no
+// runtime type dispatch.
+//
+#ifndef _ED247_SIGNAL_ACCESSOR_H_
+#define _ED247_SIGNAL_ACCESSOR_H_
+#include "ed247.h"
+#include <cstring>
+
+namespace ed247
+{
+  //
+  // NAD type -> C++ type
+  //
+  template<ed247_nad_type_t NAD_TYPE> struct nad_type_traits;
+  template<> struct nad_type_traits<ED247_NAD_TYPE_INT8>    { typedef int8_t   value_t; typedef uint8_t  word_t; };
+  template<> struct nad_type_traits<ED247_NAD_TYPE_INT16>   { typedef int16_t  value_t; typedef uint16_t word_t; };
+  template<> struct nad_type_traits<ED247_NAD_TYPE_INT32>   { typedef int32_t  value_t; typedef uint32_t word_t; };
+  template<> struct nad_type_traits<ED247_NAD_TYPE_INT64>   { typedef int64_t  value_t; typedef uint64_t word_t; };
+  template<> struct nad_type_traits<ED247_NAD_TYPE_UINT8>   { typedef uint8_t  value_t; typedef uint8_t  word_t; };
+  template<> struct nad_type_traits<ED247_NAD_TYPE_UINT16>  { typedef uint16_t value_t; typedef uint16_t word_t; };
+  template<> struct nad_type_traits<ED247_NAD_TYPE_UINT32>  { typedef uint32_t value_t; typedef uint32_t word_t; };
+  template<> struct nad_type_traits<ED247_NAD_TYPE_UINT64>  { typedef uint64_t value_t; typedef uint64_t word_t; };
+  template<> struct nad_type_traits<ED247_NAD_TYPE_FLOAT32> { typedef float    value_t; typedef uint32_t word_t; };
+  template<> struct nad_type_traits<ED247_NAD_TYPE_FLOAT64> { typedef double   value_t; typedef uint64_t word_t; };
+
+  //
+  // Typed accessor of a signal of a fixed size stream (DISCRETE, ANALOGUE or NAD).
+  // The signal type shall be NAD_TYPE: ANALOGUE signals are FLOAT32 and DISCRETE ones are UINT8.
+  // Like ed247_stream_assistant_write_signal(), write() stores the value in network byte order in the assistant buffer.
+  // Like ed247_stream_assistant_read_signal(), read() returns the value of the last popped sample.
+  //
+  template<ed247_nad_type_t NAD_TYPE>
+  class SignalAccessor
+  {
+  public:
+    typedef typename nad_type_traits<NAD_TYPE>::value_t value_t;
+    typedef typename nad_type_traits<NAD_TYPE>::word_t  word_t;
+
+    SignalAccessor() : _binding() {}
+    SignalAccessor(ed247_stream_assistant_t assistant, ed247_signal_t signal) : SignalAccessor() { bind(assistant, signal); }
+
+    // Return false if the signal type is not NAD_TYPE or if the signal is not part of the assistant stream
+    bool bind(ed247_stream_assistant_t assistant, ed247_signal_t signal)
+    {
+      if (ed247_stream_assistant_bind_signal(assistant, signal, NAD_TYPE, &_binding) != ED247_STATUS_SUCCESS) {
+        _binding = ed247_signal_binding_t();
+        return false;
+      }
+      return true;
+    }
+
+    bool is_bound() const       { return _binding.data != nullptr; }
+
+    // Number of elements of the signal (1 for scalars). No bound checking is done by index accessors.
+    uint32_t get_count() const  { return _binding.size / sizeof(value_t); }
+
+    void write(value_t value)   { write(0, value); }
+    value_t read() const        { return read(0);  }
+
+    void write(uint32_t index, value_t value)
+    {
+      word_t word;
+      memcpy(&word, &value, sizeof(value_t));
+      char* data = (char*)_binding.data + index * sizeof(value_t);
+      for (uint32_t byte = 0; byte < sizeof(value_t); byte++) {
+        data[byte] = (char)(word >> (8 * (sizeof(value_t) - 1 - byte)));
+      }
+      *_binding.was_written = true;
+    }
+
+    value_t read(uint32_t index) const
+    {
+      value_t value;
+      memcpy(&value, (const char*)_binding.data + index * sizeof(value_t), sizeof(value_t));
+      return value;
+    }
+
+  private:
+    ed247_signal_binding_t _binding;
+  };
+
+  typedef SignalAccessor<ED247_NAD_TYPE_FLOAT32> AnalogueAccessor;
+  typedef SignalAccessor<ED247_NAD_TYPE_UINT8>   DiscreteAccessor;
+}
+
+#endif
@@ -28,7 +28,6 @@
 #include "ed247_client_list.h"
 #include "ed247_bswap.h"
 #include "ed247_logs.h"
-#include <regex>
 
 
 static const uint32_t SECOND_TO_NANO = 1000 * 1000 * 1000;
@@ -54,6 +53,8 @@ namespace ed247 {
 //
 // Stream initialization
 //
+std::atomic<bool> ed247::Stream::_lazy_allocation{false};
+
 ed247::Stream::Stream(Context* context, const ed247::xml::Stream* configuration, ed247_internal_channel_t* ed247_api_channel, uint32_t sample_size_size):
   _context(context),
   _configuration(configuration),
@@ -61,6 +62,7 @@ ed247::Stream::Stream(Context* context, const ed247::xml::Stream* configuration,
   _client_signals(ed247::ClientSignalList::wrap(_signals)),
   _recv_stack(_configuration->_sample_max_number, _configuration->_sample_max_size_bytes),
   _send_stack(_configuration->_sample_max_number, _configuration->_sample_max_size_bytes),
+  _conflation(false),
   _ed247_api_channel(ed247_api_channel),
   _user_data(NULL)
 {
@@ -76,6 +78,12 @@ ed247::Stream::Stream(Context* context, const ed247::xml::Stream* configuration,
 
   _max_size = _configuration->_sample_max_size_bytes + _sample_first_header_size;
   _max_size += (_configuration->_sample_max_number - 1) * (_configuration->_sample_max_size_bytes + _sample_next_header_size);
+
+  // Only the stacks used by the stream direction are preallocated
+  if (_context->is_lazy_allocation() == false) {
+    if (_configuration->_direction & ED247_DIRECTION_IN) _recv_stack.allocate();
+    if (_configuration->_direction & ED247_DIRECTION_OUT) _send_stack.allocate();
+  }
 }
 
 ed247::Stream::~Stream()
@@ -83,6 +91,13 @@ ed247::Stream::~Stream()
   MEMCHECK_DEL(this, "Stream " << _configuration->_name);
 }
 
+void ed247::Stream::add_memory_footprint(ed247_memory_footprint_t& footprint) const
+{
+  footprint.allocated_bytes += _recv_stack.allocated_bytes() + _send_stack.allocated_bytes();
+  footprint.max_bytes += _recv_stack.max_bytes() + _send_stack.max_bytes();
+  if (_assistant) _assistant->add_memory_footprint(footprint);
+}
+
 //
 // Stream Signals part
 //
@@ -95,6 +110,7 @@ ed247::StreamSignals::StreamSignals(Context* context, const xml::Stream* configu
   for(auto& signal_configuration : sconfiguration->_signal_list) {
     signal_ptr_t signal = _context->get_signal_set().create(signal_configuration.get(), this);
     _signals.push_back(signal);
+    _signals_by_name.emplace(signal->get_name().c_str(), signal);
   }
   if (get_type() == ED247_STREAM_TYPE_VNAD) {
     _assistant = std::unique_ptr<StreamAssistant>(new VNADStreamAssistant(this));
@@ -103,23 +119,26 @@ ed247::StreamSignals::StreamSignals(Context* context, const xml::Stream* configu
   }
 }
 
-ed247::signal_list_t ed247::Stream::Stream::find_signals(std::string str_regex)
+ed247::signal_list_t ed247::Stream::Stream::find_signals(const NamePattern& pattern)
 {
-  std::regex reg(str_regex);
   signal_list_t founds;
+  if (pattern.kind() == NamePattern::Kind::Exact) {
+    signal_ptr_t signal = get_signal(pattern.literal_prefix());
+    if (signal) founds.push_back(signal);
+    return founds;
+  }
   for(auto signal: _signals){
-    if(std::regex_match(signal->get_name(), reg)){
+    if(pattern.match(signal->get_name())){
       founds.push_back(signal);
     }
   }
   return founds;
 }
 
-ed247::signal_ptr_t ed247::Stream::Stream::get_signal(std::string str_name)
+ed247::signal_ptr_t ed247::Stream::Stream::get_signal(const char* name)
 {
-  for(auto signal : _signals){
-    if(signal->get_name() == str_name) return signal;
-  }
+  auto iter = _signals_by_name.find(name);
+  if (iter != _signals_by_name.end()) return iter->second;
   return nullptr;
 }
 
@@ -151,6 +170,17 @@ ed247::StreamSample& ed247::Stream::pop_sample(bool* empty)
   return result;
 }
 
+bool ed247::Stream::set_conflation(bool enable)
+{
+  if (enable && is_signal_based() == false) {
+    PRINT_ERROR("Stream '" << get_name() << "': Only signal based streams can be conflated");
+    return false;
+  }
+  _conflation = enable;
+  if (_conflation) drop_old_samples();
+  return true;
+}
+
 
 //
 // Encode stream to frame
@@ -229,9 +259,35 @@ uint32_t ed247::Stream::encode(char* frame, uint32_t frame_size)
 //
 bool ed247::Stream::decode(const char* frame, uint32_t frame_size, const ed247_sample_details_t& frame_details)
 {
+  // Samples of a non-input stream cannot be popped: do not store (nor allocate) them,
+  // but still notify the registered callbacks of the received frame
+  if ((_configuration->_direction & ED247_DIRECTION_IN) == 0) return run_callbacks();
+
   uint32_t frame_index = 0;
   ed247_timestamp_t first_sample_dts = { 0, 0 };
 
+  auto store_sample = [&](const char* sample_data, uint32_t sample_size, const ed247_timestamp_t& sample_dts) {
+    StreamSample& sample = _recv_stack.push_back();
+    sample.set_data_timestamp(sample_dts);
+    sample.update_recv_timestamp();
+    sample.copy(sample_data, sample_size);
+    sample.set_frame_details(frame_details);
+  };
+
+  // Conflation: newest valid sample of the frame. Stored once the frame is decoded, or on error.
+  const char* conflated_data = nullptr;
+  uint32_t conflated_size = 0;
+  ed247_timestamp_t conflated_dts = { 0, 0 };
+  auto store_conflated_sample = [&]() {
+    if (conflated_data == nullptr) return;
+    _recv_stack.clear();
+    store_sample(conflated_data, conflated_size, conflated_dts);
+  };
+  auto decode_failed = [&]() {
+    store_conflated_sample();
+    return false;
+  };
+
   while(frame_index < frame_size) {
     //
     // Check header size and decode datatimestamp
@@ -242,7 +298,7 @@ bool ed247::Stream::decode(const char* frame, uint32_t frame_size, const ed247_s
       // First sample
       if((frame_size - frame_index) < _sample_first_header_size) {
         PRINT_ERROR("Stream '" << get_name() << "': Received frame is too small. Size: " << frame_size);
-        return false;
+        return decode_failed();
       }
 
       if(_configuration->_data_timestamp._enable == ED247_YESNO_YES) {
@@ -256,7 +312,7 @@ bool ed247::Stream::decode(const char* frame, uint32_t frame_size, const ed247_s
       // Next samples
       if((frame_size - frame_index) < _sample_next_header_size) {
         PRINT_ERROR("Stream '" << get_name() << "': Received frame is too small. Size: " << frame_size);
-        return false;
+        return decode_failed();
       }
 
       if(_configuration->_data_timestamp._enable_sample_offset == ED247_YESNO_YES) {
@@ -278,14 +334,14 @@ bool ed247::Stream::decode(const char* frame, uint32_t frame_size, const ed247_s
         sample_size = _configuration->_sample_max_size_bytes;
         if (frame_size - frame_index < sample_size) {
           PRINT_ERROR("Stream '" << get_name() << "': Received frame is too small. Size: " << frame_size);
-          return false;
+          return decode_failed();
         }
       } else {
         // No size information: the whole frame is the sample
         sample_size = frame_size - frame_index;
         if (sample_size > _configuration->_sample_max_size_bytes) {
           PRINT_ERROR("Stream '" << get_name() << "': Received frame is too small. Size: " << frame_size);
-          return false;
+          return decode_failed();
         }
       }
       break;
@@ -295,11 +351,11 @@ bool ed247::Stream::decode(const char* frame, uint32_t frame_size, const ed247_s
       frame_index += sizeof(uint8_t);
       if (sample_size > _configuration->_sample_max_size_bytes) {
         PRINT_ERROR("Stream '" << get_name() << "': Invalid received frame. Size in header  is invalid: " << sample_size);
-        return false;
+        return decode_failed();
       }
       if (frame_size - frame_index < sample_size) {
         PRINT_ERROR("Stream '" << get_name() << "': Received frame is too small. Size: " << frame_size);
-        return false;
+        return decode_failed();
       }
       break;
 
@@ -308,11 +364,11 @@ bool ed247::Stream::decode(const char* frame, uint32_t frame_size, const ed247_s
       frame_index += sizeof(uint16_t);
       if (sample_size > _configuration->_sample_max_size_bytes) {
         PRINT_ERROR("Stream '" << get_name() << "': Invalid received frame. Size in header is invalid: " << sample_size);
-        return false;
+        return decode_failed();
       }
       if (frame_size - frame_index < sample_size) {
         PRINT_ERROR("Stream '" << get_name() << "': Received frame is too small. Size: " << frame_size);
-        return false;
+        return decode_failed();
       }
       break;
 
@@ -324,16 +380,17 @@ bool ed247::Stream::decode(const char* frame, uint32_t frame_size, const ed247_s
     //
     // Add the new sample
     //
-    StreamSample& sample = _recv_stack.push_back();
-
-    sample.set_data_timestamp(sample_dts);
-    sample.update_recv_timestamp();
-
-    sample.copy(frame + frame_index, sample_size);
-    frame_index += sample.size();
-
-    sample.set_frame_details(frame_details);
+    if (_conflation) {
+      // Only the newest sample is stored: remember this one, it replaces the previous one
+      conflated_data = frame + frame_index;
+      conflated_size = sample_size;
+      conflated_dts = sample_dts;
+    } else {
+      store_sample(frame + frame_index, sample_size, sample_dts);
+    }
+    frame_index += sample_size;
   }
+  store_conflated_sample();
 
   return run_callbacks();
 }
@@ -476,6 +533,7 @@ ed247::stream_ptr_t ed247::StreamSet::create(const ed247::xml::Stream* configura
   // Store all streams
   auto result = _streams.emplace(std::make_pair(configuration->_name, stream));
   if (result.second == false) THROW_ED247_ERROR("Stream [" << configuration->_name << "] already exist !");
+  _sorted_streams.insert(result.first->first.c_str(), result.first->second);
   return result.first->second;
 }
 
@@ -486,14 +544,9 @@ ed247::stream_ptr_t ed247::StreamSet::get(std::string name)
   return nullptr;
 }
 
-ed247::stream_list_t ed247::StreamSet::find(std::string str_regex)
+ed247::stream_list_t ed247::StreamSet::find(const NamePattern& pattern) const
 {
-  std::regex reg(str_regex);
   stream_list_t founds;
-  for(auto& stream_pair : _streams) {
-    if(std::regex_match(stream_pair.first, reg)) {
-      founds.push_back(stream_pair.second);
-    }
-  }
+  pattern.select(_sorted_streams, founds);
   return founds;
 }
@@ -27,6 +27,8 @@
 #include "ed247_xml.h"
 #include "ed247_signal.h"
 #include "ed247_sample.h"
+#include "ed247_name_index.h"
+#include <atomic>
 
 
 // base structures for C API
@@ -83,8 +85,10 @@ namespace ed247
     StreamAssistant* get_assistant()                       { return _assistant.get();                  }
     signal_list_t& get_signals()                           { return _signals;                          }
     ed247_internal_signal_list_t*  get_client_signals()    { return _client_signals.get();             }
-    signal_list_t find_signals(std::string str_regex);
-    signal_ptr_t get_signal(std::string str_name);
+    signal_list_t find_signals(const std::string& str_regex) { return find_signals(NamePattern(str_regex)); }
+    signal_list_t find_signals(const NamePattern& pattern);
+    signal_ptr_t get_signal(const char* name);
+    signal_ptr_t get_signal(const std::string& name) { return get_signal(name.c_str()); }
 
 
     // Handing samples
@@ -105,6 +109,14 @@ namespace ed247
     // If stack is empty before the pop, an arbitrary, but valid, sample will be returned. (see get_incoming_sample_number())
     StreamSample& pop_sample(bool* empty);
 
+    // Remove all received samples but the newest one
+    void drop_old_samples()                                 { if (_recv_stack.size() > 1) _recv_stack.drop_front(_recv_stack.size() - 1); }
+
+    // When conflation is enabled, decode() only keeps the newest received sample.
+    // Only signal based streams can be conflated: their consumers only want the latest state.
+    bool set_conflation(bool enable);
+    bool get_conflation() const                             { return _conflation; }
+
     // Encode each pushed sample of the stream in frame.
     // Return encoded length.
     uint32_t encode(char* frame, uint32_t frame_size);
@@ -113,6 +125,15 @@ namespace ed247
     // Return false on error (the rest of the frame cannot be decoded)
     bool decode(const char* frame, uint32_t frame_size, const ed247_sample_details_t& frame_details);
 
+    // Add the samples stacks and assistant buffers to footprint
+    void add_memory_footprint(ed247_memory_footprint_t& footprint) const;
+
+    // When lazy allocation is enabled, the samples stacks of new streams are allocated on first use.
+    // Otherwise, the stacks matching the stream direction are allocated at creation.
+    // Read once by each load (see Context::is_lazy_allocation()).
+    static void set_lazy_allocation(bool enable) { _lazy_allocation = enable; }
+    static bool get_lazy_allocation()            { return _lazy_allocation;   }
+
     // Callback managment (Can we remove this ugly API ?)
     ed247_status_t register_callback(ed247_context_t context, ed247_stream_recv_callback_t callback);
     ed247_status_t unregister_callback(ed247_context_t context, ed247_stream_recv_callback_t callback);
@@ -127,10 +148,12 @@ namespace ed247
     uint32_t                                            _sample_next_header_size;
     uint32_t                                            _max_size;
     signal_list_t                                       _signals;
+    name_index_t<signal_ptr_t>                          _signals_by_name;
     std::unique_ptr<ed247_internal_signal_list_t>       _client_signals;
     std::unique_ptr<StreamAssistant>                    _assistant;
     StreamSampleRingBuffer                              _recv_stack;
     StreamSampleRingBuffer                              _send_stack;
+    bool                                                _conflation;
 
   private:
     ed247_internal_channel_t*                           _ed247_api_channel;
@@ -143,6 +166,8 @@ namespace ed247
     };
     std::vector<CallbackData>  _callbacks;
 
+    static std::atomic<bool> _lazy_allocation;
+
     ED247_FRIEND_TEST();
   };
 
@@ -177,7 +202,11 @@ namespace ed247
     stream_ptr_t create(const xml::Stream* configuration, ed247_internal_channel_t* ed247_api_channel);
 
     stream_ptr_t get(std::string name);
-    stream_list_t find(std::string regex);
+    stream_list_t find(const std::string& regex) const { return find(NamePattern(regex)); }
+    stream_list_t find(const NamePattern& pattern) const;
+
+    // Sort the name index once all the streams are created
+    void sort_names() { _sorted_streams.sort(); }
 
     stream_map_t& streams()  { return _streams;        }
     uint32_t size() const    { return _streams.size(); }
@@ -186,10 +215,11 @@ namespace ed247
     stream_list_t& get_streams_signals_input() { return _streams_signals_input; }
 
   private:
-    stream_map_t   _streams;
-    stream_list_t  _streams_signals_output;
-    stream_list_t  _streams_signals_input;
-    Context*       _context;
+    stream_map_t                  _streams;
+    SortedNameIndex<stream_ptr_t> _sorted_streams;
+    stream_list_t                 _streams_signals_output;
+    stream_list_t                 _streams_signals_input;
+    Context*                      _context;
   };
 }
 
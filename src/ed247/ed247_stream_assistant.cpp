@@ -4,39 +4,6 @@
 #include "ed247_stream.h"
 #include "ed247_logs.h"
 
-namespace {
-  // Swap a payload of signals
-  // Size is the length of the payload (so the number of signals is size/signal_size)
-  void swap_copy(const char* source_data, char* dest_data, uint32_t size, const ed247_nad_type_t& nad_type)
-  {
-    uint32_t element_size = ed247::xml::Signal::get_nad_type_size(nad_type);
-
-    if (element_size == 1) {
-      memcpy(dest_data, source_data, size);
-    }
-    else
-    {
-      uint32_t pos = 0;
-      while (pos < size) {
-        switch(element_size) {
-        case 2:
-          *(uint16_t*)(dest_data + pos) = bswap_16(*(uint16_t*)(source_data + pos));
-          break;
-        case 4:
-          *(uint32_t*)(dest_data + pos) = bswap_32(*(uint32_t*)(source_data + pos));
-          break;
-        case 8:
-          *(uint64_t*)(dest_data + pos) = bswap_64(*(uint64_t*)(source_data + pos));
-          break;
-        default:
-          THROW_ED247_ERROR("Unexpected NAD size: " << element_size);
-        }
-        pos += element_size;
-      }
-    }
-  }
-}
-
 
 ed247::StreamAssistant::StreamAssistant(ed247::Stream* stream):
   _stream(stream),
@@ -60,6 +27,36 @@ bool ed247::StreamAssistant::push_if_was_written(const ed247_timestamp_t* data_t
   return true; // nothing to do => success
 }
 
+void ed247::StreamAssistant::add_memory_footprint(ed247_memory_footprint_t& footprint) const
+{
+  footprint.allocated_bytes += _buffer.capacity();
+  footprint.max_bytes += _buffer.capacity();
+}
+
+bool ed247::StreamAssistant::write_signals(const ed247_signal_t*, uint32_t, const void*, uint32_t)
+{
+  PRINT_ERROR("Stream '" << _stream->get_name() << "': Bulk signals write is only available for fixed size streams");
+  return false;
+}
+
+bool ed247::StreamAssistant::read_signals(const ed247_signal_t*, uint32_t, void*, uint32_t)
+{
+  PRINT_ERROR("Stream '" << _stream->get_name() << "': Bulk signals read is only available for fixed size streams");
+  return false;
+}
+
+ed247::SignalBatch* ed247::StreamAssistant::create_batch(const ed247_signal_t*, uint32_t)
+{
+  PRINT_ERROR("Stream '" << _stream->get_name() << "': Signal batches are only available for fixed size streams");
+  return nullptr;
+}
+
+bool ed247::StreamAssistant::bind_signal(const Signal&, ed247_nad_type_t, ed247_signal_binding_t&)
+{
+  PRINT_ERROR("Stream '" << _stream->get_name() << "': Typed signal access is only available for fixed size streams");
+  return false;
+}
+
 
 
 //
@@ -79,7 +76,7 @@ bool ed247::FixedStreamAssistant::write(const ed247::Signal& signal, const void*
     return false;
   }
 
-  swap_copy((const char*) data, _buffer.data_rw() + signal.get_byte_offset(), size, signal.get_nad_type());
+  signal.get_swap_copy()((const char*) data, _buffer.data_rw() + signal.get_byte_offset(), size);
   _was_written = true;
 
   return true;
@@ -125,12 +122,142 @@ ed247_status_t ed247::FixedStreamAssistant::pop(const ed247_timestamp_t** data_t
 
   for(auto signal : _stream->get_signals()) {
     uint32_t byte_offset = signal->get_byte_offset();
-    swap_copy(sample.data() + byte_offset, _buffer.data_rw() + byte_offset, signal->get_sample_max_size_bytes(), signal->get_nad_type());
+    signal->get_swap_copy()(sample.data() + byte_offset, _buffer.data_rw() + byte_offset, signal->get_sample_max_size_bytes());
   }
 
   return ED247_STATUS_SUCCESS;
 }
 
+// Check all signals belong to the stream and their values fit in size
+bool ed247::FixedStreamAssistant::check_signals(const ed247_signal_t* signals, uint32_t count, uint32_t size, const char* action)
+{
+  uint32_t data_size = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    Signal* signal = static_cast<Signal*>(signals[i]);
+    if (signal == nullptr || signal->get_api_stream() != static_cast<ed247_internal_stream_t*>(_stream)) {
+      PRINT_ERROR("Stream '" << _stream->get_name() << "': Cannot " << action << " signals: signal #" << i << " is not part of the stream");
+      return false;
+    }
+    data_size += signal->get_sample_max_size_bytes();
+  }
+  if (data_size > size) {
+    PRINT_ERROR("Stream '" << _stream->get_name() << "': Cannot " << action << " signals: data of size " << size << " is too small (" << data_size << " expected)");
+    return false;
+  }
+  return true;
+}
+
+bool ed247::FixedStreamAssistant::write_signals(const ed247_signal_t* signals, uint32_t count, const void* data, uint32_t size)
+{
+  if (check_signals(signals, count, size, "write") == false) return false;
+
+  const char* data_ptr = (const char*)data;
+  for (uint32_t i = 0; i < count; i++) {
+    const Signal* signal = static_cast<const Signal*>(signals[i]);
+    uint32_t signal_size = signal->get_sample_max_size_bytes();
+    signal->get_swap_copy()(data_ptr, _buffer.data_rw() + signal->get_byte_offset(), signal_size);
+    data_ptr += signal_size;
+  }
+  _was_written = true;
+  return true;
+}
+
+bool ed247::FixedStreamAssistant::read_signals(const ed247_signal_t* signals, uint32_t count, void* data, uint32_t size)
+{
+  if (check_signals(signals, count, size, "read") == false) return false;
+
+  char* data_ptr = (char*)data;
+  for (uint32_t i = 0; i < count; i++) {
+    const Signal* signal = static_cast<const Signal*>(signals[i]);
+    uint32_t signal_size = signal->get_sample_max_size_bytes();
+    memcpy(data_ptr, _buffer.data() + signal->get_byte_offset(), signal_size);
+    data_ptr += signal_size;
+  }
+  return true;
+}
+
+ed247::SignalBatch* ed247::FixedStreamAssistant::create_batch(const ed247_signal_t* signals, uint32_t count)
+{
+  return new SignalBatch(this, signals, count);
+}
+
+bool ed247::FixedStreamAssistant::bind_signal(const Signal& signal, ed247_nad_type_t nad_type, ed247_signal_binding_t& binding)
+{
+  if (signal.get_api_stream() != static_cast<ed247_internal_stream_t*>(_stream)) {
+    PRINT_ERROR("Stream '" << _stream->get_name() << "': Cannot bind signal '" << signal.get_name() << "': it is not part of the stream");
+    return false;
+  }
+  if (signal.get_nad_type() != nad_type) {
+    PRINT_ERROR("Stream '" << _stream->get_name() << "': Cannot bind signal '" << signal.get_name() << "': invalid "
+                << ed247_nad_type_string(nad_type) << " access to a " << ed247_nad_type_string(signal.get_nad_type()) << " signal");
+    return false;
+  }
+  binding.data = _buffer.data_rw() + signal.get_byte_offset();
+  binding.was_written = &_was_written;
+  binding.size = signal.get_sample_max_size_bytes();
+  return true;
+}
+
+
+
+//
+// SignalBatch
+//
+
+ed247::SignalBatch::SignalBatch(FixedStreamAssistant* assistant, const ed247_signal_t* signals, uint32_t count) :
+  _assistant(assistant),
+  _size(0)
+{
+  MEMCHECK_NEW(this, "SignalBatch");
+  for (uint32_t i = 0; i < count; i++) {
+    Signal* signal = static_cast<Signal*>(signals[i]);
+    if (signal == nullptr || signal->get_api_stream() != static_cast<ed247_internal_stream_t*>(assistant->_stream)) {
+      THROW_ED247_ERROR("Signal #" << i << " is not part of stream [" << assistant->_stream->get_name() << "]");
+    }
+    uint32_t signal_size = signal->get_sample_max_size_bytes();
+
+    // Extend the last range if the signal follows it in both the buffer and the packed values
+    if (_ranges.empty() == false &&
+        _ranges.back().buffer_offset + _ranges.back().size == signal->get_byte_offset() &&
+        _ranges.back().swap_copy == signal->get_swap_copy()) {
+      _ranges.back().size += signal_size;
+    } else {
+      _ranges.push_back(range_t{ signal->get_byte_offset(), _size, signal_size, signal->get_swap_copy() });
+    }
+    _size += signal_size;
+  }
+}
+
+ed247::SignalBatch::~SignalBatch()
+{
+  MEMCHECK_DEL(this, "SignalBatch");
+}
+
+bool ed247::SignalBatch::write(const void* data, uint32_t size)
+{
+  if (size < _size) {
+    PRINT_ERROR("Stream '" << _assistant->_stream->get_name() << "': Cannot write signal batch: data of size " << size << " is too small");
+    return false;
+  }
+  for (const range_t& range : _ranges) {
+    range.swap_copy((const char*)data + range.data_offset, _assistant->_buffer.data_rw() + range.buffer_offset, range.size);
+  }
+  _assistant->_was_written = true;
+  return true;
+}
+
+bool ed247::SignalBatch::read(void* data, uint32_t size)
+{
+  if (size < _size) {
+    PRINT_ERROR("Stream '" << _assistant->_stream->get_name() << "': Cannot read signal batch: data of size " << size << " is too small");
+    return false;
+  }
+  for (const range_t& range : _ranges) {
+    memcpy((char*)data + range.data_offset, _assistant->_buffer.data() + range.buffer_offset, range.size);
+  }
+  return true;
+}
+
 
 
 //
@@ -156,6 +283,15 @@ bool ed247::VNADStreamAssistant::write(const ed247::Signal& signal, const void*
   return true;
 }
 
+void ed247::VNADStreamAssistant::add_memory_footprint(ed247_memory_footprint_t& footprint) const
+{
+  StreamAssistant::add_memory_footprint(footprint);
+  for (auto& signal_sample : _signal_samples) {
+    footprint.allocated_bytes += signal_sample.second.capacity();
+    footprint.max_bytes += signal_sample.second.capacity();
+  }
+}
+
 bool ed247::VNADStreamAssistant::push(const ed247_timestamp_t* data_timestamp, bool* full)
 {
   if(!(_stream->get_direction() & ED247_DIRECTION_OUT)) {
@@ -171,7 +307,7 @@ bool ed247::VNADStreamAssistant::push(const ed247_timestamp_t* data_timestamp, b
     *(uint16_t*)(_buffer.data_rw() + buffer_index) = (uint16_t)htons((uint16_t)signal_sample.size());
     buffer_index += sizeof(uint16_t);
 
-    swap_copy(signal_sample.data(), _buffer.data_rw() + buffer_index, signal_sample.size(), signal->get_nad_type());
+    signal->get_swap_copy()(signal_sample.data(), _buffer.data_rw() + buffer_index, signal_sample.size());
     buffer_index += signal_sample.size();
 
     signal_sample.reset();
@@ -222,7 +358,7 @@ ed247_status_t ed247::VNADStreamAssistant::pop(const ed247_timestamp_t** data_ti
     }
 
     Sample& signal_sample = _signal_samples[signal->get_vnad_position()];
-    swap_copy((const char*)sample.data() + buffer_index, signal_sample.data_rw(), signal_size, signal->get_nad_type());
+    signal->get_swap_copy()((const char*)sample.data() + buffer_index, signal_sample.data_rw(), signal_size);
     signal_sample.set_size(signal_size);
     buffer_index += signal_size;
   }
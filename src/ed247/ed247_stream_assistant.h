@@ -11,11 +11,13 @@
 struct ed247_internal_stream_assistant_t {
   virtual ~ed247_internal_stream_assistant_t() {}
 };
+struct ed247_internal_signal_batch_t {};
 
 
 namespace ed247
 {
   class Stream;
+  class SignalBatch;
 
   class StreamAssistant : public ed247_internal_stream_assistant_t
   {
@@ -43,6 +45,20 @@ namespace ed247
     // Push data only if was_written(). See stream::push_sample() for details
     bool push_if_was_written(const ed247_timestamp_t* data_timestamp, bool* full);
 
+    // Add the assistant buffers to footprint
+    virtual void add_memory_footprint(ed247_memory_footprint_t& footprint) const;
+
+    // Bulk access: the values of signals are packed in data, in the same order, without padding.
+    // Only implemented by fixed size streams (see FixedStreamAssistant).
+    virtual bool write_signals(const ed247_signal_t* signals, uint32_t count, const void* data, uint32_t size);
+    virtual bool read_signals(const ed247_signal_t* signals, uint32_t count, void* data, uint32_t size);
+
+    // Precompiled bulk access. Return nullptr on error.
+    virtual SignalBatch* create_batch(const ed247_signal_t* signals, uint32_t count);
+
+    // Direct access to a signal of type nad_type (see ed247_signal_accessor.h). Return false on error.
+    virtual bool bind_signal(const Signal& signal, ed247_nad_type_t nad_type, ed247_signal_binding_t& binding);
+
   protected:
     Stream* _stream;
     Sample  _buffer;          // WARN: buffer content depend on stream type and direction for performances reasons
@@ -63,6 +79,15 @@ namespace ed247
     virtual bool push(const ed247_timestamp_t* data_timestamp, bool* full) override;
     virtual ed247_status_t pop(const ed247_timestamp_t** data_timestamp, const ed247_timestamp_t** recv_timestamp,
                                const ed247_sample_details_t** frame_details, bool* empty) override;
+
+    virtual bool write_signals(const ed247_signal_t* signals, uint32_t count, const void* data, uint32_t size) override;
+    virtual bool read_signals(const ed247_signal_t* signals, uint32_t count, void* data, uint32_t size) override;
+    virtual SignalBatch* create_batch(const ed247_signal_t* signals, uint32_t count) override;
+    virtual bool bind_signal(const Signal& signal, ed247_nad_type_t nad_type, ed247_signal_binding_t& binding) override;
+
+  private:
+    bool check_signals(const ed247_signal_t* signals, uint32_t count, uint32_t size, const char* action);
+    friend class SignalBatch;
   };
 
   class VNADStreamAssistant : public StreamAssistant
@@ -77,12 +102,45 @@ namespace ed247
     virtual ed247_status_t pop(const ed247_timestamp_t** data_timestamp, const ed247_timestamp_t** recv_timestamp,
                                const ed247_sample_details_t** frame_details, bool* empty) override;
 
+    virtual void add_memory_footprint(ed247_memory_footprint_t& footprint) const override;
+
   private:
     // signal position -> Sample.
     // Position may not be continuous so we cannot use a vector
     std::unordered_map<uint32_t, Sample> _signal_samples;
   };
 
+
+  //
+  // Precompiled list of signals of a fixed size stream.
+  // Signals contiguous in the stream sample are merged, so each range is copied at once.
+  //
+  class SignalBatch : public ed247_internal_signal_batch_t
+  {
+  public:
+    // Throw if a signal is not part of the assistant stream
+    SignalBatch(FixedStreamAssistant* assistant, const ed247_signal_t* signals, uint32_t count);
+    ~SignalBatch();
+
+    // Size of the packed values
+    uint32_t get_size() const { return _size; }
+
+    bool write(const void* data, uint32_t size);
+    bool read(void* data, uint32_t size);
+
+  private:
+    struct range_t {
+      uint32_t            buffer_offset;   // Offset in the assistant buffer
+      uint32_t            data_offset;     // Offset in the packed values
+      uint32_t            size;
+      Signal::swap_copy_t swap_copy;
+    };
+
+    FixedStreamAssistant* _assistant;
+    std::vector<range_t>  _ranges;
+    uint32_t              _size;
+  };
+
 }
 
 #endif
@@ -0,0 +1,50 @@
+/* -*- mode: c++; c-basic-offset: 2 -*-  */
+//
+// Signal values byte order swap
+//
+// swap_copy<WIDTH>(): copy values of WIDTH bytes, swapping their byte order.
+// The width is resolved once per signal (see Signal::get_swap_copy()), so
+// there is no runtime type dispatch. See also ed247_signal_accessor.h.
+//
+#ifndef _ED247_SWAP_COPY_H_
+#define _ED247_SWAP_COPY_H_
+#include "ed247_signal.h"
+#include "ed247_bswap.h"
+#include <cstring>
+
+namespace ed247
+{
+  //
+  // Byte order swap of a WIDTH bytes word
+  //
+  template<uint32_t WIDTH> struct byte_swap;
+  template<> struct byte_swap<1> { typedef uint8_t  word_t; static word_t apply(word_t word) { return word;           } };
+  template<> struct byte_swap<2> { typedef uint16_t word_t; static word_t apply(word_t word) { return bswap_16(word); } };
+  template<> struct byte_swap<4> { typedef uint32_t word_t; static word_t apply(word_t word) { return bswap_32(word); } };
+  template<> struct byte_swap<8> { typedef uint64_t word_t; static word_t apply(word_t word) { return bswap_64(word); } };
+
+  // Swap a payload of values of WIDTH bytes (size is the length of the payload)
+  // Source and destination may be unaligned.
+  template<uint32_t WIDTH>
+  void swap_copy(const char* source_data, char* dest_data, uint32_t size)
+  {
+    typedef typename byte_swap<WIDTH>::word_t word_t;
+    for (uint32_t pos = 0; pos + WIDTH <= size; pos += WIDTH) {
+      word_t word;
+      memcpy(&word, source_data + pos, WIDTH);
+      word = byte_swap<WIDTH>::apply(word);
+      memcpy(dest_data + pos, &word, WIDTH);
+    }
+  }
+
+  template<>
+  inline void swap_copy<1>(const char* source_data, char* dest_data, uint32_t size)
+  {
+    memcpy(dest_data, source_data, size);
+  }
+
+  // Resolve the swap_copy() of a NAD type. Throw if nad_type is invalid.
+  Signal::swap_copy_t get_swap_copy(ed247_nad_type_t nad_type);
+}
+
+#endif
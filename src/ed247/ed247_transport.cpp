@@ -0,0 +1,555 @@
+/* -*- mode: c++; c-basic-offset: 2 -*-  */
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include "ed247_transport.h"
+#include "ed247_logs.h"
+#include "ed247_time.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <unordered_map>
+#ifdef __linux__
+# include <climits>
+# include <fcntl.h>
+# include <linux/futex.h>
+# include <pthread.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <sys/syscall.h>
+# include <thread>
+# include <unistd.h>
+# include <arpa/inet.h>
+#endif
+
+
+//
+// Loopback bus
+// Receivers of all the loopback transports of the process, by address.
+// The ReceiverSet only adds the first receiver of each address (see ReceiverSet::emplace()): the
+// frame is delivered once to the context, whatever the number of receivers on this address.
+//
+namespace {
+
+  struct subscriber_t {
+    ed247::udp::LoopbackTransport* transport;
+    ed247::udp::Receiver*          receiver;
+  };
+
+  struct loopback_bus_t {
+    using subscriber_map_t = std::unordered_map<ed247::udp::socket_address_t, std::vector<subscriber_t>,
+                                                ed247::udp::socket_address_hash, ed247::udp::socket_address_equal_to>;
+    std::mutex       mutex;
+    subscriber_map_t subscribers;
+  };
+
+  // Constructed on first use: contexts may be loaded by static initializers
+  loopback_bus_t& loopback_bus()
+  {
+    static loopback_bus_t bus;
+    return bus;
+  }
+
+}
+
+
+//
+// LoopbackTransport
+//
+ed247::udp::LoopbackTransport::LoopbackTransport(ReceiverSet& receiver_set) :
+  _receiver_set(receiver_set)
+{
+  MEMCHECK_NEW(this, "udp::LoopbackTransport");
+}
+
+ed247::udp::LoopbackTransport::~LoopbackTransport()
+{
+  loopback_bus_t& bus = loopback_bus();
+  {
+    std::lock_guard<std::mutex> lock(bus.mutex);
+    for (auto entry = bus.subscribers.begin(); entry != bus.subscribers.end(); ) {
+      std::vector<subscriber_t>& subscribers = entry->second;
+      subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+                                       [this](const subscriber_t& subscriber) { return subscriber.transport == this; }),
+                        subscribers.end());
+      if (subscribers.empty()) {
+        entry = bus.subscribers.erase(entry);
+      } else {
+        entry++;
+      }
+    }
+  }
+  if (_dropped_frame_count != 0) {
+    PRINT_WARNING("Loopback transport: " << _dropped_frame_count << " frames have been dropped (receive queue full)");
+  }
+  MEMCHECK_DEL(this, "udp::LoopbackTransport");
+}
+
+void ed247::udp::LoopbackTransport::add_receiver(Receiver* receiver)
+{
+  loopback_bus_t& bus = loopback_bus();
+  std::lock_guard<std::mutex> lock(bus.mutex);
+  PRINT_DEBUG("Loopback transport: receive on " << receiver->get_socket_address());
+  bus.subscribers[receiver->get_socket_address()].push_back(subscriber_t{this, receiver});
+}
+
+bool ed247::udp::LoopbackTransport::send_frame(const socket_address_t& source, const socket_address_t& destination,
+                                               const void* payload, uint32_t payload_size)
+{
+  if (payload_size > Receiver::MAX_FRAME_SIZE) {
+    PRINT_ERROR("Loopback transport: frame of " << payload_size << " bytes is too large to be sent to " << destination);
+    return false;
+  }
+  PRINT_CRAZY("Loopback send from (" << source << ") to (" << destination << "), size " << payload_size << "b");
+
+  loopback_bus_t& bus = loopback_bus();
+  std::lock_guard<std::mutex> lock(bus.mutex);
+
+  auto deliver = [&](const socket_address_t& address) {
+    auto entry = bus.subscribers.find(address);
+    if (entry == bus.subscribers.end()) return;
+    for (const subscriber_t& subscriber : entry->second) {
+      subscriber.transport->queue_frame(subscriber.receiver, source, payload, payload_size);
+    }
+  };
+
+  // Receivers bound to the destination, then receivers bound to INADDR_ANY on the same port
+  deliver(destination);
+  if (destination.is_any_addr() == false) {
+    socket_address_t any_address(destination);
+    any_address.set_ip_address(std::string());
+    deliver(any_address);
+  }
+  return true;
+}
+
+void ed247::udp::LoopbackTransport::queue_frame(Receiver* receiver, const socket_address_t& source,
+                                                const void* payload, uint32_t payload_size)
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_pending_bytes + payload_size > MAX_PENDING_BYTES) {
+      if (_dropped_frame_count++ == 0) {
+        PRINT_WARNING("Loopback transport: receive queue full, frame dropped on " << receiver->get_socket_address());
+      }
+      return;
+    }
+
+    if (_spare_frames.empty()) {
+      _pending_frames.emplace_back();
+    } else {
+      _pending_frames.push_back(std::move(_spare_frames.back()));
+      _spare_frames.pop_back();
+    }
+    frame_t& frame = _pending_frames.back();
+    frame.receiver = receiver;
+    frame.source = source;
+    frame.payload.assign((const char*)payload, (const char*)payload + payload_size);
+    _pending_bytes += payload_size;
+  }
+  _frame_queued.notify_one();
+}
+
+ed247_status_t ed247::udp::LoopbackTransport::wait_frame(int32_t timeout_us)
+{
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto frame_pending = [this]() { return _pending_frames.empty() == false; };
+    if (timeout_us < 0) {
+      _frame_queued.wait(lock, frame_pending);
+    } else if (timeout_us > 0) {
+      _frame_queued.wait_for(lock, std::chrono::microseconds(timeout_us), frame_pending);
+    }
+    if (_pending_frames.empty()) return ED247_STATUS_TIMEOUT;
+
+    _delivered_frames.swap(_pending_frames);
+    _pending_bytes = 0;
+  }
+
+  // The receive callbacks are called without lock: they may send frames to this transport
+  bool datagram_info_enabled = _receiver_set.is_datagram_info_enabled();
+  for (frame_t& frame : _delivered_frames) {
+    PRINT_CRAZY("Loopback received frame of " << frame.payload.size() << " bytes on " << frame.receiver->get_socket_address());
+    if (datagram_info_enabled) {
+      ed247_datagram_info_t& info = _receiver_set.get_datagram_info();
+      ed247_get_receive_timestamp(&info.timestamp);
+      info.source_ip = ntohl(frame.source.sin_addr.s_addr);
+      info.source_port = ntohs(frame.source.sin_port);
+      info.destination_ip = ntohl(frame.receiver->get_socket_address().sin_addr.s_addr);
+      info.destination_port = ntohs(frame.receiver->get_socket_address().sin_port);
+    }
+    frame.receiver->deliver_frame(frame.payload.data(), frame.payload.size());
+  }
+
+  // Keep the payload buffers for the next frames
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (frame_t& frame : _delivered_frames) {
+    _spare_frames.push_back(std::move(frame));
+  }
+  _delivered_frames.clear();
+  return ED247_STATUS_SUCCESS;
+}
+
+
+#ifdef __linux__
+//
+// Shared memory layouts
+// The objects are created zeroed by the first process that opens them. It initializes them and
+// then publishes them by writing their magic. The other processes wait for the magic.
+//
+namespace {
+  static const uint32_t SHM_MAGIC   = 0x45443437;   // "ED47"
+  static const uint32_t SHM_VERSION = 1;
+}
+
+struct ed247::udp::ShmTransport::ring_t {
+  std::atomic<uint32_t>             magic;
+  uint32_t                          version;
+  uint64_t                          capacity;
+  pthread_mutex_t                   writer_mutex;
+  // Positions are byte counts since the creation of the ring
+  alignas(64) std::atomic<uint64_t> reserve_position;   // End of the record being written
+  std::atomic<uint64_t>             commit_position;    // End of the last written record
+
+  char* data() { return reinterpret_cast<char*>(this) + sizeof(ring_t); }
+};
+
+struct ed247::udp::ShmTransport::doorbell_t {
+  std::atomic<uint32_t>             magic;
+  uint32_t                          version;
+  uint64_t                          capacity;           // Unused
+  alignas(64) std::atomic<uint32_t> sequence;           // Incremented by each written frame (futex)
+  std::atomic<uint32_t>             waiter_count;
+};
+
+namespace {
+
+  // Record of a ring. The records are 16 bytes aligned and never wrap: a skip record fills the end
+  // of the ring when the next record does not fit.
+  struct shm_record_t {
+    enum type_t : uint32_t { DATA = 0, SKIP = 1 };
+    uint32_t size;          // DATA: payload size. SKIP: bytes to skip after the record header.
+    uint32_t type;
+    uint32_t source_ip;     // Network byte order
+    uint16_t source_port;   // Network byte order
+    uint16_t reserved;
+  };
+  static_assert(sizeof(shm_record_t) == 16, "Unexpected shm_record_t size");
+
+  uint64_t shm_record_size(uint32_t payload_size)
+  {
+    return (sizeof(shm_record_t) + payload_size + 15) & ~(uint64_t)15;
+  }
+
+  long futex(std::atomic<uint32_t>* address, int operation, uint32_t value, const struct timespec* timeout)
+  {
+    return syscall(SYS_futex, (uint32_t*)address, operation, value, timeout, nullptr, 0);
+  }
+
+  // Open (or create) and map a shared memory object. created is set if this process has created it (zeroed).
+  void* shm_map(const std::string& name, size_t size, bool& created)
+  {
+    created = true;
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+    if (fd == -1 && errno == EEXIST) {
+      created = false;
+      fd = shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0666);
+    }
+    if (fd == -1) {
+      THROW_ED247_ERROR("Failed to open the shared memory " << name << " (" << strerror(errno) << ")");
+    }
+
+    if (created) {
+      // The umask of the creator applies: the rig processes shall be able to read and write it
+      if (ftruncate(fd, size) != 0) {
+        int error = errno;
+        close(fd);
+        shm_unlink(name.c_str());
+        THROW_ED247_ERROR("Failed to size the shared memory " << name << " (" << strerror(error) << ")");
+      }
+    } else {
+      // Wait for the creator to size the object
+      struct stat status;
+      for (uint32_t retry = 0; fstat(fd, &status) == 0 && status.st_size == 0 && retry < 1000; retry++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      if (fstat(fd, &status) != 0 || (size_t)status.st_size != size) {
+        close(fd);
+        THROW_ED247_ERROR("The shared memory " << name << " has an unexpected size. Is it used by another version of the library?");
+      }
+    }
+
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    int error = errno;
+    close(fd);
+    if (address == MAP_FAILED) {
+      THROW_ED247_ERROR("Failed to map the shared memory " << name << " (" << strerror(error) << ")");
+    }
+    PRINT_DEBUG("Shared memory transport: " << (created? "created " : "opened ") << name);
+    return address;
+  }
+
+  // Publish an object initialized by its creator
+  template<typename T>
+  void shm_publish(T* object, uint64_t capacity)
+  {
+    object->version = SHM_VERSION;
+    object->capacity = capacity;
+    object->magic.store(SHM_MAGIC, std::memory_order_release);
+  }
+
+  // Wait for the creator to publish an object. Return false if it is not compatible.
+  template<typename T>
+  bool shm_wait_published(T* object, uint64_t capacity)
+  {
+    for (uint32_t retry = 0; object->magic.load(std::memory_order_acquire) != SHM_MAGIC && retry < 1000; retry++) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return object->magic.load(std::memory_order_acquire) == SHM_MAGIC &&
+      object->version == SHM_VERSION && object->capacity == capacity;
+  }
+
+}
+
+
+//
+// ShmTransport
+//
+ed247::udp::ShmTransport::ShmTransport(ReceiverSet& receiver_set) :
+  _receiver_set(receiver_set)
+{
+  bool created;
+  _doorbell = static_cast<doorbell_t*>(shm_map("/ed247_doorbell", sizeof(doorbell_t), created));
+  if (created) {
+    shm_publish(_doorbell, 0);
+  } else if (shm_wait_published(_doorbell, 0) == false) {
+    munmap(_doorbell, sizeof(doorbell_t));
+    THROW_ED247_ERROR("The shared memory /ed247_doorbell is not initialized or has another version.");
+  }
+  MEMCHECK_NEW(this, "udp::ShmTransport");
+}
+
+ed247::udp::ShmTransport::~ShmTransport()
+{
+  for (auto& ring : _rings) {
+    munmap(ring.second, sizeof(ring_t) + RING_CAPACITY);
+  }
+  munmap(_doorbell, sizeof(doorbell_t));
+  if (_overrun_count != 0) {
+    PRINT_WARNING("Shared memory transport: " << _overrun_count << " ring overruns (frames lost)");
+  }
+  MEMCHECK_DEL(this, "udp::ShmTransport");
+}
+
+ed247::udp::ShmTransport::ring_t* ed247::udp::ShmTransport::open_ring(const socket_address_t& address)
+{
+  auto iring = _rings.find(address);
+  if (iring != _rings.end()) return iring->second;
+
+  char ip_address[INET_ADDRSTRLEN];
+  inet_ntop(AF_INET, &address.sin_addr, ip_address, INET_ADDRSTRLEN);
+  std::string name = strize() << "/ed247_" << ip_address << "_" << ntohs(address.sin_port);
+
+  bool created;
+  ring_t* ring = static_cast<ring_t*>(shm_map(name, sizeof(ring_t) + RING_CAPACITY, created));
+  if (created) {
+    pthread_mutexattr_t attributes;
+    pthread_mutexattr_init(&attributes);
+    pthread_mutexattr_setpshared(&attributes, PTHREAD_PROCESS_SHARED);
+    pthread_mutexattr_setrobust(&attributes, PTHREAD_MUTEX_ROBUST);
+    pthread_mutex_init(&ring->writer_mutex, &attributes);
+    pthread_mutexattr_destroy(&attributes);
+    shm_publish(ring, RING_CAPACITY);
+  } else if (shm_wait_published(ring, RING_CAPACITY) == false) {
+    munmap(ring, sizeof(ring_t) + RING_CAPACITY);
+    THROW_ED247_ERROR("The shared memory " << name << " is not initialized or has another version.");
+  }
+
+  _rings.emplace(address, ring);
+  return ring;
+}
+
+void ed247::udp::ShmTransport::add_receiver(Receiver* receiver)
+{
+  std::lock_guard<std::mutex> lock(_rings_mutex);
+  if (receiver->get_socket_address().is_any_addr()) {
+    PRINT_WARNING("Shared memory transport: the receiver " << receiver->get_socket_address()
+                  << " will only receive the frames sent to INADDR_ANY.");
+  }
+  ring_t* ring = open_ring(receiver->get_socket_address());
+  // Only the frames written from now are received
+  _readers.push_back(reader_t{ring, receiver, ring->commit_position.load(std::memory_order_acquire)});
+}
+
+bool ed247::udp::ShmTransport::send_frame(const socket_address_t& source, const socket_address_t& destination,
+                                          const void* payload, uint32_t payload_size)
+{
+  if (payload_size > Receiver::MAX_FRAME_SIZE) {
+    PRINT_ERROR("Shared memory transport: frame of " << payload_size << " bytes is too large to be sent to " << destination);
+    return false;
+  }
+
+  ring_t* ring;
+  try {
+    std::lock_guard<std::mutex> lock(_rings_mutex);
+    ring = open_ring(destination);
+  }
+  catch(std::exception& e) {
+    PRINT_ERROR(e.what());
+    return false;
+  }
+
+  int lock_status = pthread_mutex_lock(&ring->writer_mutex);
+  if (lock_status != 0 && lock_status != EOWNERDEAD) {
+    PRINT_ERROR("Shared memory transport: failed to lock the ring of " << destination << " (" << strerror(lock_status) << ")");
+    return false;
+  }
+
+  char* data = ring->data();
+  uint64_t position = ring->commit_position.load(std::memory_order_relaxed);
+  if (lock_status == EOWNERDEAD) {
+    // A writer died while writing a record: skip it
+    uint64_t reserve = ring->reserve_position.load(std::memory_order_relaxed);
+    if (reserve != position) {
+      shm_record_t skip{(uint32_t)(reserve - position - sizeof(shm_record_t)), shm_record_t::SKIP, 0, 0, 0};
+      memcpy(data + position % RING_CAPACITY, &skip, sizeof(skip));
+      position = reserve;
+    }
+    pthread_mutex_consistent(&ring->writer_mutex);
+  }
+
+  uint64_t offset = position % RING_CAPACITY;
+  uint64_t record_size = shm_record_size(payload_size);
+  uint64_t skip_size = (RING_CAPACITY - offset < record_size)? RING_CAPACITY - offset : 0;
+
+  // Readers check the reserve position after reading a record to detect an overwrite
+  ring->reserve_position.store(position + skip_size + record_size, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  if (skip_size != 0) {
+    shm_record_t skip{(uint32_t)(skip_size - sizeof(shm_record_t)), shm_record_t::SKIP, 0, 0, 0};
+    memcpy(data + offset, &skip, sizeof(skip));
+    offset = 0;
+  }
+  shm_record_t record{payload_size, shm_record_t::DATA, source.sin_addr.s_addr, source.sin_port, 0};
+  memcpy(data + offset, &record, sizeof(record));
+  memcpy(data + offset + sizeof(record), payload, payload_size);
+
+  ring->commit_position.store(position + skip_size + record_size, std::memory_order_release);
+  pthread_mutex_unlock(&ring->writer_mutex);
+
+  // Wake up the blocked readers, if any
+  _doorbell->sequence.fetch_add(1, std::memory_order_seq_cst);
+  if (_doorbell->waiter_count.load(std::memory_order_seq_cst) != 0) {
+    futex(&_doorbell->sequence, FUTEX_WAKE, INT_MAX, nullptr);
+  }
+  return true;
+}
+
+uint32_t ed247::udp::ShmTransport::read_frames(reader_t& reader)
+{
+  ring_t* ring = reader.ring;
+  const char* data = ring->data();
+  Receiver::frame_t& frame = _receiver_set.get_receive_frame();
+  uint32_t frame_count = 0;
+
+  while (true) {
+    uint64_t commit = ring->commit_position.load(std::memory_order_acquire);
+    if (reader.read_position == commit) break;
+    if (commit - reader.read_position > RING_CAPACITY) {
+      // Too late: the next record has been overwritten
+      _overrun_count++;
+      reader.read_position = commit;
+      break;
+    }
+
+    uint64_t offset = reader.read_position % RING_CAPACITY;
+    shm_record_t record;
+    memcpy(&record, data + offset, sizeof(record));
+    bool valid = (record.type == shm_record_t::SKIP) ||
+      (record.type == shm_record_t::DATA && record.size <= Receiver::MAX_FRAME_SIZE &&
+       offset + sizeof(record) + record.size <= RING_CAPACITY);
+    if (valid && record.type == shm_record_t::DATA) {
+      memcpy(frame.payload, data + offset + sizeof(record), record.size);
+    }
+
+    // The record is valid only if no writer has reached it during the copy
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (valid == false || ring->reserve_position.load(std::memory_order_relaxed) - reader.read_position > RING_CAPACITY) {
+      _overrun_count++;
+      reader.read_position = ring->commit_position.load(std::memory_order_acquire);
+      break;
+    }
+
+    if (record.type == shm_record_t::SKIP) {
+      reader.read_position += sizeof(record) + record.size;
+      continue;
+    }
+    reader.read_position += shm_record_size(record.size);
+
+    frame.size = record.size;
+    if (_receiver_set.is_datagram_info_enabled()) {
+      ed247_datagram_info_t& info = _receiver_set.get_datagram_info();
+      ed247_get_receive_timestamp(&info.timestamp);
+      info.source_ip = ntohl(record.source_ip);
+      info.source_port = ntohs(record.source_port);
+      info.destination_ip = ntohl(reader.receiver->get_socket_address().sin_addr.s_addr);
+      info.destination_port = ntohs(reader.receiver->get_socket_address().sin_port);
+    }
+    PRINT_CRAZY("Shared memory received frame of " << frame.size << " bytes on " << reader.receiver->get_socket_address());
+    reader.receiver->deliver_frame(frame.payload, frame.size);
+    frame_count++;
+  }
+  return frame_count;
+}
+
+ed247_status_t ed247::udp::ShmTransport::wait_frame(int32_t timeout_us)
+{
+  uint64_t deadline_us = get_monotonic_time_us() + (timeout_us > 0? timeout_us : 0);
+
+  while (true) {
+    uint32_t sequence = _doorbell->sequence.load(std::memory_order_seq_cst);
+    uint32_t frame_count = 0;
+    for (reader_t& reader : _readers) {
+      frame_count += read_frames(reader);
+    }
+    if (frame_count != 0) return ED247_STATUS_SUCCESS;
+    if (timeout_us == 0) return ED247_STATUS_TIMEOUT;
+
+    struct timespec timeout;
+    if (timeout_us > 0) {
+      uint64_t now_us = get_monotonic_time_us();
+      if (now_us >= deadline_us) return ED247_STATUS_TIMEOUT;
+      timeout.tv_sec = (deadline_us - now_us) / 1000000;
+      timeout.tv_nsec = ((deadline_us - now_us) % 1000000) * 1000;
+    }
+
+    // A writer either sees the waiter or has changed the sequence before the wait
+    _doorbell->waiter_count.fetch_add(1, std::memory_order_seq_cst);
+    if (_doorbell->sequence.load(std::memory_order_seq_cst) == sequence) {
+      futex(&_doorbell->sequence, FUTEX_WAIT, sequence, timeout_us > 0? &timeout : nullptr);
+    }
+    _doorbell->waiter_count.fetch_sub(1, std::memory_order_seq_cst);
+  }
+}
+#endif
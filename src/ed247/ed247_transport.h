@@ -0,0 +1,165 @@
+/* -*- mode: c++; c-basic-offset: 2 -*-  */
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef _ED247_TRANSPORT_H_
+#define _ED247_TRANSPORT_H_
+#include "ed247_cominterface.h"
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ed247 {
+  namespace udp {
+
+    //
+    // Transport of the frames that replaces the UDP sockets (see ed247_set_transport())
+    // A transport belongs to the ReceiverSet of a context. The ECIC UdpSockets keep their
+    // addresses: an emitter sends to its destination address and the transport delivers
+    // the frame to the receivers of this address.
+    //
+    class FrameTransport
+    {
+    public:
+      virtual ~FrameTransport() {}
+
+      // Register a receiver of the context. The receivers are unregistered by the destructor.
+      virtual void add_receiver(Receiver* receiver) = 0;
+
+      // Send a frame to destination. May be called from another thread than wait_frame()
+      // (asynchronous sender). Return false on failure.
+      virtual bool send_frame(const socket_address_t& source, const socket_address_t& destination,
+                              const void* payload, uint32_t payload_size) = 0;
+
+      // Same semantic as ReceiverSet::wait_frame()
+      virtual ed247_status_t wait_frame(int32_t timeout_us) = 0;
+    };
+
+    //
+    // In-process loopback transport
+    // The receivers are subscribed to a bus global to the process. A sent frame is copied in
+    // the queue of each context that has a receiver on the destination address (or on
+    // INADDR_ANY with the same port). Each queue is delivered by the wait_frame() of its context.
+    //
+    class LoopbackTransport : public FrameTransport
+    {
+    public:
+      // Frames exceeding this amount of pending bytes are dropped (as by a full socket buffer)
+      static const uint32_t MAX_PENDING_BYTES = 8 * 1024 * 1024;
+
+      LoopbackTransport(ReceiverSet& receiver_set);
+      ~LoopbackTransport();
+
+      LoopbackTransport(const LoopbackTransport&) = delete;
+      LoopbackTransport& operator=(const LoopbackTransport&) = delete;
+
+      virtual void add_receiver(Receiver* receiver) override;
+      virtual bool send_frame(const socket_address_t& source, const socket_address_t& destination,
+                              const void* payload, uint32_t payload_size) override;
+      virtual ed247_status_t wait_frame(int32_t timeout_us) override;
+
+      // Copy a frame in the queue (called by the bus)
+      void queue_frame(Receiver* receiver, const socket_address_t& source, const void* payload, uint32_t payload_size);
+
+    private:
+      struct frame_t {
+        Receiver*         receiver;
+        socket_address_t  source{"", 0};
+        std::vector<char> payload;
+      };
+
+      ReceiverSet&            _receiver_set;
+      std::vector<Receiver*>  _receivers;
+
+      // Protected by _mutex. The payload buffers of the delivered frames are kept in _spare_frames.
+      std::mutex              _mutex;
+      std::condition_variable _frame_queued;
+      std::vector<frame_t>    _pending_frames;
+      std::vector<frame_t>    _spare_frames;
+      uint64_t                _pending_bytes{0};
+      uint64_t                _dropped_frame_count{0};
+
+      // Only used by wait_frame()
+      std::vector<frame_t>    _delivered_frames;
+    };
+
+#ifdef __linux__
+    //
+    // Shared memory transport (Linux)
+    // Each address has a ring in /dev/shm (ed247_<ip>_<port>) shared by all the processes of the host.
+    // The emitters append their frames to the ring of their destination address. The writers of a ring
+    // are serialized by a robust process-shared mutex. The readers are lock-free: each transport has its
+    // own read position in the rings of its receivers and discards the records overwritten while they
+    // were read. A reader late by more than the ring capacity loses the overwritten frames.
+    // The blocked readers are woken up through a futex shared by all the rings (the doorbell), only
+    // when there is a waiter.
+    //
+    class ShmTransport : public FrameTransport
+    {
+    public:
+      static const uint32_t RING_CAPACITY = 1024 * 1024;
+
+      ShmTransport(ReceiverSet& receiver_set);
+      ~ShmTransport();
+
+      ShmTransport(const ShmTransport&) = delete;
+      ShmTransport& operator=(const ShmTransport&) = delete;
+
+      virtual void add_receiver(Receiver* receiver) override;
+      virtual bool send_frame(const socket_address_t& source, const socket_address_t& destination,
+                              const void* payload, uint32_t payload_size) override;
+      virtual ed247_status_t wait_frame(int32_t timeout_us) override;
+
+      // Shared memory layouts (defined in ed247_transport.cpp)
+      struct ring_t;
+      struct doorbell_t;
+
+    private:
+      struct reader_t {
+        ring_t*   ring;
+        Receiver* receiver;
+        uint64_t  read_position;
+      };
+
+      // Map the ring of address. _rings_mutex shall be locked.
+      ring_t* open_ring(const socket_address_t& address);
+
+      // Deliver the frames of the ring written since the last call. Return the number of frames.
+      uint32_t read_frames(reader_t& reader);
+
+      using ring_map_t = std::unordered_map<socket_address_t, ring_t*, socket_address_hash, socket_address_equal_to>;
+
+      ReceiverSet&          _receiver_set;
+      doorbell_t*           _doorbell{nullptr};
+      std::mutex            _rings_mutex;    // The emitters may send from the asynchronous sender thread
+      ring_map_t            _rings;
+      std::vector<reader_t> _readers;
+      uint64_t              _overrun_count{0};
+    };
+#endif
+
+  }
+}
+
+#endif
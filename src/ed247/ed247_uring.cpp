@@ -0,0 +1,274 @@
+/* -*- mode: c++; c-basic-offset: 2 -*-  */
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include "ed247_uring.h"
+#include "ed247_time.h"
+#include "ed247_logs.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+ed247::udp::UringEngine::UringEngine() :
+  _buffer_ring(nullptr),
+  _buffers((size_t)RECV_BUFFER_COUNT * RECV_BUFFER_SIZE),
+  _send_slots(SEND_SLOT_COUNT)
+{
+  int result = io_uring_queue_init(RING_ENTRIES, &_ring, 0);
+  if (result < 0) {
+    THROW_ED247_ERROR("io_uring: failed to create the ring (" << strerror(-result) << ")");
+  }
+
+  _buffer_ring = io_uring_setup_buf_ring(&_ring, RECV_BUFFER_COUNT, BUFFER_GROUP, 0, &result);
+  if (_buffer_ring == nullptr) {
+    io_uring_queue_exit(&_ring);
+    THROW_ED247_ERROR("io_uring: failed to register the receive buffers (" << strerror(-result) << ")");
+  }
+  for (uint16_t buffer_id = 0; buffer_id < RECV_BUFFER_COUNT; buffer_id++) {
+    io_uring_buf_ring_add(_buffer_ring, _buffers.data() + (size_t)buffer_id * RECV_BUFFER_SIZE, RECV_BUFFER_SIZE,
+                          buffer_id, io_uring_buf_ring_mask(RECV_BUFFER_COUNT), buffer_id);
+  }
+  io_uring_buf_ring_advance(_buffer_ring, RECV_BUFFER_COUNT);
+
+  memset(&_recv_msg, 0, sizeof(_recv_msg));
+
+  for (uint32_t slot_index = 0; slot_index < SEND_SLOT_COUNT; slot_index++) {
+    _free_send_slots.push_back(slot_index);
+  }
+
+  MEMCHECK_NEW(this, "udp::UringEngine");
+}
+
+ed247::udp::UringEngine::~UringEngine()
+{
+  io_uring_free_buf_ring(&_ring, _buffer_ring, RECV_BUFFER_COUNT, BUFFER_GROUP);
+  io_uring_queue_exit(&_ring);
+  MEMCHECK_DEL(this, "udp::UringEngine");
+}
+
+bool ed247::udp::UringEngine::is_enabled()
+{
+  const char* env_enable = getenv(ENV_VAR_ENABLE);
+  return env_enable != nullptr && strcmp(env_enable, "1") == 0;
+}
+
+io_uring_sqe* ed247::udp::UringEngine::get_sqe()
+{
+  io_uring_sqe* sqe = io_uring_get_sqe(&_ring);
+  if (sqe == nullptr) {
+    // Submission queue is full
+    io_uring_submit(&_ring);
+    sqe = io_uring_get_sqe(&_ring);
+  }
+  if (sqe == nullptr) {
+    THROW_ED247_ERROR("io_uring: submission queue is full");
+  }
+  return sqe;
+}
+
+void ed247::udp::UringEngine::add_receiver(Receiver* receiver)
+{
+  // Only the first receiver of each address is added (see ReceiverSet::emplace()): it dispatches
+  // the frames of the system socket to the other receivers of the address.
+  _receivers.push_back(receiver);
+  arm_receiver(_receivers.size() - 1);
+}
+
+void ed247::udp::UringEngine::arm_receiver(uint32_t receiver_index)
+{
+  io_uring_sqe* sqe = get_sqe();
+  io_uring_prep_recvmsg_multishot(sqe, _receivers[receiver_index]->get_socket(), &_recv_msg, 0);
+  sqe->flags |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group = BUFFER_GROUP;
+  io_uring_sqe_set_data64(sqe, receiver_index);
+}
+
+void ed247::udp::UringEngine::queue_send(ed247_socket_t socket, const socket_address_t& destination,
+                                         const void* payload, uint32_t payload_size)
+{
+  PRINT_CRAZY("io_uring: queue sendmsg() to (" << destination << "), size " << payload_size << "b");
+
+  while (_free_send_slots.empty()) {
+    // Wait for the completion of a previous send
+    io_uring_submit_and_wait(&_ring, 1);
+    reap_completions();
+  }
+
+  uint32_t slot_index = _free_send_slots.back();
+  _free_send_slots.pop_back();
+
+  send_slot_t& slot = _send_slots[slot_index];
+  slot.payload.assign((const char*)payload, (const char*)payload + payload_size);
+  slot.destination = destination;
+  slot.iov.iov_base = slot.payload.data();
+  slot.iov.iov_len = payload_size;
+  memset(&slot.msg, 0, sizeof(slot.msg));
+  slot.msg.msg_name = &slot.destination;
+  slot.msg.msg_namelen = sizeof(sockaddr_in);
+  slot.msg.msg_iov = &slot.iov;
+  slot.msg.msg_iovlen = 1;
+
+  io_uring_sqe* sqe = get_sqe();
+  io_uring_prep_sendmsg(sqe, socket, &slot.msg, 0);
+  io_uring_sqe_set_data64(sqe, SEND_TAG | slot_index);
+}
+
+void ed247::udp::UringEngine::submit()
+{
+  int result = io_uring_submit(&_ring);
+  if (result < 0) {
+    PRINT_ERROR("io_uring: failed to submit the requests (" << strerror(-result) << ")");
+  }
+  reap_completions();
+}
+
+void ed247::udp::UringEngine::stop()
+{
+  // The receivers already disarmed have no request in flight
+  for (uint32_t receiver_index = 0; receiver_index < _receivers.size(); receiver_index++) {
+    if (std::find(_disarmed_receivers.begin(), _disarmed_receivers.end(), receiver_index) != _disarmed_receivers.end()) continue;
+    io_uring_sqe* sqe = get_sqe();
+    io_uring_prep_cancel64(sqe, receiver_index, 0);
+    io_uring_sqe_set_data64(sqe, CANCEL_TAG);
+  }
+
+  while (_free_send_slots.size() != SEND_SLOT_COUNT || _disarmed_receivers.size() != _receivers.size()) {
+    int result = io_uring_submit_and_wait(&_ring, 1);
+    if (result < 0 && result != -EINTR) {
+      PRINT_ERROR("io_uring: failed to wait for the pending requests (" << strerror(-result) << ")");
+      break;
+    }
+    reap_completions();
+  }
+
+  // Do not arm the receivers again
+  _disarmed_receivers.clear();
+  deliver_frames();
+}
+
+void ed247::udp::UringEngine::reap_completions()
+{
+  io_uring_cqe* cqe;
+  unsigned head;
+  unsigned count = 0;
+
+  io_uring_for_each_cqe(&_ring, head, cqe) {
+    count++;
+    uint64_t user_data = io_uring_cqe_get_data64(cqe);
+
+    if (user_data == CANCEL_TAG) continue;
+
+    if (user_data & SEND_TAG) {
+      uint32_t slot_index = (uint32_t)(user_data & ~SEND_TAG);
+      if (cqe->res < 0 || (size_t)cqe->res != _send_slots[slot_index].iov.iov_len) {
+        PRINT_ERROR("Failed to send frame to [" << _send_slots[slot_index].destination << "] ("
+                    << (cqe->res < 0 ? strerror(-cqe->res) : "partial send") << ")");
+      }
+      _free_send_slots.push_back(slot_index);
+      continue;
+    }
+
+    Receiver* receiver = _receivers[user_data];
+    if (cqe->flags & IORING_CQE_F_BUFFER) {
+      uint16_t buffer_id = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+      char* buffer = _buffers.data() + (size_t)buffer_id * RECV_BUFFER_SIZE;
+      io_uring_recvmsg_out* out = (cqe->res >= 0) ? io_uring_recvmsg_validate(buffer, cqe->res, &_recv_msg) : nullptr;
+      if (out == nullptr || (out->flags & MSG_TRUNC)) {
+        PRINT_ERROR("recvmsg() failed on socket " << receiver->get_socket() << ": invalid or truncated frame");
+        _received_frames.push_back(received_frame_t{ nullptr, buffer_id, nullptr, 0 });
+      } else {
+        _received_frames.push_back(received_frame_t{
+            receiver, buffer_id,
+            (char*)io_uring_recvmsg_payload(out, &_recv_msg),
+            io_uring_recvmsg_payload_length(out, cqe->res, &_recv_msg) });
+      }
+    } else if (cqe->res < 0 && cqe->res != -ENOBUFS && cqe->res != -ECANCELED) {
+      PRINT_ERROR("recvmsg() failed on socket " << receiver->get_socket() << " (" << strerror(-cqe->res) << ")");
+    }
+
+    // The multishot request is over (no more buffers or error): arm it again once the buffers are delivered
+    if ((cqe->flags & IORING_CQE_F_MORE) == 0) {
+      _disarmed_receivers.push_back(user_data);
+    }
+  }
+
+  io_uring_cq_advance(&_ring, count);
+}
+
+void ed247::udp::UringEngine::deliver_frames()
+{
+  // The receive callbacks may queue sends, thus reap completions: iterate by index
+  for (size_t index = 0; index < _received_frames.size(); index++) {
+    received_frame_t frame = _received_frames[index];
+    if (frame.receiver != nullptr) {
+      PRINT_CRAZY("Received frame of " << frame.size << " bytes: [" << hex_stream(frame.payload, frame.size) << "]");
+      frame.receiver->deliver_frame(frame.payload, frame.size);
+    }
+    io_uring_buf_ring_add(_buffer_ring, _buffers.data() + (size_t)frame.buffer_id * RECV_BUFFER_SIZE, RECV_BUFFER_SIZE,
+                          frame.buffer_id, io_uring_buf_ring_mask(RECV_BUFFER_COUNT), 0);
+    io_uring_buf_ring_advance(_buffer_ring, 1);
+  }
+  _received_frames.clear();
+
+  for (uint32_t receiver_index : _disarmed_receivers) {
+    arm_receiver(receiver_index);
+  }
+  _disarmed_receivers.clear();
+}
+
+ed247_status_t ed247::udp::UringEngine::wait_frame(int32_t timeout_us)
+{
+  PRINT_CRAZY("io_uring: Waiting for first frame to be received");
+
+  uint64_t end_us = get_monotonic_time_us() + (timeout_us > 0 ? timeout_us : 0);
+
+  while (true) {
+    bool has_frames = _received_frames.empty() == false;
+    __kernel_timespec timeout;
+    if (timeout_us >= 0 || has_frames) {
+      uint64_t now_us = get_monotonic_time_us();
+      uint64_t remaining_us = (has_frames || now_us >= end_us) ? 0 : end_us - now_us;
+      timeout.tv_sec = remaining_us / 1000000;
+      timeout.tv_nsec = (remaining_us % 1000000) * 1000;
+    }
+
+    io_uring_cqe* cqe;
+    int result = io_uring_submit_and_wait_timeout(&_ring, &cqe, 1, (timeout_us >= 0 || has_frames) ? &timeout : nullptr, nullptr);
+    if (result < 0 && result != -ETIME && result != -EINTR) {
+      PRINT_ERROR("io_uring: failed to wait for completions (" << strerror(-result) << ")");
+      return ED247_STATUS_FAILURE;
+    }
+    reap_completions();
+
+    if (_received_frames.empty() == false) {
+      deliver_frames();
+      return ED247_STATUS_SUCCESS;
+    }
+    if (_disarmed_receivers.empty() == false) {
+      deliver_frames();
+    }
+    if (timeout_us >= 0 && get_monotonic_time_us() >= end_us) {
+      return ED247_STATUS_TIMEOUT;
+    }
+  }
+}
@@ -0,0 +1,115 @@
+/* -*- mode: c++; c-basic-offset: 2 -*-  */
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#ifndef _ED247_URING_H_
+#define _ED247_URING_H_
+#include "ed247_cominterface.h"
+#include <liburing.h>
+#include <vector>
+
+namespace ed247 {
+  namespace udp {
+
+    //
+    // io_uring engine of the UDP transport (Linux, built when liburing is available)
+    // - Each receiver socket has a multishot recvmsg. The frames are received in the buffers
+    //   of a provided buffer ring shared by all the receivers.
+    // - Sent frames are queued as sendmsg requests and submitted all together by submit() or
+    //   by the next wait_frame(): a single io_uring_enter() serves the network I/O of a cycle.
+    // Received frames are only delivered to the receivers by wait_frame().
+    //
+    class UringEngine
+    {
+    public:
+      // The engine is opt-in: set this env variable to "1" to use it instead of select()/recvfrom()/sendto().
+      static constexpr const char* ENV_VAR_ENABLE = "ED247_IO_URING";
+
+      // Throw if io_uring cannot be set up (old kernel, restricted system calls...)
+      UringEngine();
+      ~UringEngine();
+
+      UringEngine(const UringEngine&) = delete;
+      UringEngine& operator=(const UringEngine&) = delete;
+
+      // Return false if the engine is disabled by the environment
+      static bool is_enabled();
+
+      void add_receiver(Receiver* receiver);
+
+      // Copy the frame in a send slot and queue its sendmsg request
+      void queue_send(ed247_socket_t socket, const socket_address_t& destination, const void* payload, uint32_t payload_size);
+
+      // Submit the queued requests
+      void submit();
+
+      // Submit the queued sends, cancel the receive requests and wait for all the requests to complete,
+      // then deliver the frames received meanwhile. Called before the engine is replaced by another one.
+      void stop();
+
+      // Same semantic as ReceiverSet::wait_frame()
+      ed247_status_t wait_frame(int32_t timeout_us);
+
+    private:
+      static const uint32_t RING_ENTRIES      = 256;
+      static const uint32_t RECV_BUFFER_COUNT = 32;    // Shall be a power of 2
+      static const uint32_t RECV_BUFFER_SIZE  = sizeof(io_uring_recvmsg_out) + Receiver::MAX_FRAME_SIZE;
+      static const uint32_t SEND_SLOT_COUNT   = 64;
+      static const int      BUFFER_GROUP      = 0;
+      static const uint64_t SEND_TAG          = 1ULL << 63;   // user_data of send requests
+      static const uint64_t CANCEL_TAG        = 1ULL << 62;   // user_data of cancel requests
+
+      struct send_slot_t {
+        msghdr            msg;
+        iovec             iov;
+        socket_address_t  destination{"", 0};
+        std::vector<char> payload;
+      };
+
+      struct received_frame_t {
+        Receiver* receiver;
+        uint16_t  buffer_id;
+        char*     payload;
+        uint32_t  size;
+      };
+
+      io_uring_sqe* get_sqe();
+      void arm_receiver(uint32_t receiver_index);
+      void reap_completions();
+      void deliver_frames();
+
+      io_uring                      _ring;
+      io_uring_buf_ring*            _buffer_ring;
+      std::vector<char>             _buffers;
+      msghdr                        _recv_msg;         // No name nor control data
+      std::vector<Receiver*>        _receivers;        // Index is the user_data of the recvmsg request
+      std::vector<uint32_t>         _disarmed_receivers;
+      std::vector<received_frame_t> _received_frames;  // Reaped but not yet delivered
+      std::vector<send_slot_t>      _send_slots;
+      std::vector<uint32_t>         _free_send_slots;
+    };
+
+  }
+}
+
+#endif
@@ -26,7 +26,12 @@
 #include "ed247_logs.h"
 #include "ed247_xsd.h"
 #include <libxml/xmlschemas.h>
+#include <libxml/xmlreader.h>
 #include <algorithm>
+#include <limits>
+#include <fstream>
+#include <mutex>
+#include <unordered_set>
 
 /*
  * ECIC Nodes and attributes
@@ -323,7 +328,7 @@ void ed247::xml::UdpSocket::load(const xmlNodePtr xml_node)
   }
 }
 
-std::ostream& operator<<(std::ostream& stream, const ed247::xml::UdpSocket& socket)
+std::ostream& ed247::xml::operator<<(std::ostream& stream, const ed247::xml::UdpSocket& socket)
 {
   return stream << "UdpSocket - "
     "DstIP[" << socket._dst_ip_address << "] DstPort[" << socket._dst_ip_port<< "] "
@@ -1242,8 +1247,27 @@ ed247::xml::Channel::Channel() :
 
 void ed247::xml::Channel::load(const xmlNodePtr xml_node)
 {
-  ed247_direction_t streams_direction(ED247_DIRECTION__INVALID);
+  load_attributes(xml_node);
+
+  for(auto xml_node_iter = xml_node->children ; xml_node_iter != nullptr ; xml_node_iter = xml_node_iter->next){
+    if(xml_node_iter->type != XML_ELEMENT_NODE)
+      continue;
+    if(is_streams_node(::xml::xmlChar_as_string(xml_node_iter->name))) {
+      for(auto xml_node_child_iter = xml_node_iter->children ; xml_node_child_iter != nullptr ; xml_node_child_iter = xml_node_child_iter->next){
+        if(xml_node_child_iter->type != XML_ELEMENT_NODE)
+          continue;
+        load_stream(xml_node_child_iter);
+      }
+    }else{
+      load_element(xml_node_iter);
+    }
+  }
 
+  consolidate(xml_node);
+}
+
+void ed247::xml::Channel::load_attributes(const xmlNodePtr xml_node)
+{
   for(auto xml_attr = xml_node->properties ; xml_attr != nullptr ; xml_attr = xml_attr->next){
     auto attr_name = ::xml::xmlChar_as_string(xml_attr->name);
     if(attr_name.compare(attr::Name) == 0){
@@ -1254,87 +1278,83 @@ void ed247::xml::Channel::load(const xmlNodePtr xml_node)
       THROW_PARSER_ERROR(xml_node, "Unknown attribute [" << attr_name << "] in tag [" << node::MultiChannel << "] or [" << node::Channel << "]");
     }
   }
+}
 
-  for(auto xml_node_iter = xml_node->children ; xml_node_iter != nullptr ; xml_node_iter = xml_node_iter->next){
-    if(xml_node_iter->type != XML_ELEMENT_NODE)
-      continue;
-    auto node_name = ::xml::xmlChar_as_string(xml_node_iter->name);
-    if(node_name.compare(node::ComInterface) == 0){
-      _com_interface.load(xml_node_iter);
-    }else if(node_name.compare(node::Header) == 0){
-      _header.load(xml_node_iter);
-    }else if(node_name.compare(node::FrameFormat) == 0){
-      for(auto xml_attr = xml_node_iter->properties ; xml_attr != nullptr ; xml_attr = xml_attr->next){
-        auto attr_name = ::xml::xmlChar_as_string(xml_attr->name);
-        if(attr_name.compare(attr::StandardRevision) == 0){
-          ::xml::xmlAttr_get_value( xml_attr, _frame_standard_revision);
-        }else{
-          THROW_PARSER_ERROR(xml_node_iter, "Unknown attribute [" << attr_name << "] in tag [" << node::FrameFormat <<"]");
-        }
-      }
-    }
-    else if((_is_simple_channel == false && node_name.compare(node::Streams) == 0) ||
-            (_is_simple_channel == true  && node_name.compare(node::Stream) == 0))
-    {
-      for(auto xml_node_child_iter = xml_node_iter->children ; xml_node_child_iter != nullptr ; xml_node_child_iter = xml_node_child_iter->next){
-        if(xml_node_child_iter->type != XML_ELEMENT_NODE)
-          continue;
-        node_name = ::xml::xmlChar_as_string(xml_node_child_iter->name);
-        // A429
-        if(node_name.compare(node::A429_Stream) == 0){
-          A429Stream* stream = new A429Stream();
-          stream->load(xml_node_child_iter);
-          _stream_list.emplace_back(stream);
-          // A664
-        }else if(node_name.compare(node::A664_Stream) == 0){
-          A664Stream* stream = new A664Stream();
-          stream->load(xml_node_child_iter);
-          _stream_list.emplace_back(stream);
-          // A825
-        }else if(node_name.compare(node::A825_Stream) == 0){
-          A825Stream* stream = new A825Stream();
-          stream->load(xml_node_child_iter);
-          _stream_list.emplace_back(stream);
-          // SERIAL
-        }else if(node_name.compare(node::SERIAL_Stream) == 0){
-          SERIALStream* stream = new SERIALStream();
-          stream->load(xml_node_child_iter);
-          _stream_list.emplace_back(stream);
-          // DISCRETE
-        }else if(node_name.compare(node::DIS_Stream) == 0){
-          DISStream* stream = new DISStream();
-          stream->load(xml_node_child_iter);
-          _stream_list.emplace_back(stream);
-          // ANALOG
-        }else if(node_name.compare(node::ANA_Stream) == 0){
-          ANAStream* stream = new ANAStream();
-          stream->load(xml_node_child_iter);
-          _stream_list.emplace_back(stream);
-          // NAD
-        }else if(node_name.compare(node::NAD_Stream) == 0){
-          NADStream* stream = new NADStream();
-          stream->load(xml_node_child_iter);
-          _stream_list.emplace_back(stream);
-          // VNAD
-        }else if(node_name.compare(node::VNAD_Stream) == 0){
-          VNADStream* stream = new VNADStream();
-          stream->load(xml_node_child_iter);
-          _stream_list.emplace_back(stream);
-          //ETH
-        }else if(node_name.compare(node::ETH_Stream) == 0){
-          ETHStream* stream = new ETHStream();
-          stream->load(xml_node_child_iter);
-          _stream_list.emplace_back(stream);
-          // Otherwise
-        }else{
-          THROW_PARSER_ERROR(xml_node_child_iter, "Unknown node [" << node_name << "] in tag [" << node::Streams << "]");
-        }
-        streams_direction = (ed247_direction_t)(streams_direction | _stream_list.back()->_direction);
-        _stream_list.back()->validate(xml_node_child_iter);
+bool ed247::xml::Channel::is_streams_node(const std::string& node_name) const
+{
+  return ((_is_simple_channel == false && node_name.compare(node::Streams) == 0) ||
+          (_is_simple_channel == true  && node_name.compare(node::Stream) == 0));
+}
+
+void ed247::xml::Channel::load_element(const xmlNodePtr xml_node)
+{
+  auto node_name = ::xml::xmlChar_as_string(xml_node->name);
+  if(node_name.compare(node::ComInterface) == 0){
+    _com_interface.load(xml_node);
+  }else if(node_name.compare(node::Header) == 0){
+    _header.load(xml_node);
+  }else if(node_name.compare(node::FrameFormat) == 0){
+    for(auto xml_attr = xml_node->properties ; xml_attr != nullptr ; xml_attr = xml_attr->next){
+      auto attr_name = ::xml::xmlChar_as_string(xml_attr->name);
+      if(attr_name.compare(attr::StandardRevision) == 0){
+        ::xml::xmlAttr_get_value( xml_attr, _frame_standard_revision);
+      }else{
+        THROW_PARSER_ERROR(xml_node, "Unknown attribute [" << attr_name << "] in tag [" << node::FrameFormat <<"]");
       }
-    }else{
-      THROW_PARSER_ERROR(xml_node_iter, "Unexpected node [" << node_name << "]");
     }
+  }else{
+    THROW_PARSER_ERROR(xml_node, "Unexpected node [" << node_name << "]");
+  }
+}
+
+void ed247::xml::Channel::load_stream(const xmlNodePtr xml_node)
+{
+  auto node_name = ::xml::xmlChar_as_string(xml_node->name);
+  Stream* stream = nullptr;
+  // A429
+  if(node_name.compare(node::A429_Stream) == 0){
+    stream = new A429Stream();
+    // A664
+  }else if(node_name.compare(node::A664_Stream) == 0){
+    stream = new A664Stream();
+    // A825
+  }else if(node_name.compare(node::A825_Stream) == 0){
+    stream = new A825Stream();
+    // SERIAL
+  }else if(node_name.compare(node::SERIAL_Stream) == 0){
+    stream = new SERIALStream();
+    // DISCRETE
+  }else if(node_name.compare(node::DIS_Stream) == 0){
+    stream = new DISStream();
+    // ANALOG
+  }else if(node_name.compare(node::ANA_Stream) == 0){
+    stream = new ANAStream();
+    // NAD
+  }else if(node_name.compare(node::NAD_Stream) == 0){
+    stream = new NADStream();
+    // VNAD
+  }else if(node_name.compare(node::VNAD_Stream) == 0){
+    stream = new VNADStream();
+    //ETH
+  }else if(node_name.compare(node::ETH_Stream) == 0){
+    stream = new ETHStream();
+    // Otherwise
+  }else{
+    THROW_PARSER_ERROR(xml_node, "Unknown node [" << node_name << "] in tag [" << node::Streams << "]");
+  }
+  _stream_list.emplace_back(stream);
+  stream->load(xml_node);
+  stream->validate(xml_node);
+}
+
+void ed247::xml::Channel::consolidate(const xmlNodePtr closest_node)
+{
+  if(_frame_standard_revision != ED247_STANDARD_ED247A)
+    THROW_PARSER_ERROR(closest_node, "This version do not support any other standard than [" << std::string(ed247_standard_string(ED247_STANDARD_ED247A)) << "]");
+
+  ed247_direction_t streams_direction(ED247_DIRECTION__INVALID);
+  for (std::unique_ptr<Stream>& stream : _stream_list) {
+    streams_direction = (ed247_direction_t)(streams_direction | stream->_direction);
   }
 
   //
@@ -1346,7 +1366,7 @@ void ed247::xml::Channel::load(const xmlNodePtr xml_node)
   for(UdpSocket& udp_socket : _com_interface._udp_sockets) {
     if (udp_socket._direction == ED247_DIRECTION__INVALID) {
       if (streams_direction == ED247_DIRECTION__INVALID || streams_direction == ED247_DIRECTION_INOUT)
-        THROW_PARSER_ERROR(xml_node, "Cannot decide UdpSocket " << udp_socket._dst_ip_address << ":" <<
+        THROW_PARSER_ERROR(closest_node, "Cannot decide UdpSocket " << udp_socket._dst_ip_address << ":" <<
                            udp_socket._dst_ip_port << " direction for channel " << _name);
       udp_socket._direction = streams_direction;
     }
@@ -1365,11 +1385,11 @@ void ed247::xml::Channel::load(const xmlNodePtr xml_node)
   // Warn if some streams are not able to communicate
   if (((streams_direction       & ED247_DIRECTION_IN) != 0) &&
       ((com_interface_direction & ED247_DIRECTION_IN) == 0))
-    PARSER_WARNING(xml_node, "Channel " << _name << " has input streams without input UdpSockets.");
+    PARSER_WARNING(closest_node, "Channel " << _name << " has input streams without input UdpSockets.");
 
   if (((streams_direction       & ED247_DIRECTION_OUT) != 0) &&
       ((com_interface_direction & ED247_DIRECTION_OUT) == 0))
-    PARSER_WARNING(xml_node, "Channel " << _name << " has output streams without output UdpSockets.");
+    PARSER_WARNING(closest_node, "Channel " << _name << " has output streams without output UdpSockets.");
 }
 
 //
@@ -1383,6 +1403,28 @@ ed247::xml::Component::Component() :
 }
 
 void ed247::xml::Component::load(const xmlNodePtr xml_node)
+{
+  load_attributes(xml_node);
+
+  for(auto xml_node_iter = xml_node->children ; xml_node_iter != nullptr ; xml_node_iter = xml_node_iter->next){
+    if(xml_node_iter->type != XML_ELEMENT_NODE)
+      continue;
+    auto node_name = ::xml::xmlChar_as_string(xml_node_iter->name);
+    if(node_name.compare(node::Channels) == 0){
+      for(auto xml_node_channel = xml_node_iter->children ; xml_node_channel != nullptr ; xml_node_channel = xml_node_channel->next){
+        if(xml_node_channel->type != XML_ELEMENT_NODE)
+          continue;
+        add_channel(xml_node_channel).load(xml_node_channel);
+      }
+    }else if(node_name.compare(node::FileProducer) == 0){
+      load_file_producer(xml_node_iter);
+    }else{
+      THROW_PARSER_ERROR(xml_node_iter, "Unknown node [" << node_name << "] in tag [" << node::ED247ComponentInstanceConfiguration << "]");
+    }
+  }
+}
+
+void ed247::xml::Component::load_attributes(const xmlNodePtr xml_node)
 {
   for(auto xml_attr = xml_node->properties ; xml_attr != nullptr ; xml_attr = xml_attr->next){
     auto attr_name = ::xml::xmlChar_as_string(xml_attr->name);
@@ -1406,77 +1448,214 @@ void ed247::xml::Component::load(const xmlNodePtr xml_node)
   }
   if(_standard_revision != ED247_STANDARD_ED247A)
     THROW_PARSER_ERROR(xml_node, "This version do not support any other standard than [" << std::string(ed247_standard_string(ED247_STANDARD_ED247A)) << "]");
+}
 
-  for(auto xml_node_iter = xml_node->children ; xml_node_iter != nullptr ; xml_node_iter = xml_node_iter->next){
-    if(xml_node_iter->type != XML_ELEMENT_NODE)
-      continue;
-    auto node_name = ::xml::xmlChar_as_string(xml_node_iter->name);
-    if(node_name.compare(node::Channels) == 0){
-      for(auto xml_node_channel = xml_node_iter->children ; xml_node_channel != nullptr ; xml_node_channel = xml_node_channel->next){
-        if(xml_node_channel->type != XML_ELEMENT_NODE)
-          continue;
-        node_name = ::xml::xmlChar_as_string(xml_node_channel->name);
-        if(node_name.compare(node::MultiChannel) == 0) {
-          _channel_list.emplace_back();
-          Channel& channel = _channel_list.back();
-          channel._is_simple_channel = false; // store if it is a simple channel (only one stream)
-          channel.load(xml_node_channel);
-          if(channel._frame_standard_revision != ED247_STANDARD_ED247A)
-            THROW_PARSER_ERROR(xml_node_channel, "This version do not support any other standard than [" << std::string(ed247_standard_string(ED247_STANDARD_ED247A)) << "]");
-        }else if(node_name.compare(node::Channel) == 0) {
-          _channel_list.emplace_back();
-          Channel& channel = _channel_list.back();
-          channel._is_simple_channel = true; // store if it is a simple channel (only one stream)
-          channel.load(xml_node_channel);
-          if(channel._frame_standard_revision != ED247_STANDARD_ED247A)
-            THROW_PARSER_ERROR(xml_node_channel, "This version do not support any other standard than [" << std::string(ed247_standard_string(ED247_STANDARD_ED247A)) << "]");
-        }else{
-          THROW_PARSER_ERROR(xml_node_channel, "Unknown node [" << node_name << "] in tag [" << node::Channels << "]");
-        }
+void ed247::xml::Component::load_file_producer(const xmlNodePtr xml_node)
+{
+  for(auto xml_attr = xml_node->properties ; xml_attr != nullptr ; xml_attr = xml_attr->next){
+    auto attr_name = ::xml::xmlChar_as_string(xml_attr->name);
+    if(attr_name.compare(attr::Identifier) == 0){
+      ::xml::xmlAttr_get_value( xml_attr, _file_producer_identifier);
+    }else if(attr_name.compare(attr::Comment) == 0){
+      ::xml::xmlAttr_get_value( xml_attr, _file_producer_comment);
+    }else{
+      THROW_PARSER_ERROR(xml_node, "Unknown attribute [" << attr_name << "] in tag [" << node::FileProducer <<"]");
+    }
+  }
+}
+
+ed247::xml::Channel& ed247::xml::Component::add_channel(const xmlNodePtr xml_node)
+{
+  auto node_name = ::xml::xmlChar_as_string(xml_node->name);
+  if(node_name.compare(node::MultiChannel) != 0 && node_name.compare(node::Channel) != 0) {
+    THROW_PARSER_ERROR(xml_node, "Unknown node [" << node_name << "] in tag [" << node::Channels << "]");
+  }
+  _channel_list.emplace_back();
+  Channel& channel = _channel_list.back();
+  channel._is_simple_channel = (node_name.compare(node::Channel) == 0); // store if it is a simple channel (only one stream)
+  return channel;
+}
+
+void ed247::xml::Component::filter_streams(const stream_filter_t& filter)
+{
+  for (auto channel = _channel_list.begin(); channel != _channel_list.end();) {
+    ed247_direction_t streams_direction(ED247_DIRECTION__INVALID);
+    auto& stream_list = channel->_stream_list;
+    for (auto stream = stream_list.begin(); stream != stream_list.end();) {
+      if (filter(*channel, **stream)) {
+        streams_direction = (ed247_direction_t)(streams_direction | (*stream)->_direction);
+        stream++;
+      } else {
+        PRINT_DEBUG("Filter out stream [" << (*stream)->_name << "] of channel [" << channel->_name << "]");
+        stream = stream_list.erase(stream);
       }
-    }else if(node_name.compare(node::FileProducer) == 0){
-      for(auto xml_attr = xml_node_iter->properties ; xml_attr != nullptr ; xml_attr = xml_attr->next){
-        auto attr_name = ::xml::xmlChar_as_string(xml_attr->name);
-        if(attr_name.compare(attr::Identifier) == 0){
-          ::xml::xmlAttr_get_value( xml_attr, _file_producer_identifier);
-        }else if(attr_name.compare(attr::Comment) == 0){
-          ::xml::xmlAttr_get_value( xml_attr, _file_producer_comment);
-        }else{
-          THROW_PARSER_ERROR(xml_node_iter, "Unknown attribute [" << attr_name << "] in tag [" << node::FileProducer <<"]");
-        }
+    }
+
+    if (stream_list.empty()) {
+      PRINT_DEBUG("Filter out channel [" << channel->_name << "]");
+      channel = _channel_list.erase(channel);
+      continue;
+    }
+
+    // Directions have been consolidated at load time: a socket is needed if it shares a direction with a stream
+    auto& udp_sockets = channel->_com_interface._udp_sockets;
+    udp_sockets.erase(std::remove_if(udp_sockets.begin(), udp_sockets.end(),
+                                     [streams_direction](const UdpSocket& socket) {
+                                       return (socket._direction & streams_direction) == 0;
+                                     }),
+                      udp_sockets.end());
+    channel++;
+  }
+}
+
+//
+// Compiled schema
+//
+namespace {
+  // The XSD is embedded in the library: compile it once and share it between all loads.
+  // A compiled schema is read-only during validation, so it can be used by several
+  // threads at once as long as each load creates its own validation context.
+  std::mutex   schema_mutex;
+  xmlDocPtr    schema_doc = nullptr;
+  xmlSchemaPtr schema = nullptr;
+
+  xmlSchemaPtr get_compiled_schema()
+  {
+    std::lock_guard<std::mutex> lock(schema_mutex);
+    if (schema != nullptr) return schema;
+
+    xmlDocPtr              p_xsd_doc = nullptr;
+    xmlSchemaParserCtxtPtr p_xsd_schema_parser = nullptr;
+
+    try {
+      if((p_xsd_doc = xmlReadMemory(xsd_schema,(int)strlen(xsd_schema),nullptr,nullptr,0)) == nullptr)
+        THROW_PARSER_ERROR(nullptr, "Failed to load schema in memory");
+      if((p_xsd_schema_parser = xmlSchemaNewDocParserCtxt(p_xsd_doc)) == nullptr)
+        THROW_PARSER_ERROR(nullptr, "Failed to create schema parser");
+      if((schema = xmlSchemaParse(p_xsd_schema_parser)) == nullptr)
+        THROW_PARSER_ERROR(nullptr, "Failed to create schema");
+
+      xmlSchemaFreeParserCtxt(p_xsd_schema_parser);
+      // The schema may still reference its document: keep it as long as the schema
+      schema_doc = p_xsd_doc;
+      PRINT_DEBUG("ECIC schema compiled");
+      return schema;
+    }
+    catch (...) {
+      if (p_xsd_schema_parser) xmlSchemaFreeParserCtxt(p_xsd_schema_parser);
+      if (p_xsd_doc) xmlFreeDoc(p_xsd_doc);
+      throw;
+    }
+  }
+}
+
+//
+// Validation cache
+//
+namespace {
+  static constexpr const char* ENV_VAR_VALIDATION_CACHE = "ED247_ECIC_VALIDATION_CACHE";
+
+  // Hashes of the ECIC contents that have already been validated against the XSD.
+  // The hashes are persisted in a file so a later run can skip the validation.
+  std::mutex                   cache_mutex;
+  bool                         cache_initialized = false;
+  std::string                  cache_filepath;
+  std::unordered_set<uint64_t> cache_hashes;
+
+  // FNV-1a. The XSD is part of the key so a new schema invalidates the cache.
+  uint64_t content_hash(const char* data, size_t size)
+  {
+    static const uint64_t fnv_prime = 0x100000001b3ULL;
+    static const uint64_t schema_hash = [] {
+      uint64_t hash = 0xcbf29ce484222325ULL;
+      for (const char* c = xsd_schema; *c != '\0'; c++) {
+        hash = (hash ^ (uint8_t)*c) * fnv_prime;
       }
-    }else{
-      THROW_PARSER_ERROR(xml_node_iter, "Unknown node [" << node_name << "] in tag [" << node::ED247ComponentInstanceConfiguration << "]");
+      return hash;
+    }();
+    uint64_t hash = schema_hash;
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ (uint8_t)data[i]) * fnv_prime;
+    }
+    return hash;
+  }
+
+  // cache_mutex shall be locked
+  void cache_reset(const char* caller_filepath)
+  {
+    const char* env_filepath;
+#ifdef _MSC_VER
+    size_t len;
+    _dupenv_s(&env_filepath, &len, ENV_VAR_VALIDATION_CACHE);
+#else
+    env_filepath = getenv(ENV_VAR_VALIDATION_CACHE);
+#endif
+    const char* new_filepath = (env_filepath && *env_filepath)? env_filepath : caller_filepath;
+
+    cache_initialized = true;
+    cache_hashes.clear();
+    cache_filepath = (new_filepath != nullptr)? new_filepath : "";
+    if (cache_filepath.empty()) return;
+
+    std::ifstream cache_file(cache_filepath);
+    uint64_t hash;
+    while (cache_file >> std::hex >> hash) {
+      cache_hashes.insert(hash);
+    }
+    PRINT_DEBUG("ECIC validation cache '" << cache_filepath << "': " << cache_hashes.size() << " entries");
+  }
+
+  bool cache_enabled()
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (cache_initialized == false) cache_reset(nullptr);
+    return cache_filepath.empty() == false;
+  }
+
+  bool cache_contains(uint64_t hash)
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    return cache_hashes.find(hash) != cache_hashes.end();
+  }
+
+  void cache_insert(uint64_t hash)
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (cache_filepath.empty() || cache_hashes.insert(hash).second == false) return;
+
+    std::ofstream cache_file(cache_filepath, std::ios::app);
+    if (!(cache_file << std::hex << hash << std::endl)) {
+      PRINT_WARNING("Failed to update ECIC validation cache '" << cache_filepath << "'");
     }
   }
 }
 
+void ed247::xml::set_validation_cache(const char* filepath)
+{
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  cache_reset(filepath);
+}
+
 //
 // load
 //
-static std::unique_ptr<ed247::xml::Component> ed247_ecic_load(xmlParserCtxtPtr & p_xml_context, xmlDocPtr & p_xml_doc)
+// If hash is not null, the validation cache is used
+static std::unique_ptr<ed247::xml::Component> ed247_ecic_load(xmlDocPtr p_xml_doc, const uint64_t* hash)
 {
-  xmlDocPtr              p_xsd_doc = nullptr;
-  xmlSchemaParserCtxtPtr p_xsd_schema_parser = nullptr;
-  xmlSchemaPtr           p_xsd_schema = nullptr;
-  xmlSchemaValidCtxtPtr  p_xsd_valid_context = nullptr;
+  xmlSchemaValidCtxtPtr p_xsd_valid_context = nullptr;
 
   try {
-    // Parse XSD
-    if((p_xsd_doc = xmlCtxtReadMemory(p_xml_context,xsd_schema,(int)strlen(xsd_schema),nullptr,nullptr,0)) == nullptr)
-      THROW_PARSER_ERROR(nullptr, "Failed to load schema in memory");
-
-    // Validate XSD
-    if((p_xsd_schema_parser = xmlSchemaNewDocParserCtxt(p_xsd_doc)) == nullptr)
-      THROW_PARSER_ERROR(nullptr, "Failed to create schema parser");
-    if((p_xsd_schema = xmlSchemaParse(p_xsd_schema_parser)) == nullptr)
-      THROW_PARSER_ERROR(nullptr, "Failed to create schema");
-    if((p_xsd_valid_context = xmlSchemaNewValidCtxt(p_xsd_schema)) == nullptr)
-      THROW_PARSER_ERROR(nullptr, "Failed to validate schema context");
-
-    // Validate XML
-    if(xmlSchemaValidateDoc(p_xsd_valid_context, p_xml_doc) != 0)
-      THROW_PARSER_ERROR(nullptr, "Failed to validate XML document");
+    if (hash != nullptr && cache_contains(*hash)) {
+      PRINT_DEBUG("ECIC already validated (hash " << std::hex << *hash << std::dec << "): skip XSD validation");
+    } else {
+      // Validate XML
+      if((p_xsd_valid_context = xmlSchemaNewValidCtxt(get_compiled_schema())) == nullptr)
+        THROW_PARSER_ERROR(nullptr, "Failed to validate schema context");
+      if(xmlSchemaValidateDoc(p_xsd_valid_context, p_xml_doc) != 0)
+        THROW_PARSER_ERROR(nullptr, "Failed to validate XML document");
+      xmlSchemaFreeValidCtxt(p_xsd_valid_context);
+      p_xsd_valid_context = nullptr;
+    }
 
     // Load Nodes
     xmlNodePtr xmlRootNode(xmlDocGetRootElement(p_xml_doc));
@@ -1484,18 +1663,13 @@ static std::unique_ptr<ed247::xml::Component> ed247_ecic_load(xmlParserCtxtPtr &
     std::unique_ptr<ed247::xml::Component> root(new ed247::xml::Component());
     root->load(xmlRootNode);
 
-    if (p_xsd_valid_context) xmlSchemaFreeValidCtxt(p_xsd_valid_context);
-    if (p_xsd_schema) xmlSchemaFree(p_xsd_schema);
-    if (p_xsd_schema_parser) xmlSchemaFreeParserCtxt(p_xsd_schema_parser);
-    if (p_xsd_doc) xmlFreeDoc(p_xsd_doc);
+    // Only record ECICs that have been fully loaded
+    if (hash != nullptr) cache_insert(*hash);
 
     return root;
   }
   catch (...) {
     if (p_xsd_valid_context) xmlSchemaFreeValidCtxt(p_xsd_valid_context);
-    if (p_xsd_schema) xmlSchemaFree(p_xsd_schema);
-    if (p_xsd_schema_parser) xmlSchemaFreeParserCtxt(p_xsd_schema_parser);
-    if (p_xsd_doc) xmlFreeDoc(p_xsd_doc);
     throw;
   }
 }
@@ -1522,7 +1696,15 @@ std::unique_ptr<ed247::xml::Component> ed247::xml::load_filepath(const std::stri
       p_xml_doc->name = strdup(filepath.c_str());
     }
 
-    std::unique_ptr<ed247::xml::Component> root = ed247_ecic_load(p_xml_context, p_xml_doc);
+    uint64_t hash;
+    bool use_cache = cache_enabled();
+    if (use_cache) {
+      std::ifstream file(filepath, std::ios::binary);
+      std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+      hash = content_hash(content.c_str(), content.length());
+    }
+
+    std::unique_ptr<ed247::xml::Component> root = ed247_ecic_load(p_xml_doc, use_cache? &hash : nullptr);
 
     if(p_xml_doc) xmlFreeDoc(p_xml_doc);
     if(p_xml_context) xmlFreeParserCtxt(p_xml_context);
@@ -1553,7 +1735,11 @@ std::unique_ptr<ed247::xml::Component> ed247::xml::load_content(const std::strin
     if((p_xml_doc = xmlCtxtReadMemory(p_xml_context,content.c_str(),(int)content.length(),nullptr,nullptr,0)) == nullptr)
       THROW_PARSER_ERROR(nullptr, "Failed to read XML file content");
 
-    std::unique_ptr<ed247::xml::Component> root = ed247_ecic_load(p_xml_context, p_xml_doc);
+    uint64_t hash;
+    bool use_cache = cache_enabled();
+    if (use_cache) hash = content_hash(content.c_str(), content.length());
+
+    std::unique_ptr<ed247::xml::Component> root = ed247_ecic_load(p_xml_doc, use_cache? &hash : nullptr);
 
     if(p_xml_doc) xmlFreeDoc(p_xml_doc);
     if(p_xml_context) xmlFreeParserCtxt(p_xml_context);
@@ -1566,3 +1752,110 @@ std::unique_ptr<ed247::xml::Component> ed247::xml::load_content(const std::strin
     throw;
   }
 }
+
+//
+// Streaming load
+//
+// The document is read with an xmlTextReader and validated on the fly against the
+// compiled schema. Only one top level node of a channel (ComInterface, Header, a stream...)
+// is expanded at a time: the reader frees each subtree once it has been loaded, so the
+// memory does not depend on the number of channels and streams of the ECIC.
+//
+std::unique_ptr<ed247::xml::Component> ed247::xml::load_filepath_streaming(const std::string & filepath)
+{
+  // Node depths in an ECIC
+  enum {
+    depth_component = 0,       // ED247ComponentInstanceConfiguration
+    depth_component_child = 1, // Channels and FileProducer
+    depth_channel = 2,         // Channel and MultiChannel
+    depth_channel_child = 3,   // ComInterface, Header, FrameFormat and Streams/Stream container
+    depth_stream = 4           // *_Stream in the Streams/Stream container
+  };
+
+  xmlTextReaderPtr p_xml_reader = nullptr;
+
+  try {
+    // Setup error handler
+    xmlSetStructuredErrorFunc(nullptr,&libxml_structured_error);
+
+    if((p_xml_reader = xmlReaderForFile(filepath.c_str(),NULL,0)) == nullptr)
+      THROW_PARSER_ERROR(nullptr, "Failed to read [" << filepath << "]");
+    if(xmlTextReaderSetSchema(p_xml_reader, get_compiled_schema()) != 0)
+      THROW_PARSER_ERROR(nullptr, "Failed to setup schema validation of [" << filepath << "]");
+
+    std::unique_ptr<ed247::xml::Component> root(new ed247::xml::Component());
+    Channel* channel = nullptr;
+
+    int status;
+    while((status = xmlTextReaderRead(p_xml_reader)) == 1) {
+      int node_type = xmlTextReaderNodeType(p_xml_reader);
+      int depth = xmlTextReaderDepth(p_xml_reader);
+
+      if(node_type == XML_READER_TYPE_END_ELEMENT) {
+        if(depth == depth_channel && channel != nullptr) {
+          channel->consolidate(nullptr);
+          channel = nullptr;
+        }
+        continue;
+      }
+      if(node_type != XML_READER_TYPE_ELEMENT || depth > depth_stream)
+        continue;
+
+      xmlNodePtr xml_node = xmlTextReaderCurrentNode(p_xml_reader);
+      auto node_name = ::xml::xmlChar_as_string(xml_node->name);
+
+      if(depth == depth_component) {
+        // Store filename for debugging purpose
+        if(xml_node->doc && xml_node->doc->name == nullptr) {
+          xml_node->doc->name = strdup(filepath.c_str());
+        }
+        root->load_attributes(xml_node);
+      }
+      else if(depth == depth_component_child) {
+        if(node_name.compare(node::FileProducer) == 0) {
+          root->load_file_producer(xml_node);
+        } else if(node_name.compare(node::Channels) != 0) {
+          THROW_PARSER_ERROR(xml_node, "Unknown node [" << node_name << "] in tag [" << node::ED247ComponentInstanceConfiguration << "]");
+        }
+      }
+      else if(depth == depth_channel) {
+        channel = &root->add_channel(xml_node);
+        channel->load_attributes(xml_node);
+        // An empty element has no end element
+        if(xmlTextReaderIsEmptyElement(p_xml_reader) == 1) {
+          channel->consolidate(nullptr);
+          channel = nullptr;
+        }
+      }
+      else if(channel == nullptr) {
+        continue;
+      }
+      else if(depth == depth_channel_child) {
+        if(channel->is_streams_node(node_name) == false) {
+          if((xml_node = xmlTextReaderExpand(p_xml_reader)) == nullptr)
+            THROW_PARSER_ERROR(nullptr, "Failed to read [" << node_name << "]");
+          channel->load_element(xml_node);
+        }
+      }
+      else if(depth == depth_stream && xml_node->parent != nullptr &&
+              channel->is_streams_node(::xml::xmlChar_as_string(xml_node->parent->name))) {
+        if((xml_node = xmlTextReaderExpand(p_xml_reader)) == nullptr)
+          THROW_PARSER_ERROR(nullptr, "Failed to read [" << node_name << "]");
+        channel->load_stream(xml_node);
+      }
+    }
+
+    if(status != 0)
+      THROW_PARSER_ERROR(nullptr, "Failed to read [" << filepath << "]");
+    if(xmlTextReaderIsValid(p_xml_reader) != 1)
+      THROW_PARSER_ERROR(nullptr, "Failed to validate XML document");
+
+    xmlFreeTextReader(p_xml_reader);
+
+    return root;
+  }
+  catch(...) {
+    if(p_xml_reader) xmlFreeTextReader(p_xml_reader);
+    throw;
+  }
+}
@@ -28,6 +28,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
 
 // Prevent include of libxml2 header
 typedef struct _xmlNode *xmlNodePtr;
@@ -40,6 +41,19 @@ namespace ed247 {
     std::unique_ptr<Component> load_filepath(const std::string & filepath);
     std::unique_ptr<Component> load_content(const std::string & content);
 
+    // Same as load_filepath() but without building the whole document in memory:
+    // the ECIC is read and validated as a stream, one stream node at a time.
+    std::unique_ptr<Component> load_filepath_streaming(const std::string & filepath);
+
+    // Precompiled ECIC: binary image of a loaded Component (see ed247_xml_compiled.cpp)
+    void save_compiled(const Component& component, const std::string & filepath);
+    std::unique_ptr<Component> load_compiled(const std::string & filepath);
+
+    // Skip XSD validation of ECICs whose content hash is recorded in filepath.
+    // Each newly validated ECIC is added to this file. nullptr or empty to disable.
+    // The ED247_ECIC_VALIDATION_CACHE environment variable has the priority.
+    void set_validation_cache(const char* filepath);
+
 
     struct Node
     {
@@ -261,6 +275,13 @@ namespace ed247 {
 
       Channel();
       virtual void load(const xmlNodePtr xml_node) override final;
+
+      // Load steps, also used by the streaming loader
+      void load_attributes(const xmlNodePtr xml_node);
+      bool is_streams_node(const std::string& node_name) const;  // Streams (MultiChannel) or Stream (Channel) container
+      void load_element(const xmlNodePtr xml_node);              // ComInterface, Header and FrameFormat
+      void load_stream(const xmlNodePtr xml_node);               // A *_Stream node of the container
+      void consolidate(const xmlNodePtr closest_node);           // Check and deduce directions once all nodes are loaded
     };
 
     //
@@ -280,10 +301,20 @@ namespace ed247 {
 
       Component();
       virtual void load(const xmlNodePtr xml_node) override final;
+
+      // Load steps, also used by the streaming loader
+      void load_attributes(const xmlNodePtr xml_node);
+      void load_file_producer(const xmlNodePtr xml_node);
+      Channel& add_channel(const xmlNodePtr xml_node);           // Create a channel from a Channel or MultiChannel node
+
+      // Only keep the streams accepted by the filter.
+      // Channels without any stream and UdpSockets no more used by remaining streams are removed.
+      typedef std::function<bool(const Channel&, const Stream&)> stream_filter_t;
+      void filter_streams(const stream_filter_t& filter);
     };
+
+    std::ostream& operator<<(std::ostream& stream, const UdpSocket& socket);
   }
 }
 
-std::ostream& operator<<(std::ostream& stream, const ed247::xml::UdpSocket& socket);
-
 #endif
@@ -0,0 +1,414 @@
+/* -*- mode: c++; c-basic-offset: 2 -*-  */
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include "ed247_xml.h"
+#include "ed247_logs.h"
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#ifndef _WIN32
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <fcntl.h>
+# include <unistd.h>
+#endif
+
+/*
+ * Precompiled ECIC
+ *
+ * Binary image of an ed247::xml::Component tree, so a context can be created
+ * without any XML parsing nor XSD validation.
+ *
+ * Layout (host byte order, the file is not meant to be exchanged between platforms):
+ *   header:  magic "ED247ECB", format version, byte order mark, library version,
+ *            payload size, payload hash (FNV-1a)
+ * The payload layout follows the library internals: a file is only loaded by the library
+ * version which has generated it.
+ *   payload: Component fields, then each Channel, Stream and Signal in ECIC order.
+ *            Strings and vectors are prefixed by their uint32 size.
+ */
+namespace {
+  static const char     compiled_magic[8]    = { 'E', 'D', '2', '4', '7', 'E', 'C', 'B' };
+  static const uint32_t compiled_version     = 2;
+  static const uint32_t compiled_byte_order  = 0x01020304;
+
+  struct compiled_header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    char     library_version[64];
+    uint64_t payload_size;
+    uint64_t payload_hash;
+  };
+
+  uint64_t payload_hash(const char* data, uint64_t size)
+  {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (uint64_t i = 0; i < size; i++) {
+      hash = (hash ^ (uint8_t)data[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+  }
+
+  //
+  // Serialization
+  //
+  class writer {
+  public:
+    template<typename T>
+    void value(const T& value) {
+      const char* data = (const char*)&value;
+      _payload.insert(_payload.end(), data, data + sizeof(T));
+    }
+
+    void string(const std::string& str) {
+      value((uint32_t)str.size());
+      _payload.insert(_payload.end(), str.begin(), str.end());
+    }
+
+    void signal(const ed247::xml::Signal& signal) {
+      value(signal._type);
+      string(signal._name);
+      string(signal._comment);
+      string(signal._icd);
+      value(signal._byte_offset);
+      string(signal._analogue_electrical_unit);
+      value(signal._nad_type);
+      string(signal._nad_unit);
+      value((uint32_t)signal._nad_dimensions.size());
+      for (uint32_t dimension : signal._nad_dimensions) value(dimension);
+      value(signal._vnad_position);
+      value(signal._vnad_max_number);
+    }
+
+    void stream(const ed247::xml::Stream& stream) {
+      value(stream._type);
+      string(stream._name);
+      value(stream._direction);
+      string(stream._comment);
+      string(stream._icd);
+      value(stream._uid);
+      value(stream._sample_max_number);
+      value(stream._sample_max_size_bytes);
+      value(stream._sample_size_fixed);
+      value(stream._data_timestamp._enable);
+      value(stream._data_timestamp._enable_sample_offset);
+
+      if (stream.is_signal_based()) {
+        auto& stream_signals = static_cast<const ed247::xml::StreamSignals&>(stream);
+        value(stream_signals._sampling_period_us);
+        value((uint32_t)stream_signals._signal_list.size());
+        for (auto& sig : stream_signals._signal_list) signal(*sig);
+      } else {
+        value(static_cast<const ed247::xml::StreamProtocoled&>(stream)._errors._enable);
+        if (stream._type == ED247_STREAM_TYPE_A664) {
+          value(static_cast<const ed247::xml::A664Stream&>(stream)._enable_message_size);
+        } else if (stream._type == ED247_STREAM_TYPE_ETHERNET) {
+          value(static_cast<const ed247::xml::ETHStream&>(stream)._enable_message_size);
+          string(static_cast<const ed247::xml::ETHStream&>(stream)._layer);
+        }
+      }
+    }
+
+    void channel(const ed247::xml::Channel& channel) {
+      string(channel._name);
+      string(channel._comment);
+      value(channel._frame_standard_revision);
+      value((uint32_t)channel._com_interface._udp_sockets.size());
+      for (auto& socket : channel._com_interface._udp_sockets) {
+        string(socket._dst_ip_address);
+        value(socket._dst_ip_port);
+        string(socket._src_ip_address);
+        value(socket._src_ip_port);
+        string(socket._mc_ip_address);
+        value(socket._mc_ttl);
+        value(socket._direction);
+      }
+      value(channel._header._enable);
+      value(channel._header._transport_timestamp);
+      value(channel._is_simple_channel);
+      value((uint32_t)channel._stream_list.size());
+      for (auto& strm : channel._stream_list) stream(*strm);
+    }
+
+    void component(const ed247::xml::Component& component) {
+      value(component._identifier);
+      string(component._name);
+      string(component._version);
+      value(component._component_type);
+      value(component._standard_revision);
+      string(component._comment);
+      string(component._file_producer_identifier);
+      string(component._file_producer_comment);
+      value((uint32_t)component._channel_list.size());
+      for (auto& chan : component._channel_list) channel(chan);
+    }
+
+    const std::vector<char>& payload() const { return _payload; }
+
+  private:
+    std::vector<char> _payload;
+  };
+
+  //
+  // Deserialization
+  //
+  class reader {
+  public:
+    reader(const char* payload, uint64_t size) : _cursor(payload), _end(payload + size) {}
+
+    template<typename T>
+    void value(T& value) {
+      check(sizeof(T));
+      memcpy(&value, _cursor, sizeof(T));
+      _cursor += sizeof(T);
+    }
+
+    void string(std::string& str) {
+      uint32_t size;
+      value(size);
+      check(size);
+      str.assign(_cursor, size);
+      _cursor += size;
+    }
+
+    std::unique_ptr<ed247::xml::Signal> signal() {
+      ed247_signal_type_t type;
+      value(type);
+      std::unique_ptr<ed247::xml::Signal> signal;
+      switch (type) {
+      case ED247_SIGNAL_TYPE_DISCRETE: signal.reset(new ed247::xml::DISSignal());  break;
+      case ED247_SIGNAL_TYPE_ANALOG:   signal.reset(new ed247::xml::ANASignal());  break;
+      case ED247_SIGNAL_TYPE_NAD:      signal.reset(new ed247::xml::NADSignal());  break;
+      case ED247_SIGNAL_TYPE_VNAD:     signal.reset(new ed247::xml::VNADSignal()); break;
+      default: THROW_ED247_ERROR("Compiled ECIC: invalid signal type " << type);
+      }
+      string(signal->_name);
+      string(signal->_comment);
+      string(signal->_icd);
+      value(signal->_byte_offset);
+      string(signal->_analogue_electrical_unit);
+      value(signal->_nad_type);
+      string(signal->_nad_unit);
+      uint32_t dimensions;
+      value(dimensions);
+      signal->_nad_dimensions.resize(dimensions);
+      for (uint32_t& dimension : signal->_nad_dimensions) value(dimension);
+      value(signal->_vnad_position);
+      value(signal->_vnad_max_number);
+      return signal;
+    }
+
+    std::unique_ptr<ed247::xml::Stream> stream() {
+      ed247_stream_type_t type;
+      value(type);
+      std::unique_ptr<ed247::xml::Stream> stream;
+      switch (type) {
+      case ED247_STREAM_TYPE_A429:     stream.reset(new ed247::xml::A429Stream());   break;
+      case ED247_STREAM_TYPE_A664:     stream.reset(new ed247::xml::A664Stream());   break;
+      case ED247_STREAM_TYPE_A825:     stream.reset(new ed247::xml::A825Stream());   break;
+      case ED247_STREAM_TYPE_SERIAL:   stream.reset(new ed247::xml::SERIALStream()); break;
+      case ED247_STREAM_TYPE_ETHERNET: stream.reset(new ed247::xml::ETHStream());    break;
+      case ED247_STREAM_TYPE_DISCRETE: stream.reset(new ed247::xml::DISStream());    break;
+      case ED247_STREAM_TYPE_ANALOG:   stream.reset(new ed247::xml::ANAStream());    break;
+      case ED247_STREAM_TYPE_NAD:      stream.reset(new ed247::xml::NADStream());    break;
+      case ED247_STREAM_TYPE_VNAD:     stream.reset(new ed247::xml::VNADStream());   break;
+      default: THROW_ED247_ERROR("Compiled ECIC: invalid stream type " << type);
+      }
+      string(stream->_name);
+      value(stream->_direction);
+      string(stream->_comment);
+      string(stream->_icd);
+      value(stream->_uid);
+      value(stream->_sample_max_number);
+      value(stream->_sample_max_size_bytes);
+      value(stream->_sample_size_fixed);
+      value(stream->_data_timestamp._enable);
+      value(stream->_data_timestamp._enable_sample_offset);
+
+      if (stream->is_signal_based()) {
+        auto& stream_signals = static_cast<ed247::xml::StreamSignals&>(*stream);
+        value(stream_signals._sampling_period_us);
+        uint32_t signals;
+        value(signals);
+        for (uint32_t i = 0; i < signals; i++) stream_signals._signal_list.emplace_back(signal());
+      } else {
+        value(static_cast<ed247::xml::StreamProtocoled&>(*stream)._errors._enable);
+        if (type == ED247_STREAM_TYPE_A664) {
+          value(static_cast<ed247::xml::A664Stream&>(*stream)._enable_message_size);
+        } else if (type == ED247_STREAM_TYPE_ETHERNET) {
+          value(static_cast<ed247::xml::ETHStream&>(*stream)._enable_message_size);
+          string(static_cast<ed247::xml::ETHStream&>(*stream)._layer);
+        }
+      }
+      return stream;
+    }
+
+    void channel(ed247::xml::Channel& channel) {
+      string(channel._name);
+      string(channel._comment);
+      value(channel._frame_standard_revision);
+      uint32_t sockets;
+      value(sockets);
+      channel._com_interface._udp_sockets.resize(sockets);
+      for (auto& socket : channel._com_interface._udp_sockets) {
+        string(socket._dst_ip_address);
+        value(socket._dst_ip_port);
+        string(socket._src_ip_address);
+        value(socket._src_ip_port);
+        string(socket._mc_ip_address);
+        value(socket._mc_ttl);
+        value(socket._direction);
+      }
+      value(channel._header._enable);
+      value(channel._header._transport_timestamp);
+      value(channel._is_simple_channel);
+      uint32_t streams;
+      value(streams);
+      for (uint32_t i = 0; i < streams; i++) channel._stream_list.emplace_back(stream());
+    }
+
+    std::unique_ptr<ed247::xml::Component> component() {
+      std::unique_ptr<ed247::xml::Component> component(new ed247::xml::Component());
+      value(component->_identifier);
+      string(component->_name);
+      string(component->_version);
+      value(component->_component_type);
+      value(component->_standard_revision);
+      string(component->_comment);
+      string(component->_file_producer_identifier);
+      string(component->_file_producer_comment);
+      uint32_t channels;
+      value(channels);
+      component->_channel_list.reserve(channels);
+      for (uint32_t i = 0; i < channels; i++) {
+        component->_channel_list.emplace_back();
+        channel(component->_channel_list.back());
+      }
+      if (_cursor != _end) THROW_ED247_ERROR("Compiled ECIC: unexpected data after the component");
+      return component;
+    }
+
+  private:
+    const char* _cursor;
+    const char* _end;
+
+    void check(uint64_t size) {
+      if ((uint64_t)(_end - _cursor) < size) THROW_ED247_ERROR("Compiled ECIC: truncated payload");
+    }
+  };
+
+  // Read-only view of a compiled file (mapped in memory when possible)
+  class compiled_file {
+  public:
+    compiled_file(const std::string& filepath) : _data(nullptr), _size(0) {
+#ifndef _WIN32
+      int fd = open(filepath.c_str(), O_RDONLY);
+      if (fd < 0) THROW_ED247_ERROR("Failed to open compiled ECIC [" << filepath << "]: " << strerror(errno));
+      struct stat file_stat;
+      if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+        void* data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+          _data = (const char*)data;
+          _size = file_stat.st_size;
+        }
+      }
+      close(fd);
+      if (_data == nullptr) THROW_ED247_ERROR("Failed to map compiled ECIC [" << filepath << "]");
+#else
+      std::ifstream file(filepath, std::ios::binary);
+      if (!file) THROW_ED247_ERROR("Failed to open compiled ECIC [" << filepath << "]");
+      _buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+      _data = _buffer.data();
+      _size = _buffer.size();
+#endif
+    }
+
+    ~compiled_file() {
+#ifndef _WIN32
+      if (_data) munmap((void*)_data, _size);
+#endif
+    }
+
+    const char* data() const { return _data; }
+    uint64_t size() const { return _size; }
+
+  private:
+    const char*       _data;
+    uint64_t          _size;
+#ifdef _WIN32
+    std::vector<char> _buffer;
+#endif
+  };
+}
+
+void ed247::xml::save_compiled(const Component& component, const std::string & filepath)
+{
+  writer serializer;
+  serializer.component(component);
+
+  compiled_header header;
+  memcpy(header.magic, compiled_magic, sizeof(compiled_magic));
+  header.version = compiled_version;
+  header.byte_order = compiled_byte_order;
+  memset(header.library_version, 0, sizeof(header.library_version));
+  strncpy(header.library_version, ed247_get_implementation_version(), sizeof(header.library_version) - 1);
+  header.payload_size = serializer.payload().size();
+  header.payload_hash = payload_hash(serializer.payload().data(), serializer.payload().size());
+
+  std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+  file.write((const char*)&header, sizeof(header));
+  file.write(serializer.payload().data(), serializer.payload().size());
+  if (!file) THROW_ED247_ERROR("Failed to write compiled ECIC [" << filepath << "]");
+  PRINT_DEBUG("Compiled ECIC [" << filepath << "] written: " << sizeof(header) + header.payload_size << " bytes");
+}
+
+std::unique_ptr<ed247::xml::Component> ed247::xml::load_compiled(const std::string & filepath)
+{
+  compiled_file file(filepath);
+
+  compiled_header header;
+  if (file.size() < sizeof(header)) THROW_ED247_ERROR("[" << filepath << "] is not a compiled ECIC: too small");
+  memcpy(&header, file.data(), sizeof(header));
+
+  if (memcmp(header.magic, compiled_magic, sizeof(compiled_magic)) != 0)
+    THROW_ED247_ERROR("[" << filepath << "] is not a compiled ECIC");
+  if (header.byte_order != compiled_byte_order)
+    THROW_ED247_ERROR("Compiled ECIC [" << filepath << "] has been generated on a platform with another byte order");
+  if (header.version != compiled_version)
+    THROW_ED247_ERROR("Compiled ECIC [" << filepath << "] format version " << header.version << " is not supported (expected " << compiled_version << ")");
+  header.library_version[sizeof(header.library_version) - 1] = '\0';
+  if (strncmp(header.library_version, ed247_get_implementation_version(), sizeof(header.library_version) - 1) != 0)
+    THROW_ED247_ERROR("Compiled ECIC [" << filepath << "] has been generated by library version '" << header.library_version <<
+                      "' and cannot be loaded by version '" << ed247_get_implementation_version() << "': compile it again");
+  if (header.payload_size != file.size() - sizeof(header))
+    THROW_ED247_ERROR("Compiled ECIC [" << filepath << "] is truncated");
+
+  const char* payload = file.data() + sizeof(header);
+  if (payload_hash(payload, header.payload_size) != header.payload_hash)
+    THROW_ED247_ERROR("Compiled ECIC [" << filepath << "] is corrupted: integrity check failed");
+
+  return reader(payload, header.payload_size).component();
+}
@@ -137,7 +137,7 @@ TEST_P(LoadContext, Loading)
 
     // Test mem hooks
     malloc_count_start();
-    void *test = malloc(100000);
+    void * volatile test = malloc(100000);   // volatile: the compiler shall not elide the allocation
     free(test);
 #ifdef __linux__
     ASSERT_EQ(malloc_count_stop(), 1);
@@ -157,9 +157,7 @@ INSTANTIATE_TEST_CASE_P(func_load_all, LoadContext,
 
 int main(int argc, char **argv)
 {
-    // Parsing argument manage by Google Test framework
-    ::testing::InitGoogleTest(&argc, argv);
-
+    // The test cases are instantiated by InitGoogleTest(): configuration_files shall be filled before
     if(argc > 1)
         config_path = argv[1];
     else
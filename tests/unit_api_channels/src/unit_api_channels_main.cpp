@@ -193,6 +193,38 @@ TEST(UtApiChannel,GetChannelList)
     ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
 }
 
+static bool filter_dummy_channels(const char* channel_name, const char* stream_name, void* user_data)
+{
+    (*(uint32_t*)user_data)++;
+    return std::string(channel_name).find("Dummy") == 0;
+}
+
+TEST(UtApiChannel, FilteredLoading)
+{
+    ed247_context_t context;
+    ed247_channel_list_t channel_list;
+    ed247_channel_t channel;
+    ed247_stream_t stream;
+    uint32_t size;
+    uint32_t filter_calls = 0;
+
+    std::string filepath = config_path+"/ecic_unit_api_channels.xml";
+    ASSERT_EQ(ed247_load_file_filtered(filepath.c_str(), nullptr, nullptr, &context), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_load_file_filtered(filepath.c_str(), &filter_dummy_channels, &filter_calls, &context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(filter_calls, (uint32_t)4);
+
+    // Only the dummy channels have been created
+    ASSERT_EQ(ed247_get_channel_list(context, &channel_list), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_channel_list_size(channel_list, &size), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(size, (uint32_t)2);
+    ASSERT_EQ(ed247_get_channel(context, "DummyChannel1", &channel), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_channel(context, "FilledChannel", &channel), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_get_stream(context, "Label2", &stream), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "Label3", &stream), ED247_STATUS_FAILURE);
+
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+
 int main(int argc, char **argv)
 {
     if(argc >=1)
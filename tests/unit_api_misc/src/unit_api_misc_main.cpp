@@ -23,6 +23,7 @@
  *****************************************************************************/
 
 #include "single_actor_test.h"
+#include <fstream>
 
 
 std::string config_path = "../config";
@@ -81,6 +82,38 @@ TEST(UtApiMisc, InfoGetter)
     ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
 }
 
+/******************************************************************************
+Check the ECIC validation cache
+******************************************************************************/
+TEST(UtApiMisc, ValidationCache)
+{
+    ed247_context_t context = nullptr;
+    std::string filepath = config_path+"/ecic_unit_api_misc.xml";
+    std::string cache_filepath = "unit_api_misc_validation.cache";
+    std::remove(cache_filepath.c_str());
+
+    ASSERT_EQ(ed247_set_ecic_validation_cache(cache_filepath.c_str()), ED247_STATUS_SUCCESS);
+
+    // First load validates and records the ECIC, the second one uses the cache
+    for (int i = 0; i < 2; i++) {
+        ASSERT_EQ(ed247_load_file(filepath.c_str(), &context), ED247_STATUS_SUCCESS);
+        ASSERT_TRUE(strcmp(ed247_component_get_name(context), "ComponentWithAllOptions") == 0);
+        ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+    }
+
+    std::ifstream cache_file(cache_filepath);
+    std::string line;
+    uint32_t entries = 0;
+    while (std::getline(cache_file, line)) entries++;
+    ASSERT_EQ(entries, (uint32_t)1);
+
+    // An invalid ECIC is never recorded
+    ASSERT_EQ(ed247_load_content("<ED247ComponentInstanceConfiguration/>", &context), ED247_STATUS_FAILURE);
+
+    ASSERT_EQ(ed247_set_ecic_validation_cache(nullptr), ED247_STATUS_SUCCESS);
+    std::remove(cache_filepath.c_str());
+}
+
 /******************************************************************************
 Check the library identification routines
 ******************************************************************************/
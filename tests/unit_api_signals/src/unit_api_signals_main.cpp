@@ -341,3 +341,147 @@ int main(int argc, char **argv)
     // ::testing::InitGoogleMock(&argc, argv);
     return RUN_ALL_TESTS();
 }
+
+TEST(UtApiSignals, BulkSignalsAccess)
+{
+    ed247_context_t context;
+    ed247_stream_t stream_ana, stream_nad, stream_vnad;
+    ed247_signal_t signals_ana[2], signals_nad[2], signal_vnad;
+    ed247_stream_assistant_t assistant_ana, assistant_nad, assistant_vnad;
+    ed247_signal_batch_t batch;
+    uint32_t batch_size;
+    const void* sample;
+    uint32_t sample_size;
+
+    std::string filepath = config_path+"/ecic_unit_api_signals.xml";
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_get_stream(context, "Stream2", &stream_ana), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "Stream3", &stream_nad), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "Stream4", &stream_vnad), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_get_signal(stream_ana, "SignalAnaMin", &signals_ana[0]), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_get_signal(stream_ana, "SignalAnaMax", &signals_ana[1]), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_get_signal(stream_nad, "SignalNADmin", &signals_nad[0]), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_get_signal(stream_nad, "SignalNADmax", &signals_nad[1]), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_get_signal(stream_vnad, "SignalVNADmin", &signal_vnad), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_get_assistant(stream_ana, &assistant_ana), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_get_assistant(stream_nad, &assistant_nad), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_get_assistant(stream_vnad, &assistant_vnad), ED247_STATUS_SUCCESS);
+
+    // Bulk write is equivalent to single writes (signal values in reverse order)
+    ed247_signal_t reversed_ana[2] = { signals_ana[1], signals_ana[0] };
+    float ana_values[2] = { 12.5, -3.25 };
+    char ana_single[8], ana_bulk[8];
+    ASSERT_EQ(ed247_stream_assistant_write_signal(assistant_ana, signals_ana[1], &ana_values[0], 4), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_assistant_write_signal(assistant_ana, signals_ana[0], &ana_values[1], 4), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_assistant_read_signal(assistant_ana, signals_ana[0], &sample, &sample_size), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(sample_size, 4);
+    memcpy(ana_single, sample, 4);
+    ASSERT_EQ(ed247_stream_assistant_read_signal(assistant_ana, signals_ana[1], &sample, &sample_size), ED247_STATUS_SUCCESS);
+    memcpy(ana_single + 4, sample, 4);
+
+    ASSERT_EQ(ed247_stream_assistant_write_signals(assistant_ana, reversed_ana, 2, ana_values, 4), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_stream_assistant_write_signals(assistant_ana, reversed_ana, 2, ana_values, sizeof(ana_values)), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_assistant_read_signals(assistant_ana, signals_ana, 2, ana_bulk, 4), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_stream_assistant_read_signals(assistant_ana, signals_nad, 2, ana_bulk, sizeof(ana_bulk)), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_stream_assistant_read_signals(assistant_ana, signals_ana, 2, ana_bulk, sizeof(ana_bulk)), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(memcmp(ana_single, ana_bulk, sizeof(ana_bulk)), 0);
+
+    // Batch of NAD signals of different types
+    ASSERT_EQ(ed247_stream_assistant_create_signal_batch(assistant_nad, signals_nad, 2, NULL, NULL), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_stream_assistant_create_signal_batch(assistant_nad, signals_ana, 2, &batch, NULL), ED247_STATUS_FAILURE);
+    ASSERT_EQ(batch, nullptr);
+    ASSERT_EQ(ed247_stream_assistant_create_signal_batch(assistant_nad, signals_nad, 2, &batch, &batch_size), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(batch_size, 2 + 10*20*8);
+
+    std::vector<char> nad_values(batch_size), nad_read(batch_size);
+    uint16_t nad_min = 0x1234;
+    memcpy(nad_values.data(), &nad_min, sizeof(nad_min));
+    for (uint32_t i = 0; i < 10*20; i++) {
+      int64_t value = -(int64_t)i * 1000;
+      memcpy(nad_values.data() + 2 + i * 8, &value, sizeof(value));
+    }
+    ASSERT_EQ(ed247_signal_batch_write(batch, nad_values.data(), batch_size - 1), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_signal_batch_write(batch, nad_values.data(), batch_size), ED247_STATUS_SUCCESS);
+
+    // Same swapped content as single writes
+    ASSERT_EQ(ed247_stream_assistant_read_signals(assistant_nad, signals_nad, 2, nad_read.data(), batch_size), ED247_STATUS_SUCCESS);
+    std::vector<char> batch_read(batch_size);
+    ASSERT_EQ(ed247_signal_batch_read(batch, batch_read.data(), batch_size), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(batch_read, nad_read);
+    ASSERT_EQ(ed247_stream_assistant_write_signal(assistant_nad, signals_nad[0], &nad_min, sizeof(nad_min)), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_assistant_write_signal(assistant_nad, signals_nad[1], nad_values.data() + 2, batch_size - 2), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_signal_batch_read(batch, batch_read.data(), batch_size), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(batch_read, nad_read);
+
+    ASSERT_EQ(ed247_signal_batch_free(batch), ED247_STATUS_SUCCESS);
+
+    // Not available on VNAD streams
+    ASSERT_EQ(ed247_stream_assistant_write_signals(assistant_vnad, &signal_vnad, 1, nad_values.data(), batch_size), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_stream_assistant_create_signal_batch(assistant_vnad, &signal_vnad, 1, &batch, NULL), ED247_STATUS_FAILURE);
+
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+
+TEST(UtApiSignals, CyclicScheduler)
+{
+    ed247_context_t context;
+    ed247_stream_t stream;
+    ed247_signal_t signal;
+    ed247_stream_assistant_t assistant;
+    ed247_scheduler_stats_t stats[5];
+    uint32_t count;
+
+    std::string filepath = config_path+"/ecic_unit_api_signals.xml";
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_scheduler_run(NULL, 0), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_scheduler_get_stats(context, NULL, NULL), ED247_STATUS_FAILURE);
+    count = 1;
+    ASSERT_EQ(ed247_scheduler_get_stats(context, NULL, &count), ED247_STATUS_FAILURE);
+
+    // One group per sampling period, sorted by period
+    count = 0;
+    ASSERT_EQ(ed247_scheduler_get_stats(context, NULL, &count), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(count, (uint32_t)4);
+    count = 5;
+    ASSERT_EQ(ed247_scheduler_get_stats(context, stats, &count), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(count, (uint32_t)4);
+    ASSERT_EQ(stats[0].period_us, (uint32_t)10000);
+    ASSERT_EQ(stats[1].period_us, (uint32_t)20000);
+    ASSERT_EQ(stats[2].period_us, (uint32_t)100000);
+    ASSERT_EQ(stats[3].period_us, (uint32_t)500000);
+    ASSERT_EQ(stats[0].stream_count, (uint32_t)1);
+    ASSERT_EQ(stats[0].cycle_count, (uint64_t)0);
+
+    // Written streams are pushed and sent on their deadlines
+    ASSERT_EQ(ed247_get_stream(context, "Stream1", &stream), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_get_signal(stream, "SignalDisMin", &signal), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_get_assistant(stream, &assistant), ED247_STATUS_SUCCESS);
+    uint8_t value = 1;
+    ASSERT_EQ(ed247_stream_assistant_write_signal(assistant, signal, &value, sizeof(value)), ED247_STATUS_SUCCESS);
+    ASSERT_TRUE(ed247_stream_assistant_was_written(assistant));
+
+    // Deadlines are continued between calls
+    ASSERT_EQ(ed247_scheduler_run(context, 50000), ED247_STATUS_SUCCESS);
+    ASSERT_FALSE(ed247_stream_assistant_was_written(assistant));
+    ASSERT_EQ(ed247_scheduler_run(context, 50000), ED247_STATUS_SUCCESS);
+
+    count = 4;
+    ASSERT_EQ(ed247_scheduler_get_stats(context, stats, &count), ED247_STATUS_SUCCESS);
+    // 100ms: about 10 deadlines every 10ms, 5 every 20ms, 1 every 100ms and 500ms
+    // (missed deadlines are tolerated on loaded machines)
+    ASSERT_GE(stats[0].cycle_count + stats[0].missed_count, (uint64_t)9);
+    ASSERT_LE(stats[0].cycle_count + stats[0].missed_count, (uint64_t)11);
+    ASSERT_GE(stats[1].cycle_count + stats[1].missed_count, (uint64_t)4);
+    ASSERT_LE(stats[1].cycle_count + stats[1].missed_count, (uint64_t)6);
+    ASSERT_EQ(stats[3].cycle_count, (uint64_t)1);
+    ASSERT_LE(stats[0].jitter_min_us, stats[0].jitter_mean_us);
+    ASSERT_LE(stats[0].jitter_mean_us, stats[0].jitter_max_us);
+
+    ASSERT_EQ(ed247_scheduler_reset(context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_scheduler_get_stats(context, stats, &count), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(stats[0].cycle_count, (uint64_t)0);
+
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
@@ -23,6 +23,15 @@
  *****************************************************************************/
 
 #include "single_actor_test.h"
+#include <chrono>
+#include <thread>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/mman.h>
+#endif
+#ifdef ED247_IO_URING_ENABLED
+#include "ed247_context.h"
+#endif
 
 std::string config_path = "../config";
 
@@ -433,6 +442,920 @@ TEST(UtApiStreams, CheckRegexStreamFromContext)
     ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
 }
 
+TEST(UtApiStreams, MemoryFootprint)
+{
+    ed247_context_t context;
+    ed247_stream_t stream;
+    ed247_channel_t channel;
+    ed247_memory_footprint_t stream_footprint, channel_footprint, context_footprint;
+
+    std::string filepath = config_path+"/ecic_unit_api_streams_single_channel.xml";
+
+    // Default: the stacks used by the stream direction are allocated at load time
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "Stream1full", &stream), ED247_STATUS_SUCCESS);
+    uint64_t stack_bytes = (uint64_t)ed247_stream_get_sample_max_number(stream) * ed247_stream_get_sample_max_size_bytes(stream);
+
+    ASSERT_EQ(ed247_stream_get_memory_footprint(NULL, &stream_footprint), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_stream_get_memory_footprint(stream, NULL), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_stream_get_memory_footprint(stream, &stream_footprint), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(stream_footprint.allocated_bytes, stack_bytes);   // Output stream: only the send stack
+    ASSERT_EQ(stream_footprint.max_bytes, 2 * stack_bytes);
+
+    ASSERT_EQ(ed247_stream_get_channel(stream, &channel), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_channel_get_memory_footprint(NULL, &channel_footprint), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_channel_get_memory_footprint(channel, &channel_footprint), ED247_STATUS_SUCCESS);
+    ASSERT_GT(channel_footprint.allocated_bytes, stream_footprint.allocated_bytes);
+    ASSERT_GE(channel_footprint.max_bytes, channel_footprint.allocated_bytes);
+
+    ASSERT_EQ(ed247_component_get_memory_footprint(NULL, &context_footprint), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_component_get_memory_footprint(context, &context_footprint), ED247_STATUS_SUCCESS);
+    ASSERT_GT(context_footprint.allocated_bytes, channel_footprint.allocated_bytes);
+    ASSERT_GE(context_footprint.max_bytes, context_footprint.allocated_bytes);
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+
+    // Lazy: the send stack is allocated on first push
+    ASSERT_EQ(ed247_set_lazy_allocation(ED247_YESNO_YES), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_set_lazy_allocation(ED247_YESNO_NO), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "Stream1full", &stream), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_stream_get_memory_footprint(stream, &stream_footprint), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(stream_footprint.allocated_bytes, 0U);
+    ASSERT_EQ(stream_footprint.max_bytes, 2 * stack_bytes);
+
+    char sample[] = "sample";
+    ASSERT_EQ(ed247_stream_push_sample(stream, sample, sizeof(sample), NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_get_memory_footprint(stream, &stream_footprint), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(stream_footprint.allocated_bytes, stack_bytes);
+    ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+
+TEST(UtApiStreams, FindWithPattern)
+{
+    ed247_context_t context;
+    ed247_name_pattern_t pattern;
+    ed247_channel_list_t channel_list;
+    ed247_stream_list_t stream_list, regex_stream_list;
+    ed247_signal_list_t signal_list;
+    ed247_channel_t channel;
+    ed247_stream_t stream;
+    uint32_t size, regex_size;
+
+    std::string filepath = config_path+"/ecic_unit_api_streams_multiple_channels.xml";
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_name_pattern_compile(".*[", &pattern), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_name_pattern_compile(".*", NULL), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_name_pattern_free(NULL), ED247_STATUS_FAILURE);
+
+    // Exact, prefix, glob and regex patterns shall find the same streams than the regex based API
+    std::vector<std::pair<std::string, uint32_t>> stream_patterns = {
+        { "Stream1",       1 },
+        { "Stream1.*",    10 },
+        { "Stream.",       9 },
+        { "S.*am1.",       9 },
+        { "Stream1\\d",   9 },
+        { "Stream(1|2)",   2 },
+        { "Unknown.*",     0 },
+        { ".*",           18 },
+    };
+    for (auto& stream_pattern : stream_patterns) {
+        SAY("Pattern " << stream_pattern.first);
+        ASSERT_EQ(ed247_name_pattern_compile(stream_pattern.first.c_str(), &pattern), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(ed247_find_streams_with_pattern(context, NULL, &stream_list), ED247_STATUS_FAILURE);
+        ASSERT_EQ(ed247_find_streams_with_pattern(NULL, pattern, &stream_list), ED247_STATUS_FAILURE);
+        ASSERT_EQ(ed247_find_streams_with_pattern(context, pattern, &stream_list), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(ed247_find_streams(context, stream_pattern.first.c_str(), &regex_stream_list), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(ed247_stream_list_size(stream_list, &size), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(ed247_stream_list_size(regex_stream_list, &regex_size), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(size, stream_pattern.second);
+        ASSERT_EQ(regex_size, stream_pattern.second);
+
+        // Sorted by name
+        std::string previous_name;
+        while (ed247_stream_list_next(stream_list, &stream) == ED247_STATUS_SUCCESS && stream != nullptr) {
+            ASSERT_LT(previous_name, std::string(ed247_stream_get_name(stream)));
+            previous_name = ed247_stream_get_name(stream);
+        }
+        ASSERT_EQ(ed247_stream_list_free(stream_list), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(ed247_stream_list_free(regex_stream_list), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(ed247_name_pattern_free(pattern), ED247_STATUS_SUCCESS);
+    }
+
+    ASSERT_EQ(ed247_name_pattern_compile("Signal.*0.", &pattern), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_find_signals_with_pattern(context, pattern, &signal_list), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_signal_list_size(signal_list, &size), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(size, (uint32_t)17);
+    ASSERT_EQ(ed247_signal_list_free(signal_list), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_name_pattern_free(pattern), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_name_pattern_compile("Multiple.*", &pattern), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_find_channels_with_pattern(context, pattern, &channel_list), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_channel_list_size(channel_list, &size), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(size, (uint32_t)2);
+    ASSERT_EQ(ed247_channel_list_free(channel_list), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_name_pattern_free(pattern), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_get_channel(context, "MultipleStreamsChannel", &channel), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_name_pattern_compile("Stream1.*", &pattern), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_channel_find_streams_with_pattern(channel, pattern, &stream_list), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_list_size(stream_list, &size), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(size, (uint32_t)1);
+    ASSERT_EQ(ed247_stream_list_free(stream_list), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_name_pattern_free(pattern), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_get_stream(context, "Stream6", &stream), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_name_pattern_compile("SignalNAD0[1-3]", &pattern), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_find_signals_with_pattern(stream, pattern, &signal_list), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_signal_list_size(signal_list, &size), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(size, (uint32_t)3);
+    ASSERT_EQ(ed247_signal_list_free(signal_list), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_name_pattern_free(pattern), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+
+/******************************************************************************
+Frames sent through the asynchronous sender are received back on the
+bidirectional socket of the channel.
+******************************************************************************/
+TEST(UtApiStreams, AsyncSend)
+{
+    ed247_context_t context;
+    ed247_stream_t stream;
+    uint32_t backlog;
+
+    std::string filepath = config_path+"/ecic_unit_api_streams_loopback.xml";
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_async_send_enable(NULL, 8, -1), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_async_send_enable(context, 0, -1), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_async_send_get_backlog(context, NULL), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_async_send_flush(NULL), ED247_STATUS_FAILURE);
+
+    // Disabled
+    ASSERT_EQ(ed247_async_send_flush(context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_async_send_get_backlog(context, &backlog), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(backlog, (uint32_t)0);
+
+    ASSERT_EQ(ed247_async_send_enable(context, 2, 0), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "Stream3", &stream), ED247_STATUS_SUCCESS);
+
+    // More frames than queue slots: the caller waits for free slots
+    for (uint8_t index = 0; index < 5; index++) {
+        uint8_t sample[4] = { index, 1, 2, 3 };
+        ASSERT_EQ(ed247_stream_push_sample(stream, sample, sizeof(sample), NULL, NULL), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(ed247_async_send_get_backlog(context, &backlog), ED247_STATUS_SUCCESS);
+        ASSERT_LE(backlog, (uint32_t)2);
+    }
+    ASSERT_EQ(ed247_async_send_flush(context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_async_send_get_backlog(context, &backlog), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(backlog, (uint32_t)0);
+
+    // All frames have been sent, in order
+    ASSERT_EQ(ed247_wait_frame(context, NULL, 1000000), ED247_STATUS_SUCCESS);
+    for (uint8_t index = 0; index < 5; index++) {
+        const void* sample_data;
+        uint32_t sample_size;
+        bool empty;
+        ASSERT_EQ(ed247_stream_pop_sample(stream, &sample_data, &sample_size, NULL, NULL, NULL, &empty), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(sample_size, (uint32_t)4);
+        ASSERT_EQ(((const uint8_t*)sample_data)[0], index);
+    }
+
+    // Queued frames are sent when the sender is disabled
+    uint8_t sample[4] = { 42, 1, 2, 3 };
+    ASSERT_EQ(ed247_stream_push_sample(stream, sample, sizeof(sample), NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_async_send_disable(context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_frame(context, NULL, 1000000), ED247_STATUS_SUCCESS);
+
+    // Unload with a queued frame
+    ASSERT_EQ(ed247_async_send_enable(context, 8, -1), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_push_sample(stream, sample, sizeof(sample), NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+
+/******************************************************************************
+In busy poll mode, frames are received without blocking wait.
+******************************************************************************/
+TEST(UtApiStreams, BusyPoll)
+{
+    ed247_context_t context;
+    ed247_stream_t stream;
+    const void* sample_data;
+    uint32_t sample_size;
+    bool empty;
+
+    std::string filepath = config_path+"/ecic_unit_api_streams_loopback.xml";
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "Stream3", &stream), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_component_set_busy_poll(NULL, 100, 0), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_component_set_busy_poll(context, 1000, 0), ED247_STATUS_SUCCESS);
+
+    // Nothing to receive: spin, then fall back to the blocking wait
+    auto begin = std::chrono::steady_clock::now();
+    ASSERT_EQ(ed247_wait_frame(context, NULL, 5000), ED247_STATUS_TIMEOUT);
+    ASSERT_GE(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count(), 5000);
+    ASSERT_EQ(ed247_wait_frame(context, NULL, 0), ED247_STATUS_TIMEOUT);
+
+    // More frames than a recvmmsg() batch
+    for (uint8_t index = 0; index < 8; index++) {
+        uint8_t sample[4] = { index, 1, 2, 3 };
+        ASSERT_EQ(ed247_stream_push_sample(stream, sample, sizeof(sample), NULL, NULL), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+    }
+    uint8_t sample[4] = { 8, 1, 2, 3 };
+    ASSERT_EQ(ed247_stream_push_sample(stream, sample, sizeof(sample), NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_wait_frame(context, NULL, 1000000), ED247_STATUS_SUCCESS);
+    for (uint8_t index = 0; index < 8; index++) {
+        ASSERT_EQ(ed247_stream_pop_sample(stream, &sample_data, &sample_size, NULL, NULL, NULL, &empty), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(((const uint8_t*)sample_data)[0], index + 1);
+    }
+    ASSERT_TRUE(empty);
+
+    // Back to the blocking mode
+    ASSERT_EQ(ed247_component_set_busy_poll(context, 0, 0), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_push_sample(stream, sample, sizeof(sample), NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_frame(context, NULL, 1000000), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+
+/******************************************************************************
+Channels sharing an input address: each frame is decoded by its own channel.
+******************************************************************************/
+TEST(UtApiStreams, SharedAddressChannels)
+{
+    ed247_context_t context;
+    ed247_channel_t channel_a;
+    ed247_stream_t stream_a, stream_b;
+    const void* sample;
+    uint32_t sample_size;
+    bool empty;
+
+    std::string filepath = config_path+"/ecic_unit_api_streams_shared_address.xml";
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_channel(context, "SharedAddressChannelA", &channel_a), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "StreamA", &stream_a), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "StreamB", &stream_b), ED247_STATUS_SUCCESS);
+
+    // Both frames are received on the same socket
+    uint8_t sample_a[4] = { 0xA, 1, 2, 3 };
+    uint8_t sample_b[4] = { 0xB, 1, 2, 3 };
+    ASSERT_EQ(ed247_stream_push_sample(stream_a, sample_a, sizeof(sample_a), NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_push_sample(stream_b, sample_b, sizeof(sample_b), NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_during(context, NULL, 20000), ED247_STATUS_SUCCESS);
+
+    // Each stream receives its own sample only
+    ASSERT_EQ(ed247_stream_pop_sample(stream_a, &sample, &sample_size, NULL, NULL, NULL, &empty), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(memcmp(sample, sample_a, sizeof(sample_a)), 0);
+    ASSERT_TRUE(empty);
+    ASSERT_EQ(ed247_stream_pop_sample(stream_b, &sample, &sample_size, NULL, NULL, NULL, &empty), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(memcmp(sample, sample_b, sizeof(sample_b)), 0);
+    ASSERT_TRUE(empty);
+
+    // The first stream of the frame is unknown (another ECIC or a filtered stream): the next ones are delivered
+    uint8_t unknown_first_frame[] = { /* UID */ 0, 9, /* Size */ 0, 5, 4, 0xC, 1, 2, 3,
+                                      /* UID */ 0, 2, /* Size */ 0, 5, 4, 0xB, 1, 2, 3 };
+    ASSERT_EQ(ed247_channel_send_frame(channel_a, unknown_first_frame, sizeof(unknown_first_frame)), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_during(context, NULL, 20000), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_pop_sample(stream_a, &sample, &sample_size, NULL, NULL, NULL, NULL), ED247_STATUS_NODATA);
+    ASSERT_EQ(ed247_stream_pop_sample(stream_b, &sample, &sample_size, NULL, NULL, NULL, &empty), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(memcmp(sample, sample_b, sizeof(sample_b)), 0);
+    ASSERT_TRUE(empty);
+
+    // A frame with the streams of both channels is delivered to both of them
+    uint8_t mixed_frame[] = { /* UID */ 0, 1, /* Size */ 0, 5, 4, 0xA, 1, 2, 3,
+                              /* UID */ 0, 2, /* Size */ 0, 5, 4, 0xB, 1, 2, 3 };
+    ASSERT_EQ(ed247_channel_send_frame(channel_a, mixed_frame, sizeof(mixed_frame)), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_during(context, NULL, 20000), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_pop_sample(stream_a, &sample, &sample_size, NULL, NULL, NULL, &empty), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(memcmp(sample, sample_a, sizeof(sample_a)), 0);
+    ASSERT_TRUE(empty);
+    ASSERT_EQ(ed247_stream_pop_sample(stream_b, &sample, &sample_size, NULL, NULL, NULL, &empty), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(memcmp(sample, sample_b, sizeof(sample_b)), 0);
+    ASSERT_TRUE(empty);
+
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+
+/******************************************************************************
+Frames of unexpected components or without stream of the channel are dropped.
+******************************************************************************/
+TEST(UtApiStreams, ComponentFilter)
+{
+    ed247_context_t context;
+    ed247_channel_t channel, no_header_channel;
+    ed247_stream_t stream;
+    const void* sample;
+    uint32_t sample_size;
+    uint64_t dropped_frame_count;
+
+    std::string filepath = config_path+"/ecic_unit_api_streams_component_filter.xml";
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_channel(context, "FilteredChannel", &channel), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_channel(context, "NoHeaderChannel", &no_header_channel), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "FilteredStream", &stream), ED247_STATUS_SUCCESS);
+
+    ed247_uid_t own_component = 7;
+    ed247_uid_t other_components[2] = { 2, 1 };
+    ASSERT_EQ(ed247_channel_set_component_filter(NULL, &own_component, 1), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_channel_set_component_filter(channel, NULL, 1), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_channel_set_component_filter(no_header_channel, &own_component, 1), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_channel_set_component_filter(no_header_channel, NULL, 0), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_channel_get_dropped_frame_count(NULL, &dropped_frame_count), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_channel_get_dropped_frame_count(channel, NULL), ED247_STATUS_FAILURE);
+
+    // Accepted component
+    uint8_t sent_sample[4] = { 42, 1, 2, 3 };
+    ASSERT_EQ(ed247_channel_set_component_filter(channel, &own_component, 1), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_push_sample(stream, sent_sample, sizeof(sent_sample), NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_frame(context, NULL, 1000000), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_pop_sample(stream, &sample, &sample_size, NULL, NULL, NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_channel_get_dropped_frame_count(channel, &dropped_frame_count), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(dropped_frame_count, 0u);
+
+    // Other components only
+    ASSERT_EQ(ed247_channel_set_component_filter(channel, other_components, 2), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_push_sample(stream, sent_sample, sizeof(sent_sample), NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_frame(context, NULL, 1000000), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_pop_sample(stream, &sample, &sample_size, NULL, NULL, NULL, NULL), ED247_STATUS_NODATA);
+    ASSERT_EQ(ed247_channel_get_dropped_frame_count(channel, &dropped_frame_count), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(dropped_frame_count, 1u);
+
+    // No filter, but no stream of the channel in the frame
+    ASSERT_EQ(ed247_channel_set_component_filter(channel, NULL, 0), ED247_STATUS_SUCCESS);
+    uint8_t frame[] = { 0, 7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, /* UID */ 0, 99, /* Size */ 0, 4, 42, 1, 2, 3 };
+    ASSERT_EQ(ed247_channel_send_frame(channel, frame, sizeof(frame)), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_frame(context, NULL, 1000000), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_pop_sample(stream, &sample, &sample_size, NULL, NULL, NULL, NULL), ED247_STATUS_NODATA);
+    ASSERT_EQ(ed247_channel_get_dropped_frame_count(channel, &dropped_frame_count), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(dropped_frame_count, 2u);
+
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+
+#ifdef __linux__
+/******************************************************************************
+Reception driven by an external event loop through the readiness fd.
+******************************************************************************/
+TEST(UtApiStreams, ReadinessFd)
+{
+    ed247_context_t context;
+    ed247_stream_t stream;
+    ed247_stream_list_t streams;
+    int fd;
+
+    std::string filepath = config_path+"/ecic_unit_api_streams_loopback.xml";
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "Stream3", &stream), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_get_readiness_fd(NULL, &fd), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_get_readiness_fd(context, NULL), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_process_pending_frames(NULL, NULL), ED247_STATUS_FAILURE);
+
+    ASSERT_EQ(ed247_get_readiness_fd(context, &fd), ED247_STATUS_SUCCESS);
+    ASSERT_GE(fd, 0);
+
+    struct pollfd poll_fd = { fd, POLLIN, 0 };
+    ASSERT_EQ(poll(&poll_fd, 1, 0), 0);
+    ASSERT_EQ(ed247_process_pending_frames(context, &streams), ED247_STATUS_NODATA);
+
+    uint8_t sample[4] = { 42, 1, 2, 3 };
+    ASSERT_EQ(ed247_stream_push_sample(stream, sample, sizeof(sample), NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(poll(&poll_fd, 1, 1000), 1);
+    ASSERT_EQ(ed247_process_pending_frames(context, &streams), ED247_STATUS_SUCCESS);
+    ed247_stream_t stream_with_data;
+    ASSERT_EQ(ed247_stream_list_next(streams, &stream_with_data), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(stream_with_data, stream);
+
+    // Everything has been processed
+    ASSERT_EQ(poll(&poll_fd, 1, 0), 0);
+    ASSERT_EQ(ed247_process_pending_frames(context, NULL), ED247_STATUS_NODATA);
+
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+#endif
+
+/******************************************************************************
+Record a received datagram and replay it as a raw channel frame.
+******************************************************************************/
+struct recorded_datagram_t {
+    uint32_t              count{0};
+    ed247_channel_t       channel{nullptr};
+    ed247_datagram_info_t info;
+    std::vector<char>     frame;
+};
+
+static void record_datagram(ed247_context_t, ed247_channel_t channel, const ed247_datagram_info_t* info,
+                            const void* frame, uint32_t frame_size, void* user_data)
+{
+    recorded_datagram_t* recorded = (recorded_datagram_t*)user_data;
+    recorded->count++;
+    recorded->channel = channel;
+    recorded->info = *info;
+    recorded->frame.assign((const char*)frame, (const char*)frame + frame_size);
+}
+
+TEST(UtApiStreams, RecordAndReplayDatagram)
+{
+    ed247_context_t context;
+    ed247_channel_t channel;
+    ed247_stream_t stream;
+    recorded_datagram_t recorded;
+    const void* sample;
+    uint32_t sample_size;
+    ed247_timestamp_t before, after;
+
+    std::string filepath = config_path+"/ecic_unit_api_streams_loopback.xml";
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_channel(context, "LoopbackChannel", &channel), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "Stream3", &stream), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_set_datagram_recv_callback(NULL, &record_datagram, &recorded), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_channel_send_frame(NULL, "", 0), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_channel_send_frame(channel, NULL, 0), ED247_STATUS_FAILURE);
+
+    ASSERT_EQ(ed247_set_datagram_recv_callback(context, &record_datagram, &recorded), ED247_STATUS_SUCCESS);
+
+    uint8_t sent_sample[4] = { 42, 1, 2, 3 };
+    ed247_get_time(&before);
+    ASSERT_EQ(ed247_stream_push_sample(stream, sent_sample, sizeof(sent_sample), NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_frame(context, NULL, 1000000), ED247_STATUS_SUCCESS);
+    ed247_get_time(&after);
+
+    ASSERT_EQ(recorded.count, 1u);
+    ASSERT_EQ(recorded.channel, channel);
+    ASSERT_EQ(recorded.info.destination_ip, 0x7F000001u);
+    ASSERT_EQ(recorded.info.destination_port, 2591);
+    ASSERT_EQ(recorded.info.source_ip, 0x7F000001u);
+    ASSERT_NE(recorded.info.source_port, 0);
+    uint64_t before_ns = (uint64_t)before.epoch_s * 1000000000 + before.offset_ns;
+    uint64_t after_ns = (uint64_t)after.epoch_s * 1000000000 + after.offset_ns;
+    uint64_t timestamp_ns = (uint64_t)recorded.info.timestamp.epoch_s * 1000000000 + recorded.info.timestamp.offset_ns;
+    ASSERT_GE(timestamp_ns + 1000000, before_ns);
+    ASSERT_LE(timestamp_ns, after_ns + 1000000);
+    ASSERT_EQ(ed247_stream_pop_sample(stream, &sample, &sample_size, NULL, NULL, NULL, NULL), ED247_STATUS_SUCCESS);
+
+    // Replay the recorded frame
+    ASSERT_EQ(ed247_set_datagram_recv_callback(context, NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_channel_send_frame(channel, recorded.frame.data(), recorded.frame.size()), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_frame(context, NULL, 1000000), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(recorded.count, 1u);
+    ASSERT_EQ(ed247_stream_pop_sample(stream, &sample, &sample_size, NULL, NULL, NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(sample_size, sizeof(sent_sample));
+    ASSERT_EQ(memcmp(sample, sent_sample, sizeof(sent_sample)), 0);
+
+    // Frames too large for a datagram or for the asynchronous sender slots are rejected
+    std::vector<char> large_frame(64 * 1024);
+    ASSERT_EQ(ed247_channel_send_frame(channel, large_frame.data(), large_frame.size()), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_async_send_enable(context, 2, -1), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_channel_send_frame(channel, large_frame.data(), 4096), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_channel_send_frame(channel, recorded.frame.data(), recorded.frame.size()), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_async_send_disable(context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_frame(context, NULL, 1000000), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+
+/******************************************************************************
+A datagram received on an address shared by several channels is recorded once.
+******************************************************************************/
+TEST(UtApiStreams, SharedAddressDatagramRecording)
+{
+    ed247_context_t context;
+    ed247_channel_t channel_a;
+    recorded_datagram_t recorded;
+
+    std::string filepath = config_path+"/ecic_unit_api_streams_shared_address.xml";
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_channel(context, "SharedAddressChannelA", &channel_a), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_set_datagram_recv_callback(context, &record_datagram, &recorded), ED247_STATUS_SUCCESS);
+
+    // Decoded by both channels
+    uint8_t mixed_frame[] = { /* UID */ 0, 1, /* Size */ 0, 5, 4, 0xA, 1, 2, 3,
+                              /* UID */ 0, 2, /* Size */ 0, 5, 4, 0xB, 1, 2, 3 };
+    ASSERT_EQ(ed247_channel_send_frame(channel_a, mixed_frame, sizeof(mixed_frame)), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_during(context, NULL, 20000), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(recorded.count, 1u);
+    ASSERT_EQ(recorded.channel, channel_a);
+    ASSERT_EQ(recorded.frame.size(), sizeof(mixed_frame));
+
+    // Decoded by none of them
+    uint8_t unknown_frame[] = { /* UID */ 0, 9, /* Size */ 0, 5, 4, 0xC, 1, 2, 3 };
+    ASSERT_EQ(ed247_channel_send_frame(channel_a, unknown_frame, sizeof(unknown_frame)), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_during(context, NULL, 20000), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(recorded.count, 2u);
+    ASSERT_EQ(recorded.channel, (ed247_channel_t)NULL);
+    ASSERT_EQ(recorded.frame.size(), sizeof(unknown_frame));
+
+    ASSERT_EQ(ed247_set_datagram_recv_callback(context, NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+
+/******************************************************************************
+Send the pushed samples of a single channel.
+******************************************************************************/
+TEST(UtApiStreams, ChannelSendPushedSamples)
+{
+    ed247_context_t context;
+    ed247_channel_t channel;
+    ed247_stream_t stream;
+    const void* sample;
+    uint32_t sample_size;
+    uint64_t send_error_count;
+
+    std::string filepath = config_path+"/ecic_unit_api_streams_loopback.xml";
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_channel(context, "LoopbackChannel", &channel), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "Stream3", &stream), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_channel_send_pushed_samples(NULL), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_channel_get_send_error_count(NULL, &send_error_count), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_channel_get_send_error_count(channel, NULL), ED247_STATUS_FAILURE);
+
+    uint8_t sent_sample[4] = { 42, 1, 2, 3 };
+    ASSERT_EQ(ed247_stream_push_sample(stream, sent_sample, sizeof(sent_sample), NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_channel_send_pushed_samples(channel), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_frame(context, NULL, 1000000), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_pop_sample(stream, &sample, &sample_size, NULL, NULL, NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(sample_size, sizeof(sent_sample));
+    ASSERT_EQ(memcmp(sample, sent_sample, sizeof(sent_sample)), 0);
+
+    // Nothing pushed: nothing sent
+    ASSERT_EQ(ed247_channel_send_pushed_samples(channel), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_frame(context, NULL, 10000), ED247_STATUS_TIMEOUT);
+
+    ASSERT_EQ(ed247_channel_get_send_error_count(channel, &send_error_count), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(send_error_count, 0u);
+
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+
+/******************************************************************************
+Socket buffer sizes and frames dropped by the kernel when the receive buffer
+is full.
+******************************************************************************/
+TEST(UtApiStreams, SocketBuffers)
+{
+    ed247_context_t context;
+    ed247_channel_t channel;
+    ed247_stream_t stream;
+    uint64_t kernel_drop_count;
+
+#ifdef __linux__
+    // The io_uring engine does not report the kernel drops: load the context with the select() engine
+    const char* io_uring_env = getenv("ED247_IO_URING");
+    std::string io_uring_saved = io_uring_env ? io_uring_env : "";
+    setenv("ED247_IO_URING", "0", 1);
+#endif
+    std::string filepath = config_path+"/ecic_unit_api_streams_loopback.xml";
+    ed247_status_t load_status = ed247_load_file(filepath.c_str(), &context);
+#ifdef __linux__
+    if (io_uring_env) setenv("ED247_IO_URING", io_uring_saved.c_str(), 1);
+    else unsetenv("ED247_IO_URING");
+#endif
+    ASSERT_EQ(load_status, ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_channel(context, "LoopbackChannel", &channel), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "Stream3", &stream), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_channel_set_socket_buffer_sizes(NULL, 0, 0), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_channel_get_kernel_drop_count(NULL, &kernel_drop_count), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_channel_get_kernel_drop_count(channel, NULL), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_channel_set_socket_buffer_sizes(channel, 0, 0), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_channel_set_socket_buffer_sizes(channel, 1024*1024, 1024*1024), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_channel_get_kernel_drop_count(channel, &kernel_drop_count), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(kernel_drop_count, 0u);
+
+    // Overflow a small receive buffer
+    ASSERT_EQ(ed247_channel_set_socket_buffer_sizes(channel, 4096, 0), ED247_STATUS_SUCCESS);
+    uint8_t sent_sample[4] = { 42, 1, 2, 3 };
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_EQ(ed247_stream_push_sample(stream, sent_sample, sizeof(sent_sample), NULL, NULL), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(ed247_channel_send_pushed_samples(channel), ED247_STATUS_SUCCESS);
+    }
+    while (ed247_wait_frame(context, NULL, 10000) == ED247_STATUS_SUCCESS);
+
+#ifdef __linux__
+    // The kernel reports the drops with the frames queued after them
+    ASSERT_EQ(ed247_stream_push_sample(stream, sent_sample, sizeof(sent_sample), NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_channel_send_pushed_samples(channel), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_frame(context, NULL, 1000000), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_channel_get_kernel_drop_count(channel, &kernel_drop_count), ED247_STATUS_SUCCESS);
+    ASSERT_GT(kernel_drop_count, 0u);
+#endif
+
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+
+/******************************************************************************
+In-process loopback transport: the frames are delivered without socket to all
+the contexts listening the destination address.
+******************************************************************************/
+TEST(UtApiStreams, LoopbackTransport)
+{
+    ed247_context_t context1, context2;
+    ed247_stream_t stream1, stream2;
+    const void* sample;
+    uint32_t sample_size;
+    int fd;
+
+    ASSERT_EQ(ed247_set_transport(ED247_TRANSPORT__COUNT), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_set_transport(ED247_TRANSPORT_LOOPBACK), ED247_STATUS_SUCCESS);
+
+    // Same ECIC twice: no socket, so no address conflict
+    std::string filepath = config_path+"/ecic_unit_api_streams_loopback.xml";
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context1), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context2), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_set_transport(ED247_TRANSPORT_UDP), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context1, "Stream3", &stream1), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context2, "Stream3", &stream2), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_get_readiness_fd(context1, &fd), ED247_STATUS_FAILURE);
+    ASSERT_EQ(ed247_wait_frame(context1, NULL, 1000), ED247_STATUS_TIMEOUT);
+    ASSERT_EQ(ed247_process_pending_frames(context1, NULL), ED247_STATUS_NODATA);
+
+    uint8_t sent_sample[4] = { 42, 1, 2, 3 };
+    ASSERT_EQ(ed247_stream_push_sample(stream1, sent_sample, sizeof(sent_sample), NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_send_pushed_samples(context1), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_wait_frame(context1, NULL, 0), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_pop_sample(stream1, &sample, &sample_size, NULL, NULL, NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(sample_size, sizeof(sent_sample));
+    ASSERT_EQ(memcmp(sample, sent_sample, sizeof(sent_sample)), 0);
+
+    ASSERT_EQ(ed247_process_pending_frames(context2, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_pop_sample(stream2, &sample, &sample_size, NULL, NULL, NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(sample_size, sizeof(sent_sample));
+    ASSERT_EQ(memcmp(sample, sent_sample, sizeof(sent_sample)), 0);
+    ASSERT_EQ(ed247_wait_frame(context2, NULL, 1000), ED247_STATUS_TIMEOUT);
+
+    // Delivered by another thread
+    std::thread sender([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ed247_stream_push_sample(stream2, sent_sample, sizeof(sent_sample), NULL, NULL);
+        ed247_send_pushed_samples(context2);
+    });
+    ASSERT_EQ(ed247_wait_frame(context1, NULL, 1000000), ED247_STATUS_SUCCESS);
+    sender.join();
+    ASSERT_EQ(ed247_stream_pop_sample(stream1, &sample, &sample_size, NULL, NULL, NULL, NULL), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_unload(context2), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_unload(context1), ED247_STATUS_SUCCESS);
+}
+
+#ifdef __linux__
+/******************************************************************************
+Shared memory transport: the frames are exchanged through rings in /dev/shm.
+******************************************************************************/
+TEST(UtApiStreams, ShmTransport)
+{
+    ed247_context_t context1, context2;
+    ed247_stream_t stream1, stream2;
+    const void* sample;
+    uint32_t sample_size;
+    bool empty;
+
+    // Remove the ring and the doorbell from /dev/shm once the contexts are unloaded, even if an assertion fails
+    struct ShmCleanup {
+        ~ShmCleanup() {
+            shm_unlink("/ed247_127.0.0.1_2591");
+            shm_unlink("/ed247_doorbell");
+        }
+    } shm_cleanup;
+
+    ASSERT_EQ(ed247_set_transport(ED247_TRANSPORT_SHM), ED247_STATUS_SUCCESS);
+    std::string filepath = config_path+"/ecic_unit_api_streams_loopback.xml";
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context1), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_load_file(filepath.c_str(), &context2), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_set_transport(ED247_TRANSPORT_UDP), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context1, "Stream3", &stream1), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context2, "Stream3", &stream2), ED247_STATUS_SUCCESS);
+
+    ASSERT_EQ(ed247_wait_frame(context1, NULL, 1000), ED247_STATUS_TIMEOUT);
+
+    // More frames than the ring capacity: the records wrap around the end of the ring
+    for (uint32_t index = 0; index < 40000; index++) {
+        uint8_t sent_sample[4] = { (uint8_t)index, (uint8_t)(index >> 8), (uint8_t)(index >> 16), 3 };
+        ASSERT_EQ(ed247_stream_push_sample(stream1, sent_sample, sizeof(sent_sample), NULL, NULL), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(ed247_send_pushed_samples(context1), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(ed247_wait_frame(context2, NULL, 1000000), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(ed247_stream_pop_sample(stream2, &sample, &sample_size, NULL, NULL, NULL, &empty), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(sample_size, sizeof(sent_sample));
+        ASSERT_EQ(memcmp(sample, sent_sample, sizeof(sent_sample)), 0);
+        ASSERT_TRUE(empty);
+    }
+
+    // context1 is late by more than the ring capacity: the pending frames are lost
+    ASSERT_EQ(ed247_wait_frame(context1, NULL, 0), ED247_STATUS_TIMEOUT);
+
+    // Delivered by another thread
+    std::thread sender([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        uint8_t sent_sample[4] = { 42, 1, 2, 3 };
+        ed247_stream_push_sample(stream2, sent_sample, sizeof(sent_sample), NULL, NULL);
+        ed247_send_pushed_samples(context2);
+    });
+    ASSERT_EQ(ed247_wait_frame(context1, NULL, 1000000), ED247_STATUS_SUCCESS);
+    sender.join();
+    ASSERT_EQ(ed247_stream_pop_sample(stream1, &sample, &sample_size, NULL, NULL, NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(((const uint8_t*)sample)[0], 42);
+
+    ASSERT_EQ(ed247_unload(context2), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_unload(context1), ED247_STATUS_SUCCESS);
+}
+#endif
+
+#ifdef ED247_IO_URING_ENABLED
+/******************************************************************************
+io_uring engine: the contexts are loaded with ED247_IO_URING=1.
+******************************************************************************/
+static ed247_status_t load_with_io_uring(const std::string& filepath, ed247_context_t* context)
+{
+    const char* io_uring_env = getenv("ED247_IO_URING");
+    std::string io_uring_saved = io_uring_env ? io_uring_env : "";
+    setenv("ED247_IO_URING", "1", 1);
+    ed247_status_t status = ed247_load_file(filepath.c_str(), context);
+    if (io_uring_env) setenv("ED247_IO_URING", io_uring_saved.c_str(), 1);
+    else unsetenv("ED247_IO_URING");
+    return status;
+}
+
+static bool uses_io_uring(ed247_context_t context)
+{
+    return static_cast<ed247::Context*>(context)->get_receiver_set().get_uring() != nullptr;
+}
+
+// Store the first sample byte of the frames decoded by the LoopbackChannel
+static void store_frame_index(ed247_context_t, ed247_channel_t, const void* frame, uint32_t frame_size, void* user_data)
+{
+    if (frame_size >= 2) ((std::vector<uint8_t>*)user_data)->push_back(((const uint8_t*)frame)[1]);
+}
+
+// Send frame_count frames of the LoopbackChannel (no header, a single A825 sample whose first byte is the index).
+// With the io_uring engine, they are queued until the next submission.
+static void send_indexed_frames(ed247_channel_t channel, uint32_t first_index, uint32_t frame_count)
+{
+    for (uint32_t index = first_index; index < first_index + frame_count; index++) {
+        uint8_t frame[5] = { 4, (uint8_t)index, 1, 2, 3 };
+        ASSERT_EQ(ed247_channel_send_frame(channel, frame, sizeof(frame)), ED247_STATUS_SUCCESS);
+    }
+}
+
+// Wait for frame_count frames and check they are received in order
+static void check_indexed_frames(ed247_context_t context, const std::vector<uint8_t>& indexes, uint32_t frame_count)
+{
+    for (uint32_t retry = 0; indexes.size() < frame_count && retry < 100; retry++) {
+        ed247_wait_frame(context, NULL, 10000);
+    }
+    ASSERT_EQ(indexes.size(), frame_count);
+    for (uint32_t index = 0; index < frame_count; index++) {
+        ASSERT_EQ(indexes[index], (uint8_t)index);
+    }
+}
+
+/******************************************************************************
+More frames queued before a submission than the send slots (64): the engine
+waits for the completion of the first sends to reuse their slots.
+******************************************************************************/
+TEST(UtApiStreams, IoUringSendSlotsInUse)
+{
+    ed247_context_t context;
+    ed247_channel_t channel;
+    std::vector<uint8_t> indexes;
+
+    std::string filepath = config_path+"/ecic_unit_api_streams_loopback.xml";
+    ASSERT_EQ(load_with_io_uring(filepath, &context), ED247_STATUS_SUCCESS);
+    ASSERT_TRUE(uses_io_uring(context));
+    ASSERT_EQ(ed247_get_channel(context, "LoopbackChannel", &channel), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_set_frame_recv_callback(context, &store_frame_index, &indexes), ED247_STATUS_SUCCESS);
+
+    send_indexed_frames(channel, 0, 150);
+    ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+    check_indexed_frames(context, indexes, 150);
+
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+
+/******************************************************************************
+More frames pending than the receive buffers (32): the multishot receive
+stops and is armed again once the received frames are delivered.
+******************************************************************************/
+TEST(UtApiStreams, IoUringReceiveBuffersExhausted)
+{
+    ed247_context_t context;
+    ed247_channel_t channel;
+    std::vector<uint8_t> indexes;
+
+    std::string filepath = config_path+"/ecic_unit_api_streams_loopback.xml";
+    ASSERT_EQ(load_with_io_uring(filepath, &context), ED247_STATUS_SUCCESS);
+    ASSERT_TRUE(uses_io_uring(context));
+    ASSERT_EQ(ed247_get_channel(context, "LoopbackChannel", &channel), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_set_frame_recv_callback(context, &store_frame_index, &indexes), ED247_STATUS_SUCCESS);
+
+    // Submitted by batches of 10, without receiving
+    for (uint32_t first_index = 0; first_index < 100; first_index += 10) {
+        send_indexed_frames(channel, first_index, 10);
+        ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+    }
+    check_indexed_frames(context, indexes, 100);
+
+    // The receiver is still armed
+    indexes.clear();
+    send_indexed_frames(channel, 0, 1);
+    ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+    check_indexed_frames(context, indexes, 1);
+
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+
+/******************************************************************************
+The busy poll mode, the readiness fd and the datagram recording replace the
+io_uring engine: the frames still queued are sent and none is lost.
+******************************************************************************/
+static void record_nothing(ed247_context_t, ed247_channel_t, const ed247_datagram_info_t*, const void*, uint32_t, void*)
+{
+}
+
+TEST(UtApiStreams, IoUringDisabledWithQueuedSends)
+{
+    std::string filepath = config_path+"/ecic_unit_api_streams_loopback.xml";
+
+    for (uint32_t reason = 0; reason < 3; reason++) {
+        SAY("Replace the io_uring engine, reason " << reason);
+        ed247_context_t context;
+        ed247_channel_t channel;
+        std::vector<uint8_t> indexes;
+        int fd;
+
+        ASSERT_EQ(load_with_io_uring(filepath, &context), ED247_STATUS_SUCCESS);
+        ASSERT_TRUE(uses_io_uring(context));
+        ASSERT_EQ(ed247_get_channel(context, "LoopbackChannel", &channel), ED247_STATUS_SUCCESS);
+        ASSERT_EQ(ed247_set_frame_recv_callback(context, &store_frame_index, &indexes), ED247_STATUS_SUCCESS);
+
+        send_indexed_frames(channel, 0, 5);
+        switch (reason) {
+        case 0: ASSERT_EQ(ed247_component_set_busy_poll(context, 100, 0), ED247_STATUS_SUCCESS); break;
+        case 1: ASSERT_EQ(ed247_get_readiness_fd(context, &fd), ED247_STATUS_SUCCESS); break;
+        case 2: ASSERT_EQ(ed247_set_datagram_recv_callback(context, &record_nothing, NULL), ED247_STATUS_SUCCESS); break;
+        }
+        ASSERT_FALSE(uses_io_uring(context));
+        check_indexed_frames(context, indexes, 5);
+
+        ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+    }
+}
+
+/******************************************************************************
+The frames of an address shared by several channels are dispatched to the
+sibling receivers by the frames delivered by the engine.
+******************************************************************************/
+TEST(UtApiStreams, IoUringSharedAddressChannels)
+{
+    ed247_context_t context;
+    ed247_channel_t channel_a;
+    ed247_stream_t stream_a, stream_b;
+    const void* sample;
+    uint32_t sample_size;
+
+    std::string filepath = config_path+"/ecic_unit_api_streams_shared_address.xml";
+    ASSERT_EQ(load_with_io_uring(filepath, &context), ED247_STATUS_SUCCESS);
+    ASSERT_TRUE(uses_io_uring(context));
+    ASSERT_EQ(ed247_get_channel(context, "SharedAddressChannelA", &channel_a), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "StreamA", &stream_a), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_get_stream(context, "StreamB", &stream_b), ED247_STATUS_SUCCESS);
+
+    uint8_t mixed_frame[] = { /* UID */ 0, 1, /* Size */ 0, 5, 4, 0xA, 1, 2, 3,
+                              /* UID */ 0, 2, /* Size */ 0, 5, 4, 0xB, 1, 2, 3 };
+    ASSERT_EQ(ed247_channel_send_frame(channel_a, mixed_frame, sizeof(mixed_frame)), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_send_pushed_samples(context), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_wait_during(context, NULL, 20000), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(ed247_stream_pop_sample(stream_a, &sample, &sample_size, NULL, NULL, NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(((const uint8_t*)sample)[0], 0xA);
+    ASSERT_EQ(ed247_stream_pop_sample(stream_b, &sample, &sample_size, NULL, NULL, NULL, NULL), ED247_STATUS_SUCCESS);
+    ASSERT_EQ(((const uint8_t*)sample)[0], 0xB);
+
+    ASSERT_EQ(ed247_unload(context), ED247_STATUS_SUCCESS);
+}
+#endif
+
 int main(int argc, char **argv)
 {
     if(argc >=1)
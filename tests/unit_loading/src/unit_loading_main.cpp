@@ -24,6 +24,7 @@
 
 #include "single_actor_test.h"
 #include "ed247_xml.h"
+#include <fstream>
 
 std::string config_path = "../config";
 
@@ -51,6 +52,107 @@ TEST_P(LoadingContext, Loading)
     }
 };
 
+TEST_P(LoadingContext, Streaming)
+{
+    std::string filepath = GetParam();
+    RecordProperty("description", strize() << "Streaming load of [" << GetParam() << "]");
+
+    std::unique_ptr<ed247::xml::Component> component = ed247::xml::load_filepath(filepath);
+    std::unique_ptr<ed247::xml::Component> streamed = ed247::xml::load_filepath_streaming(filepath);
+
+    ASSERT_EQ(streamed->_name, component->_name);
+    ASSERT_EQ(streamed->_file_producer_identifier, component->_file_producer_identifier);
+    ASSERT_EQ(streamed->_channel_list.size(), component->_channel_list.size());
+    for (uint32_t c = 0; c < component->_channel_list.size(); c++) {
+        const ed247::xml::Channel& channel = component->_channel_list[c];
+        const ed247::xml::Channel& streamed_channel = streamed->_channel_list[c];
+        ASSERT_EQ(streamed_channel._name, channel._name);
+        ASSERT_EQ(streamed_channel._is_simple_channel, channel._is_simple_channel);
+        ASSERT_EQ(streamed_channel._com_interface._udp_sockets.size(), channel._com_interface._udp_sockets.size());
+        ASSERT_EQ(streamed_channel._stream_list.size(), channel._stream_list.size());
+        for (uint32_t s = 0; s < channel._stream_list.size(); s++) {
+            ASSERT_EQ(streamed_channel._stream_list[s]->_name, channel._stream_list[s]->_name);
+            ASSERT_EQ(streamed_channel._stream_list[s]->_direction, channel._stream_list[s]->_direction);
+            ASSERT_EQ(streamed_channel._stream_list[s]->_sample_max_size_bytes, channel._stream_list[s]->_sample_max_size_bytes);
+        }
+    }
+}
+
+TEST_P(LoadingContext, CompiledRoundTrip)
+{
+    std::string filepath = GetParam();
+    std::string compiled_filepath = "unit_loading.ecic.bin";
+    RecordProperty("description", strize() << "Compile and reload [" << GetParam() << "]");
+
+    std::unique_ptr<ed247::xml::Component> component = ed247::xml::load_filepath(filepath);
+    ed247::xml::save_compiled(*component, compiled_filepath);
+    std::unique_ptr<ed247::xml::Component> compiled = ed247::xml::load_compiled(compiled_filepath);
+
+    ASSERT_EQ(compiled->_name, component->_name);
+    ASSERT_EQ(compiled->_identifier, component->_identifier);
+    ASSERT_EQ(compiled->_channel_list.size(), component->_channel_list.size());
+    for (uint32_t c = 0; c < component->_channel_list.size(); c++) {
+        const ed247::xml::Channel& channel = component->_channel_list[c];
+        const ed247::xml::Channel& compiled_channel = compiled->_channel_list[c];
+        ASSERT_EQ(compiled_channel._name, channel._name);
+        ASSERT_EQ(compiled_channel._com_interface._udp_sockets.size(), channel._com_interface._udp_sockets.size());
+        ASSERT_EQ(compiled_channel._stream_list.size(), channel._stream_list.size());
+        for (uint32_t s = 0; s < channel._stream_list.size(); s++) {
+            const ed247::xml::Stream& stream = *channel._stream_list[s];
+            const ed247::xml::Stream& compiled_stream = *compiled_channel._stream_list[s];
+            ASSERT_EQ(compiled_stream._name, stream._name);
+            ASSERT_EQ(compiled_stream._type, stream._type);
+            ASSERT_EQ(compiled_stream._uid, stream._uid);
+            ASSERT_EQ(compiled_stream._sample_max_size_bytes, stream._sample_max_size_bytes);
+            ASSERT_EQ(compiled_stream.is_signal_based(), stream.is_signal_based());
+            if (stream.is_signal_based()) {
+                auto& signals = static_cast<const ed247::xml::StreamSignals&>(stream)._signal_list;
+                auto& compiled_signals = static_cast<const ed247::xml::StreamSignals&>(compiled_stream)._signal_list;
+                ASSERT_EQ(compiled_signals.size(), signals.size());
+                for (uint32_t i = 0; i < signals.size(); i++) {
+                    ASSERT_EQ(compiled_signals[i]->_name, signals[i]->_name);
+                    ASSERT_EQ(compiled_signals[i]->get_sample_max_size_bytes(), signals[i]->get_sample_max_size_bytes());
+                }
+            }
+        }
+    }
+    std::remove(compiled_filepath.c_str());
+}
+
+TEST(LoadingCompiled, IntegrityCheck)
+{
+    std::string compiled_filepath = "unit_loading_corrupted.ecic.bin";
+    ed247::xml::save_compiled(*ed247::xml::load_filepath(config_path + "/ecic_unit_loading_nad.xml"), compiled_filepath);
+
+    // Flip one byte of the payload
+    std::fstream file(compiled_filepath, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekg(-1, std::ios::end);
+    char last = file.get();
+    file.seekp(-1, std::ios::end);
+    file.put(last ^ 0xFF);
+    file.close();
+
+    ASSERT_THROW(ed247::xml::load_compiled(compiled_filepath), std::exception);
+    ASSERT_THROW(ed247::xml::load_compiled(config_path + "/ecic_unit_loading_nad.xml"), std::exception);
+    std::remove(compiled_filepath.c_str());
+}
+
+TEST(LoadingCompiled, LibraryVersionCheck)
+{
+    std::string compiled_filepath = "unit_loading_version.ecic.bin";
+    ed247::xml::save_compiled(*ed247::xml::load_filepath(config_path + "/ecic_unit_loading_nad.xml"), compiled_filepath);
+    ASSERT_NE(ed247::xml::load_compiled(compiled_filepath), nullptr);
+
+    // Change the library version, stored after the magic, the format version and the byte order mark
+    std::fstream file(compiled_filepath, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(8 + 2 * sizeof(uint32_t));
+    file.put('#');
+    file.close();
+
+    ASSERT_THROW(ed247::xml::load_compiled(compiled_filepath), std::exception);
+    std::remove(compiled_filepath.c_str());
+}
+
 std::vector<std::string> configuration_files;
 
 INSTANTIATE_TEST_CASE_P(LoadingTests, LoadingContext,
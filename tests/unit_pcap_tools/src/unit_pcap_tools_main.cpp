@@ -0,0 +1,207 @@
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+
+#include "single_actor_test.h"
+#include "pcap_tools.h"
+#include <cstdio>
+
+namespace {
+    void append_be16(std::vector<char>& buffer, uint16_t value)
+    {
+        buffer.push_back((char)(value >> 8));
+        buffer.push_back((char)value);
+    }
+
+    void append_be32(std::vector<char>& buffer, uint32_t value)
+    {
+        append_be16(buffer, (uint16_t)(value >> 16));
+        append_be16(buffer, (uint16_t)value);
+    }
+
+    // Host byte order, or swapped to mimic a capture of a foreign host
+    void append_u32(std::vector<char>& buffer, uint32_t value, bool swapped)
+    {
+        if (swapped) {
+            append_be32(buffer, value);
+        } else {
+            buffer.insert(buffer.end(), (const char*)&value, (const char*)&value + sizeof(value));
+        }
+    }
+
+    // IPv4 header (no checksum) followed by an UDP datagram, or by a payload of another protocol
+    std::vector<char> ip_packet(uint32_t source_ip, uint16_t source_port, uint32_t destination_ip, uint16_t destination_port,
+                                const std::string& payload, uint8_t protocol = 17)
+    {
+        std::vector<char> packet;
+        packet.push_back(0x45);
+        packet.push_back(0);
+        append_be16(packet, (uint16_t)(20 + 8 + payload.size()));
+        append_be32(packet, 0);                  // Identification, no fragment
+        packet.push_back(64);
+        packet.push_back((char)protocol);
+        append_be16(packet, 0);
+        append_be32(packet, source_ip);
+        append_be32(packet, destination_ip);
+        append_be16(packet, source_port);
+        append_be16(packet, destination_port);
+        append_be16(packet, (uint16_t)(8 + payload.size()));
+        append_be16(packet, 0);
+        packet.insert(packet.end(), payload.begin(), payload.end());
+        return packet;
+    }
+
+    void append_pcap_record(std::vector<char>& file, uint32_t seconds, uint32_t fraction, const std::vector<char>& packet, bool swapped)
+    {
+        append_u32(file, seconds, swapped);
+        append_u32(file, fraction, swapped);
+        append_u32(file, packet.size(), swapped);
+        append_u32(file, packet.size(), swapped);
+        file.insert(file.end(), packet.begin(), packet.end());
+    }
+
+    void write_file(const std::string& path, const std::vector<char>& content)
+    {
+        FILE* file = fopen(path.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        ASSERT_EQ(fwrite(content.data(), 1, content.size(), file), content.size());
+        fclose(file);
+    }
+}
+
+/******************************************************************************
+The datagrams written by the pcapng writer are read back unchanged
+******************************************************************************/
+TEST(UtPcapTools, PcapngWriteRead)
+{
+    const std::string path = "unit_pcap_tools.pcapng";
+    const std::string payloads[3] = { "A", "Frame of 13 B", std::string(1500, '\x5A') };
+
+    pcap::Writer writer;
+    ASSERT_FALSE(writer.write(0, 0, 0, 0, 0, "", 0, ""));
+    ASSERT_TRUE(writer.open(path));
+    ASSERT_TRUE(writer.write(1000000000123456789ULL, 0x7F000001, 1234, 0xE0010203, 2590, payloads[0].data(), payloads[0].size(), "Channel0"));
+    ASSERT_TRUE(writer.write(1000000000123456790ULL, 0x0A000001, 40000, 0x0A000002, 2591, payloads[1].data(), payloads[1].size(), ""));
+    ASSERT_TRUE(writer.write(1000000001000000000ULL, 0x0A000001, 40000, 0x0A000002, 2591, payloads[2].data(), payloads[2].size(), "A longer channel name"));
+    ASSERT_EQ(writer.get_datagram_count(), 3u);
+    writer.close();
+
+    pcap::Reader reader;
+    pcap::datagram_t datagram;
+    ASSERT_TRUE(reader.open(path));
+
+    ASSERT_TRUE(reader.next(datagram));
+    ASSERT_EQ(datagram.timestamp_ns, 1000000000123456789ULL);
+    ASSERT_EQ(datagram.source_ip, 0x7F000001u);
+    ASSERT_EQ(datagram.source_port, 1234);
+    ASSERT_EQ(datagram.destination_ip, 0xE0010203u);
+    ASSERT_EQ(datagram.destination_port, 2590);
+    ASSERT_EQ(std::string(datagram.payload.begin(), datagram.payload.end()), payloads[0]);
+    ASSERT_EQ(datagram.comment, "Channel0");
+
+    ASSERT_TRUE(reader.next(datagram));
+    ASSERT_EQ(datagram.timestamp_ns, 1000000000123456790ULL);
+    ASSERT_EQ(std::string(datagram.payload.begin(), datagram.payload.end()), payloads[1]);
+    ASSERT_EQ(datagram.comment, "");
+
+    ASSERT_TRUE(reader.next(datagram));
+    ASSERT_EQ(datagram.timestamp_ns, 1000000001000000000ULL);
+    ASSERT_EQ(datagram.destination_port, 2591);
+    ASSERT_EQ(std::string(datagram.payload.begin(), datagram.payload.end()), payloads[2]);
+    ASSERT_EQ(datagram.comment, "A longer channel name");
+
+    ASSERT_FALSE(reader.next(datagram));
+    ASSERT_EQ(reader.get_skipped_count(), 0u);
+    reader.close();
+    remove(path.c_str());
+}
+
+/******************************************************************************
+Classic pcap captures of both byte orders, with the link layers of capture tools
+******************************************************************************/
+TEST(UtPcapTools, PcapRead)
+{
+    const std::string path = "unit_pcap_tools.pcap";
+    pcap::Reader reader;
+    pcap::datagram_t datagram;
+
+    // Host byte order, microseconds, Ethernet with a VLAN tag
+    std::vector<char> file;
+    append_u32(file, 0xA1B2C3D4, false);
+    append_u32(file, 0x00040002, false);        // Version 2.4 (two uint16)
+    append_u32(file, 0, false);
+    append_u32(file, 0, false);
+    append_u32(file, 0xFFFF, false);
+    append_u32(file, 1, false);                 // LINKTYPE_ETHERNET
+    std::vector<char> frame(12, 0);
+    append_be16(frame, 0x8100);
+    append_be16(frame, 42);
+    append_be16(frame, 0x0800);
+    std::vector<char> packet = ip_packet(0x0A000001, 5000, 0x0A000002, 2590, "Ethernet");
+    frame.insert(frame.end(), packet.begin(), packet.end());
+    append_pcap_record(file, 100, 250000, frame, false);
+    write_file(path, file);
+
+    ASSERT_TRUE(reader.open(path));
+    ASSERT_TRUE(reader.next(datagram));
+    ASSERT_EQ(datagram.timestamp_ns, 100250000000ULL);
+    ASSERT_EQ(datagram.source_ip, 0x0A000001u);
+    ASSERT_EQ(datagram.source_port, 5000);
+    ASSERT_EQ(datagram.destination_port, 2590);
+    ASSERT_EQ(std::string(datagram.payload.begin(), datagram.payload.end()), "Ethernet");
+    ASSERT_FALSE(reader.next(datagram));
+
+    // Foreign byte order, nanoseconds, raw IP. Non UDP packets are skipped.
+    file.clear();
+    append_u32(file, 0xA1B23C4D, true);
+    append_u32(file, 0x00020004, true);
+    append_u32(file, 0, true);
+    append_u32(file, 0, true);
+    append_u32(file, 0xFFFF, true);
+    append_u32(file, 101, true);                // LINKTYPE_RAW
+    append_pcap_record(file, 7, 5, ip_packet(1, 1, 2, 2, "TCP", 6), true);
+    append_pcap_record(file, 8, 999999999, ip_packet(0xC0A80001, 6000, 0xC0A80002, 2591, "Raw"), true);
+    write_file(path, file);
+
+    ASSERT_TRUE(reader.open(path));
+    ASSERT_TRUE(reader.next(datagram));
+    ASSERT_EQ(datagram.timestamp_ns, 8999999999ULL);
+    ASSERT_EQ(datagram.destination_ip, 0xC0A80002u);
+    ASSERT_EQ(datagram.destination_port, 2591);
+    ASSERT_EQ(std::string(datagram.payload.begin(), datagram.payload.end()), "Raw");
+    ASSERT_FALSE(reader.next(datagram));
+    ASSERT_EQ(reader.get_skipped_count(), 1u);
+
+    // Not a capture
+    write_file(path, std::vector<char>(64, 'x'));
+    ASSERT_FALSE(reader.open(path));
+    remove(path.c_str());
+    ASSERT_FALSE(reader.open(path));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
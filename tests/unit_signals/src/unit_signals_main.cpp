@@ -30,10 +30,14 @@ class TEST_CLASS_NAME(SignalContext, SinglePushPop);
 #include "single_actor_test.h"
 #include "ed247_context.h"
 #include "ed247_stream_assistant.h"
+#include "ed247_signal_accessor.h"
+#include "ed247_swap_copy.h"
 #include "ed247_bswap.h"
 
 class SignalContext : public ::testing::TestWithParam<std::string> {};
 
+extern std::vector<std::string> configuration_files;
+
 void swap_copy(const char *source_data, char* dest_data, const ed247_nad_type_t& nad_type)
 {
   switch(nad_type) {
@@ -139,7 +143,7 @@ TEST_P(SignalContext, SinglePushPop)
   ASSERT_EQ(stream->get_outgoing_sample_number(), (uint32_t)1);
   ASSERT_EQ(stream_sample.size(), assistant->_buffer.size());
 
-  swap_payload(stream_sample.data(), stream_sample.data_rw(), stream_sample.size(), signal->get_nad_type());
+  swap_payload(stream_sample.data(), stream_sample.data_rw(), stream_sample.size(), stream->get_signals().front()->get_nad_type());
   ASSERT_EQ(memcmp(stream_sample.data(), assistant->_buffer.data(), stream_sample.size()), 0);
 
   // Check pop & read
@@ -163,6 +167,78 @@ TEST_P(SignalContext, SinglePushPop)
   delete context;
 }
 
+// Typed accessors shall produce the same assistant buffer than the generic write()
+template<ed247_nad_type_t NAD_TYPE>
+void check_accessor(ed247::StreamAssistant* assistant, ed247::Stream* stream, const char* signal_name,
+                    typename ed247::SignalAccessor<NAD_TYPE>::value_t value)
+{
+  ed247::Signal* signal = stream->get_signal(signal_name).get();
+  ed247::SignalAccessor<NAD_TYPE> accessor(assistant, signal);
+  ASSERT_TRUE(accessor.is_bound());
+  ASSERT_EQ(accessor.get_count(), (uint32_t)1);
+
+  const void* data;
+  uint32_t size;
+  accessor.write(value);
+  ASSERT_TRUE(assistant->was_written());
+  ASSERT_TRUE(assistant->read(*signal, &data, &size));
+  std::string typed_result((const char*)data, size);
+
+  ASSERT_TRUE(assistant->write(*signal, &value, sizeof(value)));
+  ASSERT_TRUE(assistant->read(*signal, &data, &size));
+  ASSERT_EQ(typed_result, std::string((const char*)data, size));
+
+  // The buffer of an input stream contains host values once popped
+  ed247_signal_binding_t binding;
+  ASSERT_EQ(ed247_stream_assistant_bind_signal(assistant, signal, NAD_TYPE, &binding), ED247_STATUS_SUCCESS);
+  ASSERT_EQ(binding.size, (uint32_t)sizeof(value));
+  memcpy(binding.data, &value, sizeof(value));
+  ASSERT_EQ(accessor.read(), value);
+}
+
+TEST(SignalAccessor, TypedNAD)
+{
+  ed247::Context* context = ed247::Context::create_from_filepath(configuration_files[2]);
+  ed247::Stream* stream = context->get_stream_set().get("StreamTypes").get();
+  ASSERT_NE(stream, nullptr);
+  ed247::StreamAssistant* assistant = stream->get_assistant();
+
+  check_accessor<ED247_NAD_TYPE_UINT8>(assistant, stream, "NAD_SignalTypes_uint8", 0xA5);
+  check_accessor<ED247_NAD_TYPE_UINT16>(assistant, stream, "NAD_SignalTypes_uint16", 0x1234);
+  check_accessor<ED247_NAD_TYPE_UINT32>(assistant, stream, "NAD_SignalTypes_uint32", 0x12345678);
+  check_accessor<ED247_NAD_TYPE_UINT64>(assistant, stream, "NAD_SignalTypes_uint64", 0x123456789ABCDEF0ULL);
+  check_accessor<ED247_NAD_TYPE_INT8>(assistant, stream, "NAD_SignalTypes_int8", -12);
+  check_accessor<ED247_NAD_TYPE_INT16>(assistant, stream, "NAD_SignalTypes_int16", -1234);
+  check_accessor<ED247_NAD_TYPE_INT32>(assistant, stream, "NAD_SignalTypes_int32", -123456);
+  check_accessor<ED247_NAD_TYPE_INT64>(assistant, stream, "NAD_SignalTypes_int64", -123456789012LL);
+  check_accessor<ED247_NAD_TYPE_FLOAT32>(assistant, stream, "NAD_SignalTypes_float32", 3.25f);
+  check_accessor<ED247_NAD_TYPE_FLOAT64>(assistant, stream, "NAD_SignalTypes_float64", -1.0e100);
+
+  // Bind errors
+  ed247::SignalAccessor<ED247_NAD_TYPE_INT16> accessor;
+  ASSERT_FALSE(accessor.is_bound());
+  ASSERT_FALSE(accessor.bind(assistant, stream->get_signal("NAD_SignalTypes_uint16").get()));
+  ASSERT_FALSE(accessor.is_bound());
+  ed247::Stream* other_stream = context->get_stream_set().get("StreamInput").get();
+  ASSERT_FALSE(accessor.bind(other_stream->get_assistant(), stream->get_signal("NAD_SignalTypes_int16").get()));
+  ASSERT_TRUE(accessor.bind(assistant, stream->get_signal("NAD_SignalTypes_int16").get()));
+
+  // Arrays
+  ed247::Stream* square_stream = context->get_stream_set().get("StreamSquare").get();
+  ed247::SignalAccessor<ED247_NAD_TYPE_FLOAT32> square(square_stream->get_assistant(), square_stream->get_signal("NAD_Signal_Square_in1").get());
+  ASSERT_EQ(square.get_count(), (uint32_t)4);
+  square.write(3, 1.5f);
+  const void* data;
+  uint32_t size;
+  float expected = 1.5f;
+  char swapped[sizeof(float)];
+  ed247::swap_copy<4>((const char*)&expected, swapped, sizeof(float));
+  ASSERT_TRUE(square_stream->get_assistant()->read(*square_stream->get_signal("NAD_Signal_Square_in1"), &data, &size));
+  ASSERT_EQ(memcmp((const char*)data + 3 * sizeof(float), swapped, sizeof(float)), 0);
+
+  delete context;
+}
+
 std::vector<std::string> configuration_files;
 
 INSTANTIATE_TEST_CASE_P(SignalTests, SignalContext,
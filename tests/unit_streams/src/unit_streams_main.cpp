@@ -86,6 +86,12 @@ TEST(StreamSampleRingBuffer, Main)
 
     cbuffer.pop_front();
     ASSERT_FALSE(cbuffer.empty());
+
+    cbuffer.drop_front(2);
+    ASSERT_EQ(cbuffer.size(), (uint32_t)1);
+    ASSERT_EQ(*(uint32_t*)(cbuffer.front().data()), (uint32_t)5);
+    cbuffer.drop_front(10);
+    ASSERT_TRUE(cbuffer.empty());
 }
 
 class StreamContext : public ::testing::TestWithParam<std::string>
@@ -152,6 +158,11 @@ TEST_P(StreamContext, SinglePushPop)
         ASSERT_EQ(streams_1.size(), (uint32_t)1);
         auto stream_1 = streams_1[0];
 
+        // Name lookups do not allocate
+        malloc_count_start();
+        ASSERT_EQ(stream_1->get_signal("UnknownSignal"), nullptr);
+        ASSERT_EQ(malloc_count_stop(), 0);
+
         // Create a stream sample compatible with the stream
         ed247::StreamSample stream_1_sample(stream_1->get_sample_max_size_bytes());
         ASSERT_EQ(stream_1_sample.size(), (uint32_t)0);
@@ -503,6 +514,101 @@ TEST_P(StreamContext, MultiPushPopDataTimestamp)
 }
 
 
+TEST_P(StreamContext, Conflation)
+{
+    std::string filepath = GetParam();
+    ed247::Context* context = ed247::Context::create_from_filepath(filepath);
+    ed247::stream_ptr_t stream_out = context->get_stream_set().get("Stream1");
+    ASSERT_NE(stream_out, nullptr);
+
+    if (stream_out->is_signal_based() == false) {
+        ASSERT_FALSE(stream_out->set_conflation(true));
+        ASSERT_FALSE(stream_out->get_conflation());
+        delete context;
+        return;
+    }
+
+    // Encode a frame of several samples
+    ed247::StreamSample stream_sample(stream_out->get_sample_max_size_bytes());
+    std::string str_sample;
+    for(uint32_t i = 0 ; i < 5 ; i++){
+        str_sample = strize() << std::setw(stream_out->get_sample_max_size_bytes()) << std::setfill('0') << i;
+        stream_sample.copy(str_sample.c_str(), stream_out->get_sample_max_size_bytes());
+        ASSERT_TRUE(stream_out->push_sample(stream_sample.data(), stream_sample.size(), NULL, NULL));
+    }
+    ed247::Sample buffer(stream_out->get_max_size());
+    buffer.set_size(stream_out->encode(buffer.data_rw(), buffer.capacity()));
+
+    // Decode it in a compatible input stream
+    ed247::stream_ptr_t stream_in = context->get_stream_set().get("StreamInput");
+    ASSERT_NE(stream_in, nullptr);
+    ASSERT_EQ(stream_in->get_sample_max_size_bytes(), stream_out->get_sample_max_size_bytes());
+
+    // Without conflation, all samples are queued (up to the stack size)
+    ASSERT_TRUE(stream_in->decode(buffer.data(), buffer.size(), LIBED247_SAMPLE_DETAILS_DEFAULT));
+    ASSERT_EQ(stream_in->get_incoming_sample_number(), std::min((uint32_t)5, stream_in->get_sample_max_number()));
+
+    // Enabling conflation only keeps the newest sample
+    ASSERT_TRUE(stream_in->set_conflation(true));
+    ASSERT_TRUE(stream_in->get_conflation());
+    ASSERT_EQ(stream_in->get_incoming_sample_number(), (uint32_t)1);
+
+    // Each decoded frame replaces the previous sample by its last one
+    for (uint32_t frame = 0; frame < 2; frame++) {
+        malloc_count_start();
+        ASSERT_TRUE(stream_in->decode(buffer.data(), buffer.size(), LIBED247_SAMPLE_DETAILS_DEFAULT));
+        ASSERT_EQ(malloc_count_stop(), 0);
+        ASSERT_EQ(stream_in->get_incoming_sample_number(), (uint32_t)1);
+    }
+    bool empty;
+    auto& sample = stream_in->pop_sample(&empty);
+    ASSERT_TRUE(empty);
+    ASSERT_EQ(std::string(sample.data(), sample.size()), str_sample);
+
+    // Malformed trailing bytes do not drop the newest valid sample of the frame
+    std::string truncated_frame(buffer.data(), buffer.size());
+    truncated_frame.push_back('\x01');
+    ASSERT_FALSE(stream_in->decode(truncated_frame.data(), truncated_frame.size(), LIBED247_SAMPLE_DETAILS_DEFAULT));
+    ASSERT_EQ(stream_in->get_incoming_sample_number(), (uint32_t)1);
+    auto& last_sample = stream_in->pop_sample(&empty);
+    ASSERT_EQ(std::string(last_sample.data(), last_sample.size()), str_sample);
+
+    ASSERT_TRUE(stream_in->set_conflation(false));
+    ASSERT_FALSE(stream_in->get_conflation());
+    delete context;
+}
+
+static uint32_t non_input_callback_count = 0;
+static ed247_status_t count_non_input_callback(ed247_context_t, ed247_stream_t)
+{
+    non_input_callback_count++;
+    return ED247_STATUS_SUCCESS;
+}
+
+TEST_P(StreamContext, NonInputStreamCallbacks)
+{
+    std::string filepath = GetParam();
+    ed247::Context* context = ed247::Context::create_from_filepath(filepath);
+    ed247::stream_ptr_t stream_out = context->get_stream_set().get("Stream1");
+    ASSERT_NE(stream_out, nullptr);
+    ASSERT_EQ(stream_out->get_direction() & ED247_DIRECTION_IN, 0);
+
+    ed247::StreamSample stream_sample(stream_out->get_sample_max_size_bytes());
+    std::string str_sample = strize() << std::setw(stream_out->get_sample_max_size_bytes()) << std::setfill('0') << 1;
+    stream_sample.copy(str_sample.c_str(), stream_out->get_sample_max_size_bytes());
+    ASSERT_TRUE(stream_out->push_sample(stream_sample.data(), stream_sample.size(), NULL, NULL));
+    ed247::Sample buffer(stream_out->get_max_size());
+    buffer.set_size(stream_out->encode(buffer.data_rw(), buffer.capacity()));
+
+    // The samples received on a non-input stream are not stored, but its callbacks are still run
+    non_input_callback_count = 0;
+    ASSERT_EQ(stream_out->register_callback(nullptr, &count_non_input_callback), ED247_STATUS_SUCCESS);
+    ASSERT_TRUE(stream_out->decode(buffer.data(), buffer.size(), LIBED247_SAMPLE_DETAILS_DEFAULT));
+    ASSERT_EQ(non_input_callback_count, 1U);
+    ASSERT_EQ(stream_out->get_incoming_sample_number(), 0U);
+    delete context;
+}
+
 std::vector<std::string> configuration_files;
 
 INSTANTIATE_TEST_CASE_P(StreamTests, StreamContext,
@@ -1,25 +1,14 @@
+#include "chatbot.h"
+#include "load_generator.h"
 #include "ed247.h"
 #include "time_tools.h"
 #include "a429_tools.h"
-#include <iostream>
-#include <string>
-#include <string.h>
 #include <vector>
 #include <unordered_map>
 #include <memory>
-#include <libxml/tree.h>
 #include <libxml/parser.h>
 #include <libxml/xpath.h>
 
-
-#define LOG_SHORTFILE       (strrchr("/" __FILE__, '/') + 1)
-#define LOG_STREAM_FILELINE LOG_SHORTFILE << ":" << __LINE__ << " "
-
-#define SAY(m) std::cout << m << std::endl;
-#define ERR(m) std::cerr << LOG_STREAM_FILELINE << m << std::endl;
-#define DIE(m) do { ERR(m); exit(1); } while (0)
-#define ASSERT(t) do { if (!(t)) DIE(#t " FAILED"); } while (0)
-
 // Options
 namespace {
   std::string ecic_path;
@@ -27,6 +16,7 @@ namespace {
   bool fill_depth = false;
   uint64_t period_ms = 50;
   uint64_t duration_ms = 0;
+  std::string load_profile_path;
 }
 
 
@@ -146,9 +136,7 @@ struct a429_transceiver_t : public transceiver_t {
 };
 
 
-// Return an xml node attribute, as string
-// if optional = true and attribute not found, return std::string(). else DIE()
-std::string xml_node_attribute(const xmlNodePtr node, const std::string& name, bool optional = false)
+std::string xml_node_attribute(const xmlNodePtr node, const std::string& name, bool optional)
 {
   xmlChar* value = xmlGetProp(node, (const xmlChar*) name.c_str());
   if (! value) {
@@ -175,6 +163,7 @@ uint64_t parse_int_parameter(std::string arg, std::string value) {
 
 void usage() {
   SAY("USAGE: chatbot [-p <period_ms>] [-d <duration_ms>] [--fill_depth] <ECIC> [<CMD>]");
+  SAY("       chatbot --load <PROFILE> [-d <duration_ms>] <ECIC>");
   SAY("");
   SAY("  Send data on output streams of provided ECIC file.");
   SAY("  To pollute an AC, you have to provide an 'invertred' ECICI");
@@ -194,6 +183,20 @@ void usage() {
   SAY("                   The A429 payload will be a BNR one with a counter as value.");
   SAY("                   The Direction in the CMD is ignored, so you can provide an CMD of a target bridge.");
   SAY("                   A429 queuing will never be pushed.");
+  SAY("  --load <PROFILE> Load generator mode: send the streams according to the PROFILE file:");
+  SAY("                   <LoadProfile Threads=\"1\" ReportPeriod=\"1000\">");
+  SAY("                     <Stream Match=\".*\" Rate=\"100\" Burst=\"1\" BurstOn=\"0\" BurstOff=\"0\"");
+  SAY("                             Payload=\"counter\" Size=\"max\" Count=\"0\" Thread=\"auto\"/>");
+  SAY("                   </LoadProfile>");
+  SAY("                   Match:    regex of the output streams (the first matching <Stream> applies)");
+  SAY("                   Rate:     samples per second, 0 for as fast as possible");
+  SAY("                   Burst:    samples pushed back to back, 'depth' for the sample max number");
+  SAY("                   BurstOn/BurstOff: on/off pattern in ms (BurstOff=0: always on)");
+  SAY("                   Payload:  'counter', 'random', 'zero', 'hex:<bytes>' or 'file:<path>' (one hex payload per line)");
+  SAY("                   Size:     sample size in bytes, 'max' or 'random'");
+  SAY("                   Count:    number of samples to send, 0 for unlimited");
+  SAY("                   Thread:   sender thread index or 'auto'. A channel is sent by a single thread.");
+  SAY("                   The TX rates and errors are reported every ReportPeriod ms.");
   exit(1);
 }
 
@@ -218,6 +221,10 @@ int main(int argc, char** argv)
       if (arg == "match") DIE("period = 'match' not yet implemented !");
       period_ms = parse_int_parameter(arg, value);
     }
+    else if (arg == "--load") {
+      if (++arg_id >= argc) DIE("--load option require an argument !");
+      load_profile_path = argv[arg_id];
+    }
     else if (arg == "-d") {
       if (++arg_id >= argc) DIE("-d option require an argument !");
       std::string value = argv[arg_id];
@@ -238,6 +245,29 @@ int main(int argc, char** argv)
     }
   }
 
+  if (ecic_path.empty()) usage();
+
+  //
+  // Load generator mode
+  //
+  if (load_profile_path.empty() == false) {
+    if (cmd_path.empty() == false) DIE("CMD files are not supported by the load generator mode");
+    load::profile_t profile = load::parse_profile(load_profile_path);
+    if (profile.thread_count > 1) {
+      // The io_uring engine has a single producer queue
+#ifdef _WIN32
+      _putenv_s("ED247_IO_URING", "0");
+#else
+      setenv("ED247_IO_URING", "0", 1);
+#endif
+    }
+    ed247_context_t context = nullptr;
+    ASSERT(ed247_load_file(ecic_path.c_str(), &context) == ED247_STATUS_SUCCESS);
+    int result = load::run(context, profile, duration_ms);
+    ed247_unload(context);
+    return result;
+  }
+
   //
   // Load CMD if provided
   //
@@ -330,7 +360,7 @@ int main(int argc, char** argv)
     }
     ed247_send_pushed_samples(context);
     uint64_t cycle_end_time = time_tools::get_monotonic_time_us();
-    if (duration_ms && duration_ms * 1000 > cycle_end_time - send_start_time) break;
+    if (duration_ms && duration_ms * 1000 <= cycle_end_time - send_start_time) break;
     time_tools::sleep_us(period_ms * 1000 + cycle_start_time - cycle_end_time);
   } while (true);
 
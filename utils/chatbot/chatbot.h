@@ -0,0 +1,21 @@
+#ifndef __CHATBOT_H__
+#define __CHATBOT_H__
+#include <iostream>
+#include <string>
+#include <string.h>
+#include <libxml/tree.h>
+
+
+#define LOG_SHORTFILE       (strrchr("/" __FILE__, '/') + 1)
+#define LOG_STREAM_FILELINE LOG_SHORTFILE << ":" << __LINE__ << " "
+
+#define SAY(m) std::cout << m << std::endl;
+#define ERR(m) std::cerr << LOG_STREAM_FILELINE << m << std::endl;
+#define DIE(m) do { ERR(m); exit(1); } while (0)
+#define ASSERT(t) do { if (!(t)) DIE(#t " FAILED"); } while (0)
+
+// Return an xml node attribute, as string
+// if optional = true and attribute not found, return std::string(). else DIE()
+std::string xml_node_attribute(const xmlNodePtr node, const std::string& name, bool optional = false);
+
+#endif
@@ -0,0 +1,456 @@
+#include "load_generator.h"
+#include "chatbot.h"
+#include "time_tools.h"
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <libxml/parser.h>
+
+namespace {
+
+  // A stream more than MAX_LAG_US late on its schedule skips the missed bursts
+  const uint64_t MAX_LAG_US = 1000000;
+
+  // Longest sleep of a sender thread, so it notices the end of the run
+  const uint64_t MAX_SLEEP_US = 100000;
+
+  volatile sig_atomic_t stop_requested = 0;
+  void request_stop(int) { stop_requested = 1; }
+
+  //
+  // Profile parsing
+  //
+  uint64_t parse_uint(const std::string& name, const std::string& value)
+  {
+    char* last;
+    uint64_t result = strtoull(value.c_str(), &last, 10);
+    if (value.empty() || *last) DIE("Invalid " << name << " value: '" << value << "'");
+    return result;
+  }
+
+  double parse_double(const std::string& name, const std::string& value)
+  {
+    char* last;
+    double result = strtod(value.c_str(), &last);
+    if (value.empty() || *last || result < 0) DIE("Invalid " << name << " value: '" << value << "'");
+    return result;
+  }
+
+  // Hexadecimal bytes, optionally separated by spaces
+  std::vector<char> parse_hex(const std::string& hex)
+  {
+    std::vector<char> result;
+    std::string digits;
+    for (char c : hex) {
+      if (c == ' ' || c == '\t' || c == '\r') continue;
+      if (isxdigit((unsigned char)c) == false) DIE("Invalid hexadecimal payload: '" << hex << "'");
+      digits += c;
+    }
+    if (digits.size() % 2 != 0) DIE("Invalid hexadecimal payload (odd digit count): '" << hex << "'");
+    for (size_t pos = 0; pos < digits.size(); pos += 2) {
+      result.push_back((char)strtoul(digits.substr(pos, 2).c_str(), nullptr, 16));
+    }
+    return result;
+  }
+
+  void parse_payload(const std::string& value, load::stream_profile_t& stream)
+  {
+    if (value == "counter") {
+      stream.payload = load::payload_kind_t::Counter;
+    } else if (value == "random") {
+      stream.payload = load::payload_kind_t::Random;
+    } else if (value == "zero") {
+      stream.payload = load::payload_kind_t::Zero;
+    } else if (value.compare(0, 4, "hex:") == 0) {
+      stream.payload = load::payload_kind_t::Script;
+      stream.script.push_back(parse_hex(value.substr(4)));
+    } else if (value.compare(0, 5, "file:") == 0) {
+      stream.payload = load::payload_kind_t::Script;
+      std::ifstream file(value.substr(5));
+      if (file.is_open() == false) DIE("Cannot read payload file '" << value.substr(5) << "'");
+      std::string line;
+      while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        stream.script.push_back(parse_hex(line));
+      }
+      if (stream.script.empty()) DIE("No payload in file '" << value.substr(5) << "'");
+    } else {
+      DIE("Invalid Payload value: '" << value << "'");
+    }
+  }
+
+  //
+  // Sender threads
+  //
+  struct stream_state_t {
+    ed247_stream_t                stream;
+    const load::stream_profile_t* profile;
+    uint32_t                      channel_index;    // In thread_state_t::channels
+    uint32_t                      max_size;
+    uint32_t                      burst;
+    uint32_t                      id;
+    uint64_t                      interval_us;      // Between two bursts
+    uint64_t                      next_due_us;
+    uint64_t                      sent;
+    uint32_t                      script_index;
+    uint8_t                       counter;
+    std::vector<char>             payload;
+  };
+
+  struct thread_state_t {
+    std::vector<stream_state_t>  streams;
+    std::vector<ed247_channel_t> channels;
+    std::vector<bool>            pending;           // Channel has pushed samples to send
+    std::mt19937                 random;
+    std::thread                  thread;
+
+    std::atomic<uint64_t>        samples{0};
+    std::atomic<uint64_t>        bytes{0};
+    std::atomic<uint64_t>        push_errors{0};
+    std::atomic<uint64_t>        missed_bursts{0};
+    std::atomic<bool>            done{false};
+  };
+
+  uint32_t next_generated_id = 100000;
+
+  void fill_payload(thread_state_t& state, stream_state_t& stream, uint32_t& size)
+  {
+    const load::stream_profile_t& profile = *stream.profile;
+
+    if (profile.payload == load::payload_kind_t::Script) {
+      const std::vector<char>& script = profile.script[stream.script_index++ % profile.script.size()];
+      size = std::min<uint32_t>(script.size(), stream.max_size);
+      memcpy(stream.payload.data(), script.data(), size);
+      return;
+    }
+
+    if (profile.random_size) {
+      size = std::uniform_int_distribution<uint32_t>(1, stream.max_size)(state.random);
+    } else {
+      size = (profile.size != 0) ? std::min(profile.size, stream.max_size) : stream.max_size;
+    }
+
+    char* data = stream.payload.data();
+    switch (profile.payload) {
+    case load::payload_kind_t::Counter: {
+      // Same payload as the default mode: the id, then a counter in all the bytes
+      uint32_t offset = 0;
+      if (size > 4) {
+        memcpy(data, &stream.id, 4);
+        offset = 4;
+      }
+      memset(data + offset, ++stream.counter, size - offset);
+      break;
+    }
+    case load::payload_kind_t::Random:
+      for (uint32_t pos = 0; pos < size; pos += 4) {
+        uint32_t value = state.random();
+        memcpy(data + pos, &value, std::min<uint32_t>(4, size - pos));
+      }
+      break;
+    default:
+      break;
+    }
+  }
+
+  void send_channel(thread_state_t& state, uint32_t channel_index)
+  {
+    ed247_channel_send_pushed_samples(state.channels[channel_index]);
+    state.pending[channel_index] = false;
+  }
+
+  void push_burst(thread_state_t& state, stream_state_t& stream)
+  {
+    for (uint32_t index = 0; index < stream.burst; index++) {
+      if (stream.profile->count != 0 && stream.sent >= stream.profile->count) break;
+
+      uint32_t size;
+      bool full = false;
+      fill_payload(state, stream, size);
+      if (ed247_stream_push_sample(stream.stream, stream.payload.data(), size, nullptr, &full) != ED247_STATUS_SUCCESS) {
+        state.push_errors.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+      stream.sent++;
+      state.samples.fetch_add(1, std::memory_order_relaxed);
+      state.bytes.fetch_add(size, std::memory_order_relaxed);
+
+      // Send before the send stack overflows
+      if (full) {
+        send_channel(state, stream.channel_index);
+      } else {
+        state.pending[stream.channel_index] = true;
+      }
+    }
+  }
+
+  // Return true if the On/Off pattern of the stream is On at time now_us.
+  // If not, set next_due_us to the beginning of the next On period.
+  bool is_on(stream_state_t& stream, uint64_t start_us, uint64_t now_us)
+  {
+    const load::stream_profile_t& profile = *stream.profile;
+    if (profile.burst_off_ms == 0) return true;
+
+    uint64_t period_us = (uint64_t)(profile.burst_on_ms + profile.burst_off_ms) * 1000;
+    uint64_t phase_us = (now_us - start_us) % period_us;
+    if (phase_us < (uint64_t)profile.burst_on_ms * 1000) return true;
+    stream.next_due_us = now_us - phase_us + period_us;
+    return false;
+  }
+
+  void sender_thread(thread_state_t& state, uint64_t start_us, uint64_t end_us)
+  {
+    while (stop_requested == 0) {
+      uint64_t now_us = time_tools::get_monotonic_time_us();
+      if (end_us != 0 && now_us >= end_us) break;
+
+      uint64_t next_wake_us = std::numeric_limits<uint64_t>::max();
+      bool running = false;
+      for (stream_state_t& stream : state.streams) {
+        if (stream.profile->count != 0 && stream.sent >= stream.profile->count) continue;
+        running = true;
+
+        if (stream.next_due_us <= now_us) {
+          if (stream.interval_us != 0 && now_us - stream.next_due_us > MAX_LAG_US) {
+            uint64_t missed = (now_us - stream.next_due_us) / stream.interval_us;
+            state.missed_bursts.fetch_add(missed, std::memory_order_relaxed);
+            stream.next_due_us += missed * stream.interval_us;
+          }
+          if (is_on(stream, start_us, now_us)) {
+            push_burst(state, stream);
+            stream.next_due_us = (stream.interval_us != 0) ? stream.next_due_us + stream.interval_us : now_us;
+          }
+        }
+        next_wake_us = std::min(next_wake_us, stream.next_due_us);
+      }
+
+      for (uint32_t channel_index = 0; channel_index < state.channels.size(); channel_index++) {
+        if (state.pending[channel_index]) send_channel(state, channel_index);
+      }
+      if (running == false) break;
+
+      now_us = time_tools::get_monotonic_time_us();
+      if (next_wake_us > now_us) {
+        time_tools::sleep_us((uint32_t)std::min(next_wake_us - now_us, MAX_SLEEP_US));
+      }
+    }
+    state.done = true;
+  }
+
+  struct totals_t {
+    uint64_t samples{0};
+    uint64_t bytes{0};
+    uint64_t push_errors{0};
+    uint64_t send_errors{0};
+    uint64_t missed_bursts{0};
+  };
+
+  totals_t get_totals(const std::vector<std::unique_ptr<thread_state_t>>& threads)
+  {
+    totals_t totals;
+    for (auto& state : threads) {
+      totals.samples += state->samples.load(std::memory_order_relaxed);
+      totals.bytes += state->bytes.load(std::memory_order_relaxed);
+      totals.push_errors += state->push_errors.load(std::memory_order_relaxed);
+      totals.missed_bursts += state->missed_bursts.load(std::memory_order_relaxed);
+      for (ed247_channel_t channel : state->channels) {
+        uint64_t send_errors = 0;
+        ed247_channel_get_send_error_count(channel, &send_errors);
+        totals.send_errors += send_errors;
+      }
+    }
+    return totals;
+  }
+
+  void report(const char* title, double duration_s, uint64_t samples, uint64_t bytes, const totals_t& totals)
+  {
+    if (duration_s <= 0) return;
+    SAY(title << ": " <<
+        (uint64_t)(samples / duration_s) << " samples/s, " <<
+        (uint64_t)(bytes / duration_s / 1000) << " kB/s (payloads), " <<
+        "push errors: " << totals.push_errors << ", " <<
+        "send errors: " << totals.send_errors << ", " <<
+        "missed bursts: " << totals.missed_bursts);
+  }
+}
+
+
+load::profile_t load::parse_profile(const std::string& path)
+{
+  profile_t profile;
+
+  xmlDocPtr doc = xmlParseFile(path.c_str());
+  if (!doc) DIE("Cannot read load profile '" << path << "'");
+  xmlNodePtr root = xmlDocGetRootElement(doc);
+  if (!root || std::string((const char*)root->name) != "LoadProfile") DIE("'" << path << "' is not a load profile");
+
+  std::string value;
+  if (!(value = xml_node_attribute(root, "Threads", true)).empty()) profile.thread_count = parse_uint("Threads", value);
+  if (!(value = xml_node_attribute(root, "ReportPeriod", true)).empty()) profile.report_period_ms = parse_uint("ReportPeriod", value);
+  if (profile.thread_count == 0) DIE("Threads shall be at least 1");
+
+  for (xmlNodePtr node = root->children; node != nullptr; node = node->next) {
+    if (node->type != XML_ELEMENT_NODE) continue;
+    if (std::string((const char*)node->name) != "Stream") DIE("Unexpected element '" << node->name << "' in load profile");
+
+    stream_profile_t stream;
+    if (!(value = xml_node_attribute(node, "Match", true)).empty()) stream.match = value;
+    if (!(value = xml_node_attribute(node, "Rate", true)).empty()) stream.rate = parse_double("Rate", value);
+    if (!(value = xml_node_attribute(node, "Burst", true)).empty()) {
+      stream.burst = (value == "depth") ? 0 : parse_uint("Burst", value);
+      if (value != "depth" && stream.burst == 0) DIE("Burst shall be at least 1");
+    }
+    if (!(value = xml_node_attribute(node, "BurstOn", true)).empty()) stream.burst_on_ms = parse_uint("BurstOn", value);
+    if (!(value = xml_node_attribute(node, "BurstOff", true)).empty()) stream.burst_off_ms = parse_uint("BurstOff", value);
+    if (stream.burst_off_ms != 0 && stream.burst_on_ms == 0) DIE("BurstOn is required with BurstOff");
+    if (!(value = xml_node_attribute(node, "Payload", true)).empty()) parse_payload(value, stream);
+    if (!(value = xml_node_attribute(node, "Size", true)).empty()) {
+      if (value == "random") {
+        stream.random_size = true;
+      } else if (value != "max") {
+        stream.size = parse_uint("Size", value);
+      }
+    }
+    if (!(value = xml_node_attribute(node, "Count", true)).empty()) stream.count = parse_uint("Count", value);
+    if (!(value = xml_node_attribute(node, "Thread", true)).empty() && value != "auto") {
+      stream.thread = parse_uint("Thread", value);
+      if ((uint32_t)stream.thread >= profile.thread_count) DIE("Thread " << stream.thread << " is out of range");
+    }
+    profile.streams.push_back(stream);
+  }
+
+  xmlFreeDoc(doc);
+  if (profile.streams.empty()) DIE("No <Stream> in load profile '" << path << "'");
+  return profile;
+}
+
+
+int load::run(ed247_context_t context, const profile_t& profile, uint64_t duration_ms)
+{
+  std::vector<std::unique_ptr<thread_state_t>> threads;
+  for (uint32_t index = 0; index < profile.thread_count; index++) {
+    threads.emplace_back(new thread_state_t());
+    threads.back()->random.seed(index + 1);
+  }
+
+  //
+  // Select the streams and share their channels among the threads
+  //
+  struct selected_stream_t {
+    ed247_stream_t          stream;
+    const stream_profile_t* profile;
+    ed247_channel_t         channel;
+  };
+  std::vector<selected_stream_t> selected;
+  std::unordered_map<ed247_stream_t, bool> already_selected;
+  for (const stream_profile_t& stream_profile : profile.streams) {
+    ed247_stream_list_t streams = nullptr;
+    ed247_stream_t stream = nullptr;
+    if (ed247_find_streams(context, stream_profile.match.c_str(), &streams) != ED247_STATUS_SUCCESS) {
+      SAY("No stream matches '" << stream_profile.match << "'");
+      continue;
+    }
+    while (ed247_stream_list_next(streams, &stream) == ED247_STATUS_SUCCESS && stream != nullptr) {
+      if ((ed247_stream_get_direction(stream) & ED247_DIRECTION_OUT) == 0) continue;
+      if (already_selected.emplace(stream, true).second == false) continue;
+      ed247_channel_t channel = nullptr;
+      ASSERT(ed247_stream_get_channel(stream, &channel) == ED247_STATUS_SUCCESS);
+      selected.push_back(selected_stream_t{ stream, &stream_profile, channel });
+    }
+    ed247_stream_list_free(streams);
+  }
+  if (selected.empty()) DIE("No output stream selected by the load profile");
+
+  // Explicit threads first, then round robin
+  std::unordered_map<ed247_channel_t, uint32_t> channel_threads;
+  for (const selected_stream_t& stream : selected) {
+    if (stream.profile->thread < 0) continue;
+    auto result = channel_threads.emplace(stream.channel, stream.profile->thread);
+    if (result.first->second != (uint32_t)stream.profile->thread) {
+      DIE("Channel " << ed247_channel_get_name(stream.channel) << " is assigned to several threads");
+    }
+  }
+  uint32_t next_thread = 0;
+  for (const selected_stream_t& stream : selected) {
+    if (channel_threads.emplace(stream.channel, next_thread).second) {
+      next_thread = (next_thread + 1) % profile.thread_count;
+    }
+  }
+
+  uint64_t start_us = time_tools::get_monotonic_time_us();
+  for (const selected_stream_t& selected_stream : selected) {
+    thread_state_t& state = *threads[channel_threads[selected_stream.channel]];
+
+    auto channel = std::find(state.channels.begin(), state.channels.end(), selected_stream.channel);
+    if (channel == state.channels.end()) {
+      state.channels.push_back(selected_stream.channel);
+      state.pending.push_back(false);
+      channel = state.channels.end() - 1;
+    }
+
+    stream_state_t stream;
+    stream.stream = selected_stream.stream;
+    stream.profile = selected_stream.profile;
+    stream.channel_index = channel - state.channels.begin();
+    stream.max_size = ed247_stream_get_sample_max_size_bytes(stream.stream);
+    stream.burst = stream.profile->burst != 0 ? stream.profile->burst : ed247_stream_get_sample_max_number(stream.stream);
+    stream.id = ed247_stream_get_uid(stream.stream);
+    if (stream.id == 0) stream.id = next_generated_id++;
+    stream.interval_us = (stream.profile->rate > 0) ? (uint64_t)(stream.burst * 1000000 / stream.profile->rate) : 0;
+    stream.next_due_us = start_us;
+    stream.sent = 0;
+    stream.script_index = 0;
+    stream.counter = 0;
+    stream.payload.resize(stream.max_size, 0);
+    state.streams.push_back(stream);
+  }
+
+  for (uint32_t index = 0; index < threads.size(); index++) {
+    SAY("Thread " << index << ": " << threads[index]->streams.size() << " streams in " <<
+        threads[index]->channels.size() << " channels");
+  }
+
+  //
+  // Run and report
+  //
+  signal(SIGINT, &request_stop);
+  signal(SIGTERM, &request_stop);
+  uint64_t end_us = duration_ms ? start_us + duration_ms * 1000 : 0;
+  for (auto& state : threads) {
+    thread_state_t* state_ptr = state.get();
+    state->thread = std::thread([state_ptr, start_us, end_us]() { sender_thread(*state_ptr, start_us, end_us); });
+  }
+
+  totals_t last_totals;
+  uint64_t last_report_us = start_us;
+  while (true) {
+    uint64_t next_report_us = last_report_us + (uint64_t)profile.report_period_ms * 1000;
+    bool all_done = false;
+    while (time_tools::get_monotonic_time_us() < next_report_us) {
+      all_done = std::all_of(threads.begin(), threads.end(), [](const std::unique_ptr<thread_state_t>& state) { return state->done.load(); });
+      if (all_done) break;
+      time_tools::sleep_us(10000);
+    }
+    if (all_done) break;
+
+    uint64_t now_us = time_tools::get_monotonic_time_us();
+    totals_t totals = get_totals(threads);
+    report("TX", (now_us - last_report_us) / 1e6, totals.samples - last_totals.samples, totals.bytes - last_totals.bytes, totals);
+    last_totals = totals;
+    last_report_us = now_us;
+  }
+
+  for (auto& state : threads) state->thread.join();
+
+  uint64_t duration_us = time_tools::get_monotonic_time_us() - start_us;
+  totals_t totals = get_totals(threads);
+  SAY("Sent " << totals.samples << " samples (" << totals.bytes << " payload bytes) in " << duration_us / 1000 << " ms");
+  report("Mean", duration_us / 1e6, totals.samples, totals.bytes, totals);
+  return (totals.push_errors != 0 || totals.send_errors != 0) ? 1 : 0;
+}
@@ -0,0 +1,64 @@
+#ifndef __LOAD_GENERATOR_H__
+#define __LOAD_GENERATOR_H__
+#include "ed247.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+//
+// Load generator mode of the chatbot
+//
+// A load profile (XML) tells which output streams are sent, how fast and with
+// which payloads. The streams are shared among sender threads by channel: a
+// channel is always pushed and sent by the same thread (see
+// ed247_channel_send_pushed_samples()).
+//
+// <LoadProfile Threads="2" ReportPeriod="1000">
+//   <Stream Match="Stream.*" Rate="10000" Burst="8" BurstOn="100" BurstOff="900"
+//           Payload="random" Size="max" Count="0" Thread="auto"/>
+// </LoadProfile>
+//
+// A stream is driven by the first <Stream> whose Match regex matches its name.
+// Streams that match no <Stream> are not sent.
+//
+namespace load {
+
+  enum class payload_kind_t {
+    Counter,   // [UID(4bytes)][counter(1byte)][counter(1byte)]... (same as the default chatbot mode)
+    Random,
+    Zero,
+    Script     // Payloads of the Payload="hex:..." attribute or of the Payload="file:..." file, cycled
+  };
+
+  struct stream_profile_t {
+    std::string                    match{".*"};
+    double                         rate{100};            // Samples per second. 0: as fast as possible.
+    uint32_t                       burst{1};             // Samples pushed back to back. 0: sample max number of the stream.
+    uint32_t                       burst_on_ms{0};       // On/Off pattern. burst_off_ms = 0: always on.
+    uint32_t                       burst_off_ms{0};
+    payload_kind_t                 payload{payload_kind_t::Counter};
+    std::vector<std::vector<char>> script;               // Payload::Script payloads
+    uint32_t                       size{0};              // Sample size. 0: sample max size of the stream.
+    bool                           random_size{false};   // Random size between 1 and the sample max size
+    uint64_t                       count{0};             // Number of samples to send. 0: unlimited.
+    int32_t                        thread{-1};           // Sender thread. -1: channels are shared round robin.
+  };
+
+  struct profile_t {
+    uint32_t                      thread_count{1};
+    uint32_t                      report_period_ms{1000};
+    std::vector<stream_profile_t> streams;
+  };
+
+  // Parse a load profile file. DIE() if invalid.
+  profile_t parse_profile(const std::string& path);
+
+  // Send the output streams of context according to profile, during duration_ms (0: until
+  // interrupted or all the stream counts are reached). Report the TX rates every report period.
+  // Return the process exit code.
+  int run(ed247_context_t context, const profile_t& profile, uint64_t duration_ms);
+
+}
+
+#endif
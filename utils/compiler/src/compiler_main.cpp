@@ -0,0 +1,64 @@
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+
+#include <stdio.h>
+#include <string>
+
+#include <ed247.h>
+#include <ed247_logs.h>
+
+// Precompile an ECIC for ed247_load_compiled()
+int main(int argc, char *argv[])
+{
+    ed247_status_t              status = ED247_STATUS_SUCCESS;
+    ed247_context_t             context = nullptr;
+
+    // Retrieve arguments
+    if(argc != 3){
+        PRINT_ERROR("compiler <ecic_filepath> <compiled_filepath>");
+        return EXIT_FAILURE;
+    }
+
+    std::string filepath = std::string(argv[1]);
+    std::string compiled_filepath = std::string(argv[2]);
+    PRINT_INFO("ECIC filepath: " << filepath);
+    PRINT_INFO("Compiled ECIC filepath: " << compiled_filepath);
+
+    status = ed247_compile_file(filepath.c_str(), compiled_filepath.c_str());
+    if(status != ED247_STATUS_SUCCESS){
+        PRINT_ERROR("ED247 status: " << ed247_status_string(status));
+        return EXIT_FAILURE;
+    }
+
+    // Check the result can be loaded
+    status = ed247_load_compiled(compiled_filepath.c_str(), &context);
+    if(status != ED247_STATUS_SUCCESS){
+        PRINT_ERROR("Cannot reload compiled ECIC. ED247 status: " << ed247_status_string(status));
+        return EXIT_FAILURE;
+    }
+    ed247_unload(context);
+
+    return EXIT_SUCCESS;
+}
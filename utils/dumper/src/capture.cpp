@@ -0,0 +1,294 @@
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include "capture.h"
+#include "ed247_logs.h"
+#include <cstring>
+
+namespace {
+  const char MAGIC[8] = { 'E', 'D', '2', '4', '7', 'C', 'A', 'P' };
+}
+
+//
+// Writer
+//
+capture::Writer::Writer() :
+  _file(nullptr),
+  _stop(false),
+  _write_error(false),
+  _record_count(0),
+  _max_backlog(0)
+{
+}
+
+capture::Writer::~Writer()
+{
+  close();
+}
+
+bool capture::Writer::open(const std::string& filepath, const header_t& header)
+{
+  _file = fopen(filepath.c_str(), "wb");
+  if (_file == nullptr) {
+    PRINT_ERROR("Cannot open file '" << filepath << "'");
+    return false;
+  }
+
+  _block.reserve(BLOCK_SIZE);
+  append(MAGIC, sizeof(MAGIC));
+  append(VERSION);
+  append((uint32_t)header.channels.size());
+  for (const std::string& channel : header.channels) {
+    append(channel);
+  }
+  append((uint32_t)header.streams.size());
+  for (const stream_info_t& stream : header.streams) {
+    append(stream.name);
+    append(stream.type);
+    append((uint32_t)stream.signals.size());
+    for (const signal_info_t& signal : stream.signals) {
+      append(signal.name);
+      append(signal.type);
+      append(signal.byte_offset);
+      append(signal.size);
+      append(signal.element_size);
+    }
+  }
+
+  _stop = false;
+  _thread = std::thread(&Writer::run, this);
+  return true;
+}
+
+void capture::Writer::close()
+{
+  if (_file == nullptr) return;
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_block.empty() == false) _full_blocks.push_back(std::move(_block));
+    _stop = true;
+  }
+  _wake_up.notify_one();
+  _thread.join();
+
+  fclose(_file);
+  _file = nullptr;
+  if (_write_error) {
+    PRINT_ERROR("Failed to write the capture file: records have been lost");
+  }
+}
+
+void capture::Writer::write_frame(uint32_t channel_index, const ed247_timestamp_t& recv_timestamp,
+                                  const void* payload, uint32_t size)
+{
+  append((uint8_t)RECORD_FRAME);
+  append(channel_index);
+  append(recv_timestamp);
+  append(size);
+  append(payload, size);
+  end_record();
+}
+
+void capture::Writer::write_sample(uint32_t stream_index, const ed247_sample_details_t& details,
+                                   const ed247_timestamp_t& data_timestamp, const ed247_timestamp_t& recv_timestamp,
+                                   const void* payload, uint32_t size)
+{
+  append((uint8_t)RECORD_SAMPLE);
+  append(stream_index);
+  append(details.component_identifier);
+  append(details.sequence_number);
+  append(details.transport_timestamp);
+  append(data_timestamp);
+  append(recv_timestamp);
+  append(size);
+  append(payload, size);
+  end_record();
+}
+
+void capture::Writer::append(const void* data, size_t size)
+{
+  _block.insert(_block.end(), (const char*)data, (const char*)data + size);
+}
+
+void capture::Writer::append(const ed247_timestamp_t& timestamp)
+{
+  append(timestamp.epoch_s);
+  append(timestamp.offset_ns);
+}
+
+void capture::Writer::append(const std::string& value)
+{
+  append((uint16_t)value.size());
+  append(value.data(), value.size());
+}
+
+void capture::Writer::end_record()
+{
+  _record_count++;
+  if (_block.size() < BLOCK_SIZE) return;
+
+  // Hand the block to the writer thread and take a free one
+  std::vector<char> next_block;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _full_blocks.push_back(std::move(_block));
+    if (_full_blocks.size() > _max_backlog) _max_backlog = _full_blocks.size();
+    if (_free_blocks.empty() == false) {
+      next_block = std::move(_free_blocks.back());
+      _free_blocks.pop_back();
+    }
+  }
+  _wake_up.notify_one();
+
+  _block = std::move(next_block);
+  _block.clear();
+  _block.reserve(BLOCK_SIZE);
+}
+
+void capture::Writer::run()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true) {
+    _wake_up.wait(lock, [this]() { return _stop || _full_blocks.empty() == false; });
+    if (_full_blocks.empty()) return;
+
+    std::vector<char> block = std::move(_full_blocks.front());
+    _full_blocks.pop_front();
+    lock.unlock();
+
+    if (fwrite(block.data(), 1, block.size(), _file) != block.size()) _write_error = true;
+    block.clear();
+
+    lock.lock();
+    _free_blocks.push_back(std::move(block));
+  }
+}
+
+//
+// Reader
+//
+capture::Reader::Reader() :
+  _file(nullptr),
+  _truncated(false)
+{
+}
+
+capture::Reader::~Reader()
+{
+  if (_file) fclose(_file);
+}
+
+bool capture::Reader::open(const std::string& filepath)
+{
+  _file = fopen(filepath.c_str(), "rb");
+  if (_file == nullptr) {
+    PRINT_ERROR("Cannot open file '" << filepath << "'");
+    return false;
+  }
+
+  char magic[sizeof(MAGIC)];
+  uint32_t version;
+  if (read(magic, sizeof(magic)) == false || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+    PRINT_ERROR("'" << filepath << "' is not an ED247 capture file");
+    return false;
+  }
+  if (read(version) == false || version != VERSION) {
+    PRINT_ERROR("'" << filepath << "': unsupported capture version (or byte order)");
+    return false;
+  }
+
+  uint32_t channel_count, stream_count;
+  if (read(channel_count) == false) return false;
+  _header.channels.resize(channel_count);
+  for (std::string& channel : _header.channels) {
+    if (read(channel) == false) return false;
+  }
+
+  if (read(stream_count) == false) return false;
+  _header.streams.resize(stream_count);
+  for (stream_info_t& stream : _header.streams) {
+    uint32_t signal_count;
+    if (read(stream.name) == false || read(stream.type) == false || read(signal_count) == false) return false;
+    stream.signals.resize(signal_count);
+    for (signal_info_t& signal : stream.signals) {
+      if (read(signal.name) == false || read(signal.type) == false || read(signal.byte_offset) == false ||
+          read(signal.size) == false || read(signal.element_size) == false) return false;
+    }
+  }
+  return true;
+}
+
+bool capture::Reader::next(record_t& record)
+{
+  if (fread(&record.type, 1, 1, _file) != 1) return false;   // End of file
+
+  uint32_t size;
+  bool result = read(record.index);
+  if (record.type == RECORD_FRAME) {
+    result = result && read(record.recv_timestamp);
+    memset(&record.details, 0, sizeof(record.details));
+    record.data_timestamp = ed247_timestamp_t{0, 0};
+  } else if (record.type == RECORD_SAMPLE) {
+    result = result &&
+      read(record.details.component_identifier) &&
+      read(record.details.sequence_number) &&
+      read(record.details.transport_timestamp) &&
+      read(record.data_timestamp) &&
+      read(record.recv_timestamp);
+  } else {
+    PRINT_ERROR("Invalid record type " << (int)record.type);
+    _truncated = true;
+    return false;
+  }
+  result = result && read(size);
+  if (result) {
+    record.payload.resize(size);
+    result = read(record.payload.data(), size);
+  }
+
+  if (result && record.index >= (record.type == RECORD_FRAME ? _header.channels.size() : _header.streams.size())) {
+    PRINT_ERROR("Invalid record index " << record.index);
+    result = false;
+  }
+  if (result == false) _truncated = true;
+  return result;
+}
+
+bool capture::Reader::read(void* data, size_t size)
+{
+  return size == 0 || fread(data, 1, size, _file) == size;
+}
+
+bool capture::Reader::read(std::string& value)
+{
+  uint16_t size;
+  if (read(size) == false) return false;
+  value.resize(size);
+  return read(&value[0], size);
+}
+
+bool capture::Reader::read(ed247_timestamp_t& timestamp)
+{
+  return read(timestamp.epoch_s) && read(timestamp.offset_ns);
+}
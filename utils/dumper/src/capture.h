@@ -0,0 +1,182 @@
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+//
+// Binary capture format of the dumper
+//
+// A capture file is an header followed by records, appended while capturing.
+// Integers are stored in host byte order (the magic allows to detect a foreign capture).
+// Payloads are stored as received (network byte order).
+//
+// Header:
+//   char[8]  magic "ED247CAP"
+//   uint32   version
+//   uint32   channel count, then for each channel:
+//            string name
+//   uint32   stream count, then for each stream:
+//            string name, uint8 stream type, uint32 signal count, then for each signal:
+//            string name, uint8 signal type, uint32 byte offset, uint32 max size, uint32 element size
+//
+// Records:
+//   uint8    record type
+//   FRAME:   uint32 channel index, timestamp receive, uint32 size, payload
+//   SAMPLE:  uint32 stream index, uint16 component identifier, uint16 sequence number,
+//            timestamp transport, timestamp data, timestamp receive, uint32 size, payload
+//
+// string: uint16 length + characters
+// timestamp: uint32 epoch_s + uint32 offset_ns
+//
+#ifndef _DUMPER_CAPTURE_H_
+#define _DUMPER_CAPTURE_H_
+#include <ed247.h>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace capture {
+
+  static const uint32_t VERSION = 1;
+
+  enum record_type_t : uint8_t {
+    RECORD_FRAME  = 1,
+    RECORD_SAMPLE = 2
+  };
+
+  struct signal_info_t {
+    std::string name;
+    uint8_t     type;
+    uint32_t    byte_offset;
+    uint32_t    size;           // Max size
+    uint32_t    element_size;   // Size of the values to swap
+  };
+
+  struct stream_info_t {
+    std::string                name;
+    uint8_t                    type;
+    std::vector<signal_info_t> signals;
+  };
+
+  struct header_t {
+    std::vector<std::string>   channels;
+    std::vector<stream_info_t> streams;
+  };
+
+  struct record_t {
+    uint8_t                type;
+    uint32_t               index;           // Channel or stream index in the header
+    ed247_sample_details_t details;
+    ed247_timestamp_t      data_timestamp;
+    ed247_timestamp_t      recv_timestamp;
+    std::vector<char>      payload;
+  };
+
+  //
+  // Capture file writer
+  // Records are serialized in memory blocks by the capturing thread. Full blocks are handed
+  // to a dedicated writer thread, so the capture never waits for the disk. Blocks are only
+  // allocated when the writer thread is late.
+  //
+  class Writer
+  {
+  public:
+    Writer();
+    ~Writer();
+
+    // Create the file, write the header and start the writer thread
+    bool open(const std::string& filepath, const header_t& header);
+
+    // Write the pending records and stop the writer thread
+    void close();
+
+    void write_frame(uint32_t channel_index, const ed247_timestamp_t& recv_timestamp,
+                     const void* payload, uint32_t size);
+    void write_sample(uint32_t stream_index, const ed247_sample_details_t& details,
+                      const ed247_timestamp_t& data_timestamp, const ed247_timestamp_t& recv_timestamp,
+                      const void* payload, uint32_t size);
+
+    uint64_t get_record_count() const { return _record_count; }
+
+    // Maximum number of blocks waiting for the writer thread
+    uint32_t get_max_backlog() const  { return _max_backlog;  }
+
+  private:
+    static const size_t BLOCK_SIZE = 1024 * 1024;
+
+    template<typename T> void append(const T& value) { append(&value, sizeof(T)); }
+    void append(const void* data, size_t size);
+    void append(const ed247_timestamp_t& timestamp);
+    void append(const std::string& value);
+    void end_record();
+    void run();
+
+    FILE*                         _file;
+    std::vector<char>             _block;        // Filled by the capturing thread
+    std::deque<std::vector<char>> _full_blocks;
+    std::vector<std::vector<char>> _free_blocks;
+    std::mutex                    _mutex;
+    std::condition_variable       _wake_up;
+    std::thread                   _thread;
+    bool                          _stop;
+    bool                          _write_error;
+    uint64_t                      _record_count;
+    uint32_t                      _max_backlog;
+  };
+
+  //
+  // Capture file reader
+  //
+  class Reader
+  {
+  public:
+    Reader();
+    ~Reader();
+
+    // Open the file and read the header
+    bool open(const std::string& filepath);
+
+    const header_t& get_header() const { return _header; }
+
+    // Read the next record. Return false at the end of the file or on error (see is_truncated()).
+    bool next(record_t& record);
+
+    // True if the file ends in the middle of a record
+    bool is_truncated() const { return _truncated; }
+
+  private:
+    template<typename T> bool read(T& value) { return read(&value, sizeof(T)); }
+    bool read(void* data, size_t size);
+    bool read(std::string& value);
+    bool read(ed247_timestamp_t& timestamp);
+
+    FILE*    _file;
+    header_t _header;
+    bool     _truncated;
+  };
+
+}
+
+#endif
@@ -23,68 +23,37 @@
  *****************************************************************************/
 #include <fstream>
 #include <iomanip>
+#include <unordered_map>
+#include <cstring>
+#ifdef _WIN32
+# include <winsock2.h>
+#else
+# include <arpa/inet.h>
+#endif
 
 #include <ed247.h>
 #include "ed247_logs.h"
 #include "time_tools.h"
+#include "capture.h"
 
 int check_status(ed247_context_t context, ed247_status_t status);
 
 void help() {
   std::cout <<
-    "USAGE: dumper <ecic_file> <output_file> <timeout_ms>" << std::endl <<
-    "       dumper <ecic_file> <timeout_ms>                # Dump on STDOUT" << std::endl;
+    "USAGE: dumper <ecic_file> <output_file> <timeout_ms>              # Dump CSV in a file" << std::endl <<
+    "       dumper <ecic_file> <timeout_ms>                            # Dump CSV on STDOUT" << std::endl <<
+    "       dumper --capture <ecic_file> <capture_file> <timeout_ms>   # Binary capture" << std::endl <<
+    "       dumper --to-csv <capture_file> [<output_file>]             # Convert a binary capture to CSV" << std::endl;
 }
 
 std::ofstream output_stream;
 std::ostream& output() { return output_stream.is_open() ? output_stream : std::cout; }
 
-int main(int argc, char *argv[])
+//
+// CSV format
+//
+void csv_header()
 {
-    ed247_status_t               status = ED247_STATUS_SUCCESS;
-    ed247_context_t              context = nullptr;
-    ed247_stream_list_t          streams = nullptr;
-    ed247_stream_t               stream = nullptr;
-    const void                   *sample = nullptr;
-    uint32_t                     sample_size = 0;
-    const ed247_timestamp_t      *data_timestamp = nullptr;
-    const ed247_timestamp_t      *recv_timestamp = nullptr;
-    const ed247_sample_details_t *sample_details = nullptr;
-
-    std::string ecic_file = std::string();
-    std::string output_file = std::string();
-    int timeout_arg = 0;
-
-    // Retrieve arguments
-    if (argc == 3) {
-      timeout_arg = 2;
-    } else if (argc == 4) {
-      output_stream.open(argv[2]);
-      if (output_stream.is_open()) {
-        SAY("Dump to file " << argv[2]);
-      } else {
-        PRINT_ERROR("Cannot open file '" << argv[2] << "'");
-      }
-      timeout_arg = 3;
-    } else {
-      help();
-      return EXIT_FAILURE;
-    }
-
-    ecic_file = std::string(argv[1]);
-    status = ed247_load_file(ecic_file.c_str(), &context);
-    if(check_status(context, status)) return EXIT_FAILURE;
-    PRINT_INFO("ECIC file : '" << ecic_file << "'");
-
-    char* last;
-    uint32_t timeout_ms = strtol(argv[timeout_arg], &last, 10);
-    if (*last){
-      PRINT_ERROR("Invalid timout argument: '" << argv[timeout_arg] << "'");
-      return EXIT_FAILURE;
-    }
-    PRINT_INFO("Timeout : '" << timeout_ms << "'");
-
-
     output() << "ComponentIdentifier;"
         << "SequenceNumber;"
         << "TransportTimestampEpochS;"
@@ -98,6 +67,61 @@ int main(int argc, char *argv[])
         << "Signal;"
         << "SignalData"
         << std::endl;
+}
+
+void csv_hex(const void* data, uint32_t size)
+{
+    for(uint32_t i = 0 ; i < size ; i++){
+        if(i > 0) output() << " ";
+        output() << std::hex << std::setfill('0') << std::setw(2) << (unsigned int)((unsigned char*)data)[i];
+    }
+    output() << std::dec;
+}
+
+// Stream data or signal data line (the other one is empty)
+void csv_line(const ed247_sample_details_t& sample_details, const std::string& stream_name,
+              const ed247_timestamp_t& data_timestamp, const ed247_timestamp_t& recv_timestamp,
+              const void* stream_data, uint32_t stream_data_size,
+              const std::string& signal_name, const void* signal_data, uint32_t signal_data_size)
+{
+    output() << sample_details.component_identifier << ";"
+        << sample_details.sequence_number << ";"
+        << sample_details.transport_timestamp.epoch_s << ";"
+        << sample_details.transport_timestamp.offset_ns << ";"
+        << stream_name << ";"
+        << data_timestamp.epoch_s << ";"
+        << data_timestamp.offset_ns << ";"
+        << recv_timestamp.epoch_s << ";"
+        << recv_timestamp.offset_ns << ";";
+    csv_hex(stream_data, stream_data_size);
+    output() << ";" << signal_name << ";";
+    csv_hex(signal_data, signal_data_size);
+    output() << std::endl;
+}
+
+bool is_signal_stream(ed247_stream_type_t stream_type)
+{
+    return stream_type == ED247_STREAM_TYPE_ANALOG ||
+        stream_type == ED247_STREAM_TYPE_DISCRETE ||
+        stream_type == ED247_STREAM_TYPE_NAD ||
+        stream_type == ED247_STREAM_TYPE_VNAD;
+}
+
+//
+// Live CSV dump
+//
+int dump_csv(ed247_context_t context, uint32_t timeout_ms)
+{
+    ed247_status_t               status = ED247_STATUS_SUCCESS;
+    ed247_stream_list_t          streams = nullptr;
+    ed247_stream_t               stream = nullptr;
+    const void                   *sample = nullptr;
+    uint32_t                     sample_size = 0;
+    const ed247_timestamp_t      *data_timestamp = nullptr;
+    const ed247_timestamp_t      *recv_timestamp = nullptr;
+    const ed247_sample_details_t *sample_details = nullptr;
+
+    csv_header();
 
     uint64_t start, stop;
     start = time_tools::get_monotonic_time_us();
@@ -111,36 +135,11 @@ int main(int argc, char *argv[])
             while(ed247_stream_list_next(streams, &stream) == ED247_STATUS_SUCCESS && stream != NULL){
                 std::string stream_name = ed247_stream_get_name(stream);
                 ed247_stream_type_t stream_type = ed247_stream_get_type(stream);
-                if(check_status(context, status)) return status;
-                if(stream_type == ED247_STREAM_TYPE_A664 ||
-                    stream_type == ED247_STREAM_TYPE_A429 ||
-                    stream_type == ED247_STREAM_TYPE_A825 ||
-                    stream_type == ED247_STREAM_TYPE_M1553 ||
-                    stream_type == ED247_STREAM_TYPE_SERIAL ||
-                    stream_type == ED247_STREAM_TYPE_AUDIO ||
-                    stream_type == ED247_STREAM_TYPE_VIDEO ||
-                    stream_type == ED247_STREAM_TYPE_ETHERNET){
+                if(is_signal_stream(stream_type) == false){
                     status = ed247_stream_pop_sample(stream, &sample, &sample_size, &data_timestamp, &recv_timestamp, &sample_details, NULL);
                     if(check_status(context, status)) return status;
-                    output() << sample_details->component_identifier << ";"
-                        << sample_details->sequence_number << ";"
-                        << sample_details->transport_timestamp.epoch_s << ";"
-                        << sample_details->transport_timestamp.offset_ns << ";"
-                        << stream_name << ";"
-                        << data_timestamp->epoch_s << ";"
-                        << data_timestamp->offset_ns << ";"
-                        << recv_timestamp->epoch_s << ";"
-                        << recv_timestamp->offset_ns << ";";
-                    for(uint32_t i = 0 ; i < sample_size ; i++){
-                        if(i > 0) output() << " ";
-                        output() << std::hex << std::setfill('0') << std::setw(2) << (unsigned int)((unsigned char*)sample)[i];
-                    }
-                    output() << std::dec << ";";
-                    output() << "" << ";" << "" << std::endl; // Signal & SignalData columns
-                }else if(stream_type == ED247_STREAM_TYPE_ANALOG ||
-                    stream_type == ED247_STREAM_TYPE_DISCRETE ||
-                    stream_type == ED247_STREAM_TYPE_NAD ||
-                    stream_type == ED247_STREAM_TYPE_VNAD){
+                    csv_line(*sample_details, stream_name, *data_timestamp, *recv_timestamp, sample, sample_size, "", nullptr, 0);
+                }else{
                     ed247_stream_assistant_t assistant;
                     status = ed247_stream_get_assistant(stream, &assistant);
                     if(check_status(context, status)) return status;
@@ -151,33 +150,268 @@ int main(int argc, char *argv[])
                     status = ed247_stream_get_signal_list(stream, &signals);
                     if(check_status(context, status)) return status;
                     while(ed247_signal_list_next(signals, &signal) == ED247_STATUS_SUCCESS && signal != NULL){
-                        std::string signal_name = ed247_signal_get_name(signal);
                         const void * signal_sample;
                         uint32_t signal_sample_size;
                         status = ed247_stream_assistant_read_signal(assistant, signal, &signal_sample, &signal_sample_size);
                         if(check_status(context, status)) return status;
-                        output() << sample_details->component_identifier << ";"
-                            << sample_details->sequence_number << ";"
-                            << sample_details->transport_timestamp.epoch_s << ";"
-                            << sample_details->transport_timestamp.offset_ns << ";"
-                            << stream_name << ";"
-                            << data_timestamp->epoch_s << ";"
-                            << data_timestamp->offset_ns << ";"
-                            << recv_timestamp->epoch_s << ";"
-                            << recv_timestamp->offset_ns << ";"
-                            << "" << ";"
-                            << signal_name << ";"; // Stream data
-                        for(uint32_t i = 0 ; i < signal_sample_size ; i++){
-                            if(i > 0) output() << " ";
-                            output() << std::hex << std::setfill('0') << std::setw(2) << (unsigned int)((unsigned char*)signal_sample)[i];
-                        }
-                        output() << std::dec << std::endl;
+                        csv_line(*sample_details, stream_name, *data_timestamp, *recv_timestamp, nullptr, 0,
+                                 ed247_signal_get_name(signal), signal_sample, signal_sample_size);
                     }
                 }
             }
         }
     }while(status != ED247_STATUS_FAILURE && status != ED247_STATUS_TIMEOUT);
 
+    return EXIT_SUCCESS;
+}
+
+//
+// Binary capture
+//
+void capture_frame(ed247_context_t, ed247_channel_t channel, const void* frame, uint32_t frame_size, void* user_data)
+{
+    void* channel_index;
+    ed247_timestamp_t recv_timestamp;
+    ed247_channel_get_user_data(channel, &channel_index);
+    ed247_get_receive_timestamp(&recv_timestamp);
+    ((capture::Writer*)user_data)->write_frame((uint32_t)(uintptr_t)channel_index, recv_timestamp, frame, frame_size);
+}
+
+// Describe the context in the capture header. Set the index of channels and streams in their user data.
+bool build_capture_header(ed247_context_t context, capture::header_t& header)
+{
+    ed247_channel_list_t channels;
+    ed247_channel_t channel;
+    if (ed247_get_channel_list(context, &channels) != ED247_STATUS_SUCCESS) return false;
+    while(ed247_channel_list_next(channels, &channel) == ED247_STATUS_SUCCESS && channel != NULL){
+        ed247_channel_set_user_data(channel, (void*)(uintptr_t)header.channels.size());
+        header.channels.push_back(ed247_channel_get_name(channel));
+    }
+
+    ed247_stream_list_t streams;
+    ed247_stream_t stream;
+    if (ed247_get_stream_list(context, &streams) != ED247_STATUS_SUCCESS) return false;
+    while(ed247_stream_list_next(streams, &stream) == ED247_STATUS_SUCCESS && stream != NULL){
+        ed247_stream_set_user_data(stream, (void*)(uintptr_t)header.streams.size());
+        capture::stream_info_t stream_info;
+        stream_info.name = ed247_stream_get_name(stream);
+        stream_info.type = ed247_stream_get_type(stream);
+
+        if(is_signal_stream(ed247_stream_get_type(stream))){
+            ed247_signal_list_t signals;
+            ed247_signal_t signal;
+            if (ed247_stream_get_signal_list(stream, &signals) != ED247_STATUS_SUCCESS) return false;
+            while(ed247_signal_list_next(signals, &signal) == ED247_STATUS_SUCCESS && signal != NULL){
+                capture::signal_info_t signal_info;
+                void* sample;
+                signal_info.name = ed247_signal_get_name(signal);
+                signal_info.type = ed247_signal_get_type(signal);
+                signal_info.byte_offset = ed247_signal_get_byte_offset(signal);
+                if (ed247_signal_allocate_sample(signal, &sample, &signal_info.size) != ED247_STATUS_SUCCESS) return false;
+                ed247_signal_free_sample(sample);
+                switch(signal_info.type){
+                case ED247_SIGNAL_TYPE_DISCRETE: signal_info.element_size = 1; break;
+                case ED247_SIGNAL_TYPE_ANALOG:   signal_info.element_size = 4; break;
+                default:                         signal_info.element_size = ed247_nad_type_size(ed247_signal_nad_get_type(signal));
+                }
+                stream_info.signals.push_back(signal_info);
+            }
+        }
+        header.streams.push_back(stream_info);
+    }
+    return true;
+}
+
+int dump_capture(ed247_context_t context, const std::string& capture_file, uint32_t timeout_ms)
+{
+    ed247_status_t               status = ED247_STATUS_SUCCESS;
+    ed247_stream_list_t          streams = nullptr;
+    ed247_stream_t               stream = nullptr;
+    const void                   *sample = nullptr;
+    uint32_t                     sample_size = 0;
+    const ed247_timestamp_t      *data_timestamp = nullptr;
+    const ed247_timestamp_t      *recv_timestamp = nullptr;
+    const ed247_sample_details_t *sample_details = nullptr;
+    bool                         empty = false;
+
+    capture::header_t header;
+    capture::Writer writer;
+    if (build_capture_header(context, header) == false) return EXIT_FAILURE;
+    if (writer.open(capture_file, header) == false) return EXIT_FAILURE;
+    SAY("Capture to file " << capture_file);
+
+    if (check_status(context, ed247_set_frame_recv_callback(context, &capture_frame, &writer))) return EXIT_FAILURE;
+
+    uint64_t start, stop;
+    start = time_tools::get_monotonic_time_us();
+    int32_t timeout_us = timeout_ms*1000;
+    do {
+        stop = time_tools::get_monotonic_time_us();
+        status = ed247_wait_frame(context, &streams, timeout_us - (stop-start));
+        if(status == ED247_STATUS_SUCCESS){
+            while(ed247_stream_list_next(streams, &stream) == ED247_STATUS_SUCCESS && stream != NULL){
+                void* stream_index;
+                ed247_stream_get_user_data(stream, &stream_index);
+                // Record all the received samples, not only the last one
+                do {
+                    if (ed247_stream_pop_sample(stream, &sample, &sample_size, &data_timestamp, &recv_timestamp, &sample_details, &empty) != ED247_STATUS_SUCCESS) break;
+                    writer.write_sample((uint32_t)(uintptr_t)stream_index, *sample_details, *data_timestamp, *recv_timestamp, sample, sample_size);
+                } while(empty == false);
+            }
+        }
+    }while(status != ED247_STATUS_FAILURE && status != ED247_STATUS_TIMEOUT);
+
+    ed247_set_frame_recv_callback(context, nullptr, nullptr);
+    writer.close();
+    PRINT_INFO("Captured " << writer.get_record_count() << " records (writer backlog peak: " << writer.get_max_backlog() << " blocks)");
+    return (status == ED247_STATUS_FAILURE) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+//
+// Binary capture to CSV
+//
+// Copy a signal value from the network sample, converting its values to host byte order like the stream assistants
+void copy_signal(const capture::signal_info_t& signal, const char* source, uint32_t size, std::vector<char>& value)
+{
+    value.resize(size);
+    switch (signal.element_size) {
+    case 2:
+        for (uint32_t pos = 0; pos + sizeof(uint16_t) <= size; pos += sizeof(uint16_t)) {
+            uint16_t element;
+            memcpy(&element, source + pos, sizeof(element));
+            element = ntohs(element);
+            memcpy(&value[pos], &element, sizeof(element));
+        }
+        break;
+    case 4:
+        for (uint32_t pos = 0; pos + sizeof(uint32_t) <= size; pos += sizeof(uint32_t)) {
+            uint32_t element;
+            memcpy(&element, source + pos, sizeof(element));
+            element = ntohl(element);
+            memcpy(&value[pos], &element, sizeof(element));
+        }
+        break;
+    case 8:
+        for (uint32_t pos = 0; pos + sizeof(uint64_t) <= size; pos += sizeof(uint64_t)) {
+            uint32_t high, low;
+            memcpy(&high, source + pos, sizeof(high));
+            memcpy(&low, source + pos + sizeof(high), sizeof(low));
+            uint64_t element = ((uint64_t)ntohl(high) << 32) | ntohl(low);
+            memcpy(&value[pos], &element, sizeof(element));
+        }
+        break;
+    default:
+        memcpy(value.data(), source, size);
+        break;
+    }
+}
+
+int convert_to_csv(const std::string& capture_file)
+{
+    capture::Reader reader;
+    capture::record_t record;
+    std::vector<char> signal_value;
+
+    if (reader.open(capture_file) == false) return EXIT_FAILURE;
+    const capture::header_t& header = reader.get_header();
+
+    csv_header();
+
+    while (reader.next(record)) {
+        if (record.type != capture::RECORD_SAMPLE) continue;
+
+        const capture::stream_info_t& stream = header.streams[record.index];
+        if (is_signal_stream((ed247_stream_type_t)stream.type) == false) {
+            csv_line(record.details, stream.name, record.data_timestamp, record.recv_timestamp,
+                     record.payload.data(), record.payload.size(), "", nullptr, 0);
+            continue;
+        }
+
+        uint32_t vnad_index = 0;
+        for (const capture::signal_info_t& signal : stream.signals) {
+            const char* source;
+            uint32_t size;
+            if (stream.type == ED247_STREAM_TYPE_VNAD) {
+                if (vnad_index + sizeof(uint16_t) > record.payload.size()) break;
+                const unsigned char* size_field = (const unsigned char*)record.payload.data() + vnad_index;
+                size = ((uint32_t)size_field[0] << 8) | size_field[1];   // Network byte order
+                source = record.payload.data() + vnad_index + sizeof(uint16_t);
+                vnad_index += sizeof(uint16_t) + size;
+                if (vnad_index > record.payload.size()) break;
+            } else {
+                if (signal.byte_offset + signal.size > record.payload.size()) continue;
+                size = signal.size;
+                source = record.payload.data() + signal.byte_offset;
+            }
+            copy_signal(signal, source, size, signal_value);
+            csv_line(record.details, stream.name, record.data_timestamp, record.recv_timestamp, nullptr, 0,
+                     signal.name, signal_value.data(), size);
+        }
+    }
+
+    if (reader.is_truncated()) {
+        PRINT_WARNING("The capture file is truncated");
+    }
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+    ed247_status_t  status = ED247_STATUS_SUCCESS;
+    ed247_context_t context = nullptr;
+    std::string     capture_file;
+    int             ecic_arg = 1;
+    int             timeout_arg = 0;
+
+    // Retrieve arguments
+    if (argc >= 2 && std::string(argv[1]) == "--to-csv") {
+      if (argc != 3 && argc != 4) {
+        help();
+        return EXIT_FAILURE;
+      }
+      if (argc == 4) {
+        output_stream.open(argv[3]);
+        if (output_stream.is_open() == false) {
+          PRINT_ERROR("Cannot open file '" << argv[3] << "'");
+          return EXIT_FAILURE;
+        }
+      }
+      return convert_to_csv(argv[2]);
+    } else if (argc == 5 && std::string(argv[1]) == "--capture") {
+      ecic_arg = 2;
+      capture_file = argv[3];
+      timeout_arg = 4;
+    } else if (argc == 3) {
+      timeout_arg = 2;
+    } else if (argc == 4) {
+      output_stream.open(argv[2]);
+      if (output_stream.is_open()) {
+        SAY("Dump to file " << argv[2]);
+      } else {
+        PRINT_ERROR("Cannot open file '" << argv[2] << "'");
+      }
+      timeout_arg = 3;
+    } else {
+      help();
+      return EXIT_FAILURE;
+    }
+
+    std::string ecic_file = std::string(argv[ecic_arg]);
+    status = ed247_load_file(ecic_file.c_str(), &context);
+    if(check_status(context, status)) return EXIT_FAILURE;
+    PRINT_INFO("ECIC file : '" << ecic_file << "'");
+
+    char* last;
+    uint32_t timeout_ms = strtol(argv[timeout_arg], &last, 10);
+    if (*last){
+      PRINT_ERROR("Invalid timout argument: '" << argv[timeout_arg] << "'");
+      return EXIT_FAILURE;
+    }
+    PRINT_INFO("Timeout : '" << timeout_ms << "'");
+
+    int result = capture_file.empty() ? dump_csv(context, timeout_ms) : dump_capture(context, capture_file, timeout_ms);
+    if (result != EXIT_SUCCESS) return result;
+
     status = ed247_unload(context);
     if(check_status(context,status)) return EXIT_FAILURE;
 
@@ -0,0 +1,396 @@
+#include "pcap_tools.h"
+#include <cstring>
+
+namespace {
+  // pcapng blocks
+  const uint32_t BLOCK_SECTION_HEADER     = 0x0A0D0D0A;
+  const uint32_t BLOCK_INTERFACE          = 0x00000001;
+  const uint32_t BLOCK_ENHANCED_PACKET    = 0x00000006;
+  const uint32_t BYTE_ORDER_MAGIC         = 0x1A2B3C4D;
+  const uint16_t OPTION_END               = 0;
+  const uint16_t OPTION_COMMENT           = 1;
+  const uint16_t OPTION_IF_TSRESOL        = 9;
+
+  // pcap file header
+  const uint32_t PCAP_MAGIC_US            = 0xA1B2C3D4;
+  const uint32_t PCAP_MAGIC_NS            = 0xA1B23C4D;
+  const uint32_t PCAP_HEADER_SIZE         = 24;
+  const uint32_t PCAP_RECORD_HEADER_SIZE  = 16;
+
+  // Link types
+  const uint16_t LINKTYPE_NULL            = 0;
+  const uint16_t LINKTYPE_ETHERNET        = 1;
+  const uint16_t LINKTYPE_RAW             = 101;
+  const uint16_t LINKTYPE_LINUX_SLL       = 113;
+  const uint16_t LINKTYPE_IPV4            = 228;
+  const uint16_t LINKTYPE_LINUX_SLL2      = 276;
+
+  const uint16_t ETHERTYPE_IPV4           = 0x0800;
+  const uint16_t ETHERTYPE_VLAN           = 0x8100;
+  const uint16_t ETHERTYPE_QINQ           = 0x88A8;
+  const uint8_t  IPPROTO_UDP_NUMBER       = 17;
+  const uint32_t IPV4_HEADER_SIZE         = 20;
+  const uint32_t UDP_HEADER_SIZE          = 8;
+
+  const uint64_t NS_PER_S                 = 1000000000;
+
+  uint32_t padded(uint32_t size) { return (size + 3) & ~3u; }
+
+  // Network byte order accessors
+  uint16_t get_be16(const char* data) { return ((uint16_t)(uint8_t)data[0] << 8) | (uint8_t)data[1]; }
+  uint32_t get_be32(const char* data) { return ((uint32_t)get_be16(data) << 16) | get_be16(data + 2); }
+  void set_be16(char* data, uint16_t value) { data[0] = (char)(value >> 8); data[1] = (char)value; }
+  void set_be32(char* data, uint32_t value) { set_be16(data, (uint16_t)(value >> 16)); set_be16(data + 2, (uint16_t)value); }
+
+  template<typename T>
+  void append(std::vector<char>& buffer, T value)
+  {
+    const char* bytes = (const char*)&value;
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+  }
+
+  void append_option(std::vector<char>& buffer, uint16_t code, const void* value, uint16_t size)
+  {
+    append<uint16_t>(buffer, code);
+    append<uint16_t>(buffer, size);
+    buffer.insert(buffer.end(), (const char*)value, (const char*)value + size);
+    buffer.resize(padded(buffer.size()), 0);
+  }
+}
+
+//
+// Writer
+//
+bool pcap::Writer::open(const std::string& path)
+{
+  close();
+  _file = fopen(path.c_str(), "wb");
+  if (_file == nullptr) return false;
+  setvbuf(_file, nullptr, _IOFBF, 1 << 20);
+
+  std::vector<char> body;
+  append<uint32_t>(body, BYTE_ORDER_MAGIC);
+  append<uint16_t>(body, 1);                 // Major version
+  append<uint16_t>(body, 0);                 // Minor version
+  append<int64_t>(body, -1);                 // Section length: unknown
+  if (write_block(BLOCK_SECTION_HEADER, body) == false) return false;
+
+  body.clear();
+  append<uint16_t>(body, LINKTYPE_IPV4);
+  append<uint16_t>(body, 0);                 // Reserved
+  append<uint32_t>(body, 0xFFFF);            // Snap length
+  uint8_t tsresol = 9;                       // Nanoseconds
+  append_option(body, OPTION_IF_TSRESOL, &tsresol, sizeof(tsresol));
+  append_option(body, OPTION_END, nullptr, 0);
+  return write_block(BLOCK_INTERFACE, body);
+}
+
+void pcap::Writer::close()
+{
+  if (_file) {
+    fclose(_file);
+    _file = nullptr;
+  }
+}
+
+bool pcap::Writer::write(uint64_t timestamp_ns,
+                         uint32_t source_ip, uint16_t source_port,
+                         uint32_t destination_ip, uint16_t destination_port,
+                         const void* payload, uint32_t size,
+                         const std::string& comment)
+{
+  if (_file == nullptr) return false;
+  uint32_t packet_size = IPV4_HEADER_SIZE + UDP_HEADER_SIZE + size;
+
+  _block.clear();
+  append<uint32_t>(_block, 0);               // Interface id
+  append<uint32_t>(_block, (uint32_t)(timestamp_ns >> 32));
+  append<uint32_t>(_block, (uint32_t)timestamp_ns);
+  append<uint32_t>(_block, packet_size);     // Captured length
+  append<uint32_t>(_block, packet_size);     // Original length
+
+  // IPv4 header
+  size_t ip_header = _block.size();
+  _block.resize(ip_header + IPV4_HEADER_SIZE + UDP_HEADER_SIZE, 0);
+  char* ip = _block.data() + ip_header;
+  ip[0] = 0x45;                              // Version 4, 5 words
+  set_be16(ip + 2, (uint16_t)packet_size);
+  set_be16(ip + 4, _ip_identification++);
+  ip[8] = 64;                                // TTL
+  ip[9] = IPPROTO_UDP_NUMBER;
+  set_be32(ip + 12, source_ip);
+  set_be32(ip + 16, destination_ip);
+  uint32_t checksum = 0;
+  for (uint32_t pos = 0; pos < IPV4_HEADER_SIZE; pos += 2) checksum += get_be16(ip + pos);
+  while (checksum >> 16) checksum = (checksum & 0xFFFF) + (checksum >> 16);
+  set_be16(ip + 10, (uint16_t)~checksum);
+
+  // UDP header (no checksum)
+  char* udp = ip + IPV4_HEADER_SIZE;
+  set_be16(udp + 0, source_port);
+  set_be16(udp + 2, destination_port);
+  set_be16(udp + 4, (uint16_t)(UDP_HEADER_SIZE + size));
+
+  _block.insert(_block.end(), (const char*)payload, (const char*)payload + size);
+  _block.resize(padded(_block.size()), 0);
+
+  if (comment.empty() == false) {
+    append_option(_block, OPTION_COMMENT, comment.data(), (uint16_t)comment.size());
+    append_option(_block, OPTION_END, nullptr, 0);
+  }
+
+  if (write_block(BLOCK_ENHANCED_PACKET, _block) == false) return false;
+  _datagram_count++;
+  return true;
+}
+
+bool pcap::Writer::write_block(uint32_t type, const std::vector<char>& body)
+{
+  uint32_t total_length = 12 + body.size();
+  return
+    fwrite(&type, sizeof(type), 1, _file) == 1 &&
+    fwrite(&total_length, sizeof(total_length), 1, _file) == 1 &&
+    fwrite(body.data(), 1, body.size(), _file) == body.size() &&
+    fwrite(&total_length, sizeof(total_length), 1, _file) == 1;
+}
+
+//
+// Reader
+//
+bool pcap::Reader::open(const std::string& path)
+{
+  close();
+  _file = fopen(path.c_str(), "rb");
+  if (_file == nullptr) return false;
+
+  char header[PCAP_HEADER_SIZE];
+  if (fread(header, 1, 4, _file) != 4) return false;
+  uint32_t magic;
+  memcpy(&magic, header, sizeof(magic));
+
+  if (magic == BLOCK_SECTION_HEADER) {
+    // The section header is read by next()
+    _pcapng = true;
+    return fseek(_file, 0, SEEK_SET) == 0;
+  }
+
+  _pcapng = false;
+  if (magic == PCAP_MAGIC_US || magic == PCAP_MAGIC_NS) {
+    _swapped = false;
+  } else {
+    _swapped = true;
+    magic = swap(magic);
+    if (magic != PCAP_MAGIC_US && magic != PCAP_MAGIC_NS) return false;
+  }
+  _pcap_ticks_per_s = (magic == PCAP_MAGIC_NS) ? NS_PER_S : 1000000;
+
+  if (fread(header + 4, 1, PCAP_HEADER_SIZE - 4, _file) != PCAP_HEADER_SIZE - 4) return false;
+  uint32_t link_type;
+  memcpy(&link_type, header + 20, sizeof(link_type));
+  _pcap_link_type = swap(link_type) & 0xFFFF;
+  return true;
+}
+
+void pcap::Reader::close()
+{
+  if (_file) {
+    fclose(_file);
+    _file = nullptr;
+  }
+  _interfaces.clear();
+}
+
+bool pcap::Reader::next(datagram_t& datagram)
+{
+  const char* packet;
+  uint32_t size;
+  uint32_t link_type = _pcap_link_type;
+
+  while (true) {
+    datagram.comment.clear();
+    bool found = _pcapng ?
+      next_pcapng_packet(packet, size, datagram.timestamp_ns, link_type, datagram.comment) :
+      next_pcap_packet(packet, size, datagram.timestamp_ns);
+    if (found == false) return false;
+    if (decode(packet, size, link_type, datagram)) return true;
+    _skipped_count++;
+  }
+}
+
+bool pcap::Reader::next_pcapng_packet(const char*& packet, uint32_t& size, uint64_t& timestamp_ns, uint32_t& link_type, std::string& comment)
+{
+  while (_file) {
+    uint32_t block_header[2];
+    if (fread(block_header, sizeof(block_header), 1, _file) != 1) return false;
+    uint32_t type = block_header[0];
+    uint32_t length = block_header[1];
+
+    if (type == BLOCK_SECTION_HEADER) {
+      // A new section may change the byte order
+      uint32_t magic;
+      if (fread(&magic, sizeof(magic), 1, _file) != 1) return false;
+      if (magic == BYTE_ORDER_MAGIC) {
+        _swapped = false;
+      } else if (swap(magic) == BYTE_ORDER_MAGIC) {
+        _swapped = true;
+      } else {
+        return false;
+      }
+      length = swap(length);
+      _interfaces.clear();
+      if (length < 16 || fseek(_file, length - 12, SEEK_CUR) != 0) return false;
+      continue;
+    }
+
+    type = swap(type);
+    length = swap(length);
+    if (length < 12 || length % 4 != 0) return false;
+    _block.resize(length - 8);
+    if (fread(_block.data(), 1, _block.size(), _file) != _block.size()) return false;
+    const char* body = _block.data();
+    uint32_t body_size = length - 12;
+
+    // Options: code, length, padded value
+    const char* options = nullptr;
+    uint32_t options_size = 0;
+
+    if (type == BLOCK_INTERFACE && body_size >= 8) {
+      uint16_t interface_link_type;
+      memcpy(&interface_link_type, body, sizeof(interface_link_type));
+      _interfaces.push_back(interface_t{ swap(interface_link_type), 1000000 });
+      options = body + 8;
+      options_size = body_size - 8;
+    } else if (type == BLOCK_ENHANCED_PACKET && body_size >= 20) {
+      uint32_t fields[5];
+      memcpy(fields, body, sizeof(fields));
+      uint32_t interface_id = swap(fields[0]);
+      uint32_t captured_size = swap(fields[3]);
+      if (interface_id >= _interfaces.size() || 20 + padded(captured_size) > body_size) return false;
+
+      uint64_t ticks = ((uint64_t)swap(fields[1]) << 32) | swap(fields[2]);
+      uint64_t ticks_per_s = _interfaces[interface_id].ticks_per_s;
+      timestamp_ns = ticks / ticks_per_s * NS_PER_S + (ticks % ticks_per_s) * NS_PER_S / ticks_per_s;
+      link_type = _interfaces[interface_id].link_type;
+      packet = body + 20;
+      size = captured_size;
+      options = body + 20 + padded(captured_size);
+      options_size = body_size - 20 - padded(captured_size);
+    } else {
+      continue;
+    }
+
+    while (options_size >= 4) {
+      uint16_t option[2];
+      memcpy(option, options, sizeof(option));
+      uint16_t code = swap(option[0]);
+      uint16_t option_size = swap(option[1]);
+      if (code == OPTION_END || 4 + padded(option_size) > options_size) break;
+      if (type == BLOCK_INTERFACE && code == OPTION_IF_TSRESOL && option_size >= 1) {
+        uint8_t tsresol = (uint8_t)options[4];
+        uint64_t ticks_per_s = 1;
+        if (tsresol & 0x80) {
+          ticks_per_s <<= (tsresol & 0x7F);
+        } else {
+          for (uint8_t digit = 0; digit < tsresol; digit++) ticks_per_s *= 10;
+        }
+        _interfaces.back().ticks_per_s = ticks_per_s;
+      }
+      if (type == BLOCK_ENHANCED_PACKET && code == OPTION_COMMENT) {
+        comment.assign(options + 4, option_size);
+      }
+      options += 4 + padded(option_size);
+      options_size -= 4 + padded(option_size);
+    }
+
+    if (type == BLOCK_ENHANCED_PACKET) return true;
+  }
+  return false;
+}
+
+bool pcap::Reader::next_pcap_packet(const char*& packet, uint32_t& size, uint64_t& timestamp_ns)
+{
+  if (_file == nullptr) return false;
+  uint32_t record[PCAP_RECORD_HEADER_SIZE / 4];
+  if (fread(record, sizeof(record), 1, _file) != 1) return false;
+  uint32_t captured_size = swap(record[2]);
+  _block.resize(captured_size);
+  if (fread(_block.data(), 1, captured_size, _file) != captured_size) return false;
+
+  timestamp_ns = (uint64_t)swap(record[0]) * NS_PER_S + (uint64_t)swap(record[1]) * (NS_PER_S / _pcap_ticks_per_s);
+  packet = _block.data();
+  size = captured_size;
+  return true;
+}
+
+bool pcap::Reader::decode(const char* packet, uint32_t size, uint32_t link_type, datagram_t& datagram)
+{
+  // Link layer
+  uint32_t offset = 0;
+  switch (link_type) {
+  case LINKTYPE_NULL: {
+    if (size < 4) return false;
+    uint32_t family;
+    memcpy(&family, packet, sizeof(family));
+    if (family != 2 && family != 0x02000000) return false;   // AF_INET in either byte order
+    offset = 4;
+    break;
+  }
+  case LINKTYPE_ETHERNET: {
+    offset = 12;
+    if (size < offset + 2) return false;
+    uint16_t ethertype = get_be16(packet + offset);
+    while (ethertype == ETHERTYPE_VLAN || ethertype == ETHERTYPE_QINQ) {
+      offset += 4;
+      if (size < offset + 2) return false;
+      ethertype = get_be16(packet + offset);
+    }
+    if (ethertype != ETHERTYPE_IPV4) return false;
+    offset += 2;
+    break;
+  }
+  case LINKTYPE_RAW:
+  case LINKTYPE_IPV4:
+    break;
+  case LINKTYPE_LINUX_SLL:
+    if (size < 16 || get_be16(packet + 14) != ETHERTYPE_IPV4) return false;
+    offset = 16;
+    break;
+  case LINKTYPE_LINUX_SLL2:
+    if (size < 20 || get_be16(packet) != ETHERTYPE_IPV4) return false;
+    offset = 20;
+    break;
+  default:
+    return false;
+  }
+
+  // IPv4
+  const char* ip = packet + offset;
+  if (size < offset + IPV4_HEADER_SIZE || ((uint8_t)ip[0] >> 4) != 4) return false;
+  uint32_t ip_header_size = ((uint8_t)ip[0] & 0x0F) * 4;
+  if (ip_header_size < IPV4_HEADER_SIZE || (uint8_t)ip[9] != IPPROTO_UDP_NUMBER) return false;
+  if ((get_be16(ip + 6) & 0x3FFF) != 0) return false;   // Fragment
+  offset += ip_header_size;
+
+  // UDP
+  const char* udp = packet + offset;
+  if (size < offset + UDP_HEADER_SIZE) return false;
+  uint16_t udp_size = get_be16(udp + 4);
+  if (udp_size < UDP_HEADER_SIZE || size < offset + udp_size) return false;
+
+  datagram.source_ip = get_be32(ip + 12);
+  datagram.destination_ip = get_be32(ip + 16);
+  datagram.source_port = get_be16(udp);
+  datagram.destination_port = get_be16(udp + 2);
+  datagram.payload.assign(udp + UDP_HEADER_SIZE, udp + udp_size);
+  return true;
+}
+
+uint16_t pcap::Reader::swap(uint16_t value) const
+{
+  return _swapped ? (uint16_t)((value >> 8) | (value << 8)) : value;
+}
+
+uint32_t pcap::Reader::swap(uint32_t value) const
+{
+  return _swapped ? ((value >> 24) | ((value >> 8) & 0xFF00) | ((value << 8) & 0xFF0000) | (value << 24)) : value;
+}
@@ -0,0 +1,105 @@
+#ifndef __PCAP_TOOLS_H__
+#define __PCAP_TOOLS_H__
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+//
+// Read and write UDP/IPv4 datagrams in capture files.
+//
+// Writer: pcapng file with a single raw IPv4 interface (LINKTYPE_IPV4) and
+// nanosecond timestamps. The IPv4 and UDP headers are synthesized from the
+// datagram addresses. The comment of each packet is stored in an opt_comment.
+//
+// Reader: pcapng or pcap file (both byte orders, us or ns timestamps) with
+// Ethernet, raw IPv4 or Linux cooked link types. Packets other than unfragmented
+// UDP/IPv4 datagrams are skipped.
+//
+namespace pcap {
+
+  struct datagram_t {
+    uint64_t          timestamp_ns{0};      // Since epoch
+    uint32_t          source_ip{0};         // Host byte order
+    uint16_t          source_port{0};
+    uint32_t          destination_ip{0};
+    uint16_t          destination_port{0};
+    std::vector<char> payload;              // UDP payload
+    std::string       comment;              // pcapng opt_comment (empty if none)
+  };
+
+  class Writer {
+  public:
+    Writer() = default;
+    ~Writer() { close(); }
+
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    // Write the section and interface headers. Return false on failure.
+    bool open(const std::string& path);
+    void close();
+
+    // Return false on failure
+    bool write(uint64_t timestamp_ns,
+               uint32_t source_ip, uint16_t source_port,
+               uint32_t destination_ip, uint16_t destination_port,
+               const void* payload, uint32_t size,
+               const std::string& comment);
+
+    uint64_t get_datagram_count() const { return _datagram_count; }
+
+  private:
+    bool write_block(uint32_t type, const std::vector<char>& body);
+
+    FILE*             _file{nullptr};
+    std::vector<char> _block;
+    uint16_t          _ip_identification{0};
+    uint64_t          _datagram_count{0};
+  };
+
+  class Reader {
+  public:
+    Reader() = default;
+    ~Reader() { close(); }
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    // Read the file header. Return false if the file cannot be opened or is not a pcap/pcapng file.
+    bool open(const std::string& path);
+    void close();
+
+    // Read the next UDP datagram. Return false at the end of the file.
+    bool next(datagram_t& datagram);
+
+    // Number of packets skipped because they are not UDP/IPv4 datagrams
+    uint64_t get_skipped_count() const { return _skipped_count; }
+
+  private:
+    struct interface_t {
+      uint16_t link_type;
+      uint64_t ticks_per_s;
+    };
+
+    bool next_pcapng_packet(const char*& packet, uint32_t& size, uint64_t& timestamp_ns, uint32_t& link_type, std::string& comment);
+    bool next_pcap_packet(const char*& packet, uint32_t& size, uint64_t& timestamp_ns);
+    bool decode(const char* packet, uint32_t size, uint32_t link_type, datagram_t& datagram);
+
+    uint16_t swap(uint16_t value) const;
+    uint32_t swap(uint32_t value) const;
+
+    FILE*                    _file{nullptr};
+    bool                     _pcapng{false};
+    bool                     _swapped{false};
+    uint64_t                 _pcap_ticks_per_s{0};
+    uint32_t                 _pcap_link_type{0};
+    std::vector<interface_t> _interfaces;
+    std::vector<char>        _block;
+    uint64_t                 _skipped_count{0};
+  };
+
+}
+
+#endif
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+
+#include <stdio.h>
+#include <string>
+#include <fstream>
+#include <chrono>
+#ifndef _WIN32
+# include <sys/resource.h>
+#endif
+
+#include <ed247.h>
+#include <ed247_logs.h>
+
+// Measure the load time of a generated ECIC.
+// Run one process per mode to get meaningful peak memory values.
+
+static const uint32_t signals_per_stream = 100;
+static const uint32_t streams_per_channel = 50;
+
+void generate_ecic(const std::string& filepath, uint32_t signal_count)
+{
+    std::ofstream ecic(filepath);
+    ecic << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+         << "<ED247ComponentInstanceConfiguration ComponentType=\"Virtual\" Name=\"loadbench\" StandardRevision=\"A\" Identifier=\"0\">\n"
+         << "  <Channels>\n";
+
+    uint32_t signal_id = 0;
+    uint32_t stream_id = 0;
+    for (uint32_t channel_id = 0; signal_id < signal_count; channel_id++) {
+        ecic << "    <MultiChannel Name=\"Channel" << channel_id << "\">\n"
+             << "      <FrameFormat StandardRevision=\"A\"/>\n"
+             << "      <ComInterface><UDP_Sockets><UDP_Socket DstIP=\"127.0.0.1\" DstPort=\"" << 30000 + channel_id << "\"/></UDP_Sockets></ComInterface>\n"
+             << "      <Streams>\n";
+        for (uint32_t s = 0; s < streams_per_channel && signal_id < signal_count; s++, stream_id++) {
+            ecic << "        <NAD_Stream UID=\"" << s << "\" Name=\"Stream" << stream_id << "\" SampleMaxSizeBytes=\"" << signals_per_stream * 4 << "\" Direction=\"Out\">\n"
+                 << "          <Signals SamplingPeriodUs=\"10000\">\n";
+            for (uint32_t i = 0; i < signals_per_stream && signal_id < signal_count; i++, signal_id++) {
+                ecic << "            <Signal Name=\"Signal" << signal_id << "\" Type=\"uint32\" Dimensions=\"1\" ByteOffset=\"" << i * 4 << "\"/>\n";
+            }
+            ecic << "          </Signals>\n"
+                 << "        </NAD_Stream>\n";
+        }
+        ecic << "      </Streams>\n"
+             << "    </MultiChannel>\n";
+    }
+    ecic << "  </Channels>\n"
+         << "</ED247ComponentInstanceConfiguration>\n";
+}
+
+int main(int argc, char *argv[])
+{
+    ed247_status_t  status = ED247_STATUS_FAILURE;
+    ed247_context_t context = nullptr;
+
+    // Retrieve arguments
+    if(argc < 2 || argc > 3){
+        PRINT_ERROR("loadbench <dom|streaming|compiled> [signal_count (default 50000)]");
+        return EXIT_FAILURE;
+    }
+    std::string mode = argv[1];
+    uint32_t signal_count = (argc == 3)? std::stoul(argv[2]) : 50000;
+
+    std::string filepath = "loadbench.xml";
+    std::string compiled_filepath = "loadbench.ecic.bin";
+    generate_ecic(filepath, signal_count);
+    if (mode == "compiled") {
+        if (ed247_compile_file(filepath.c_str(), compiled_filepath.c_str()) != ED247_STATUS_SUCCESS) return EXIT_FAILURE;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (mode == "dom") {
+        status = ed247_load_file(filepath.c_str(), &context);
+    } else if (mode == "streaming") {
+        status = ed247_load_file_streaming(filepath.c_str(), &context);
+    } else if (mode == "compiled") {
+        status = ed247_load_compiled(compiled_filepath.c_str(), &context);
+    } else {
+        PRINT_ERROR("Unknown mode '" << mode << "'");
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    if(status != ED247_STATUS_SUCCESS){
+        PRINT_ERROR("ED247 status: " << ed247_status_string(status));
+        return EXIT_FAILURE;
+    }
+
+    SAY("mode: " << mode << " signals: " << signal_count <<
+        " load time: " << std::chrono::duration_cast<std::chrono::milliseconds>(stop - start).count() << " ms");
+#ifndef _WIN32
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    SAY("mode: " << mode << " peak RSS: " << usage.ru_maxrss / 1024 << " MB");
+#endif
+
+    ed247_unload(context);
+    remove(filepath.c_str());
+    remove(compiled_filepath.c_str());
+    return EXIT_SUCCESS;
+}
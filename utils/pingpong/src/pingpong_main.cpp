@@ -0,0 +1,560 @@
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <ed247.h>
+#include "ed247_logs.h"
+
+//
+// Round-trip latency through the library.
+//
+// The ECIC is generated: for each stream type, a multichannel carries a ping
+// stream (UID 0) from the pinger to the ponger and a pong stream (UID 1) back.
+// The pinger writes a sequence number in a sample, sends it and waits for the
+// ponger to echo it. The round-trip time covers push, encode, send, receive,
+// decode and pop on both sides.
+//
+// Signal based streams are written and read by the stream assistant on the
+// pinger side. The ponger echoes the raw samples of every stream type.
+//
+
+void help() {
+  std::cout <<
+    "USAGE: pingpong [OPTIONS] local|ping|pong" << std::endl <<
+    "       local: pinger and ponger run in two threads of this process (UDP loopback)" << std::endl <<
+    "       ping:  pinger only, the ponger is another process (run it first)" << std::endl <<
+    "       pong:  ponger only, echo the pings until interrupted" << std::endl <<
+    "OPTIONS:" << std::endl <<
+    "  -n <count>      Number of measured round trips per stream type (default: 100000)" << std::endl <<
+    "  -w <count>      Number of warm-up round trips per stream type (default: 1000)" << std::endl <<
+    "  -s <size>       Sample size of the byte streams, at least 4 (default: 8)" << std::endl <<
+    "  -t <types>      Comma separated stream types (default: A429,A664,A825,SERIAL,ETH,DIS,ANA,NAD,VNAD)" << std::endl <<
+    "  -l <ip>         Local IP the input sockets are bound to (default: 127.0.0.1)" << std::endl <<
+    "  -r <ip>         IP of the other side (default: 127.0.0.1)" << std::endl <<
+    "  -p <port>       First UDP port. Each stream type uses two ports (default: 2700)" << std::endl <<
+    "  -o <timeout_ms> Round trip timeout, the sample is counted as lost (default: 1000)" << std::endl <<
+    "  -b <spin_us>    Busy poll receive mode with this spin budget (see ed247_component_set_busy_poll())" << std::endl <<
+    "  -g              Dump the generated ECIC of the role(s) and exit" << std::endl <<
+    "The ping and pong sides shall be run with the same -t, -s and -p options." << std::endl;
+}
+
+namespace {
+
+  struct stream_type_t {
+    const char*         name;
+    uint32_t            signal_count;     // 0: byte stream. Signal streams carry the sequence number in their signals.
+    uint32_t            max_size;         // Sample max size of the byte streams
+    bool                sized;            // SampleMaxSizeBytes attribute of the byte streams
+  };
+
+  const stream_type_t STREAM_TYPES[] = {
+    { "A429",   0, 4,     false },
+    { "A664",   0, 65535, true  },
+    { "A825",   0, 69,    false },
+    { "SERIAL", 0, 65535, true  },
+    { "ETH",    0, 65535, true  },
+    { "DIS",    4, 0,     false },
+    { "ANA",    1, 0,     false },
+    { "NAD",    1, 0,     false },
+    { "VNAD",   1, 0,     false },
+  };
+
+  struct options_t {
+    std::string                        mode;
+    uint64_t                           iterations{100000};
+    uint64_t                           warmup{1000};
+    uint32_t                           size{8};
+    std::vector<const stream_type_t*>  types;
+    std::string                        local_ip{"127.0.0.1"};
+    std::string                        peer_ip{"127.0.0.1"};
+    uint32_t                           port{2700};
+    uint32_t                           timeout_ms{1000};
+    uint32_t                           spin_us{0};
+    bool                               generate_only{false};
+  };
+
+  volatile sig_atomic_t stop_requested = 0;
+  void request_stop(int) { stop_requested = 1; }
+
+  const int32_t PONG_WAIT_US = 100000;
+  const uint32_t MAX_CONSECUTIVE_LOSSES = 10;     // The stream type is given up (no ponger, or different options)
+  const uint32_t SEQUENCE_SIZE = sizeof(uint32_t);
+
+  uint64_t now_ns()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  uint32_t sample_size(const options_t& options, const stream_type_t& type)
+  {
+    return std::min(options.size, type.max_size);
+  }
+
+  std::string stream_name(const stream_type_t& type, bool ping)
+  {
+    return std::string(type.name) + (ping ? "_Ping" : "_Pong");
+  }
+
+  std::string signal_name(const stream_type_t& type, bool ping, uint32_t index)
+  {
+    return stream_name(type, ping) + "_" + std::to_string(index);
+  }
+
+  // XML of the ping (UID 0) or pong (UID 1) stream of type
+  std::string stream_xml(const options_t& options, const stream_type_t& type, bool ping, const char* direction)
+  {
+    std::ostringstream xml;
+    std::string tag = std::string(type.name) + "_Stream";
+    xml << "      <" << tag << " UID=\"" << (ping ? 0 : 1) << "\" Name=\"" << stream_name(type, ping) << "\"";
+    if (tag != "A825_Stream") xml << " Direction=\"" << direction << "\"";     // A825 streams are bidirectional
+
+    if (type.signal_count == 0) {
+      if (type.sized) xml << " SampleMaxSizeBytes=\"" << sample_size(options, type) << "\"";
+      xml << " SampleMaxNumber=\"10\"/>" << std::endl;
+      return xml.str();
+    }
+
+    if (tag != "VNAD_Stream") xml << " SampleMaxSizeBytes=\"" << SEQUENCE_SIZE << "\"";
+    xml << " SampleMaxNumber=\"10\">" << std::endl;
+    xml << "        <Signals SamplingPeriodUs=\"10000\">" << std::endl;
+    for (uint32_t index = 0; index < type.signal_count; index++) {
+      xml << "          <Signal Name=\"" << signal_name(type, ping, index) << "\"";
+      if (tag == "NAD_Stream")       xml << " Type=\"uint32\" Dimensions=\"1\" ByteOffset=\"0\"";
+      else if (tag == "VNAD_Stream") xml << " Type=\"uint32\" MaxNumber=\"1\" Position=\"0\"";
+      else                           xml << " ByteOffset=\"" << index * SEQUENCE_SIZE / type.signal_count << "\"";
+      xml << "/>" << std::endl;
+    }
+    xml << "        </Signals>" << std::endl;
+    xml << "      </" << tag << ">" << std::endl;
+    return xml.str();
+  }
+
+  // ECIC of the pinger or the ponger. Stream type #i sends the pings on port+2i and the pongs on port+2i+1.
+  std::string generate_ecic(const options_t& options, bool pinger)
+  {
+    std::ostringstream xml;
+    xml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
+    xml << "<ED247ComponentInstanceConfiguration ComponentType=\"Virtual\" Name=\"" << (pinger ? "Pinger" : "Ponger") << "\""
+        << " StandardRevision=\"A\" Identifier=\"" << (pinger ? 1 : 2) << "\">" << std::endl;
+    xml << "  <Channels>" << std::endl;
+
+    for (uint32_t index = 0; index < options.types.size(); index++) {
+      const stream_type_t& type = *options.types[index];
+      uint32_t ping_port = options.port + 2 * index;
+      uint32_t pong_port = ping_port + 1;
+
+      xml << "  <MultiChannel Name=\"" << type.name << "_Channel\">" << std::endl;
+      xml << "    <FrameFormat StandardRevision=\"A\"/>" << std::endl;
+      xml << "    <ComInterface>" << std::endl;
+      xml << "      <UDP_Sockets>" << std::endl;
+      xml << "        <UDP_Socket DstIP=\"" << options.peer_ip << "\" DstPort=\"" << (pinger ? ping_port : pong_port) << "\" Direction=\"Out\"/>" << std::endl;
+      xml << "        <UDP_Socket DstIP=\"" << options.local_ip << "\" DstPort=\"" << (pinger ? pong_port : ping_port) << "\" Direction=\"In\"/>" << std::endl;
+      xml << "      </UDP_Sockets>" << std::endl;
+      xml << "    </ComInterface>" << std::endl;
+      xml << "    <Streams>" << std::endl;
+      xml << stream_xml(options, type, true, pinger ? "Out" : "In");
+      xml << stream_xml(options, type, false, pinger ? "In" : "Out");
+      xml << "    </Streams>" << std::endl;
+      xml << "  </MultiChannel>" << std::endl;
+    }
+
+    xml << "  </Channels>" << std::endl;
+    xml << "</ED247ComponentInstanceConfiguration>" << std::endl;
+    return xml.str();
+  }
+
+  ed247_context_t load(const options_t& options, bool pinger)
+  {
+    ed247_context_t context = nullptr;
+    if (ed247_load_content(generate_ecic(options, pinger).c_str(), &context) != ED247_STATUS_SUCCESS) return nullptr;
+    if (options.spin_us != 0 && ed247_component_set_busy_poll(context, options.spin_us, 0) != ED247_STATUS_SUCCESS) {
+      ed247_unload(context);
+      return nullptr;
+    }
+    return context;
+  }
+
+
+  //
+  // Ponger
+  //
+  struct echo_t {
+    ed247_stream_t input;
+    ed247_stream_t output;
+  };
+
+  // Echo the pings until stop (or stop_requested) is set. Return false on failure.
+  bool pong(ed247_context_t context, const options_t& options, const std::atomic<bool>& stop)
+  {
+    std::vector<echo_t> echoes;
+    std::vector<ed247_channel_t> channels;
+    for (const stream_type_t* type : options.types) {
+      echo_t echo;
+      ed247_channel_t channel;
+      if (ed247_get_stream(context, stream_name(*type, true).c_str(), &echo.input) != ED247_STATUS_SUCCESS ||
+          ed247_get_stream(context, stream_name(*type, false).c_str(), &echo.output) != ED247_STATUS_SUCCESS ||
+          ed247_get_channel(context, (std::string(type->name) + "_Channel").c_str(), &channel) != ED247_STATUS_SUCCESS) {
+        return false;
+      }
+      echoes.push_back(echo);
+      channels.push_back(channel);
+    }
+
+    while (stop == false && stop_requested == 0) {
+      ed247_status_t status = ed247_wait_frame(context, nullptr, PONG_WAIT_US);
+      if (status == ED247_STATUS_TIMEOUT) continue;
+      if (status != ED247_STATUS_SUCCESS) return false;
+
+      for (uint32_t index = 0; index < echoes.size(); index++) {
+        const void* sample;
+        uint32_t sample_size;
+        bool pushed = false;
+        while (ed247_stream_pop_sample(echoes[index].input, &sample, &sample_size, nullptr, nullptr, nullptr, nullptr) == ED247_STATUS_SUCCESS) {
+          if (ed247_stream_push_sample(echoes[index].output, sample, sample_size, nullptr, nullptr) != ED247_STATUS_SUCCESS) return false;
+          pushed = true;
+        }
+        if (pushed && ed247_channel_send_pushed_samples(channels[index]) != ED247_STATUS_SUCCESS) return false;
+      }
+    }
+    return true;
+  }
+
+
+  //
+  // Pinger
+  //
+  class Pinger {
+  public:
+    Pinger(ed247_context_t context, const options_t& options, const stream_type_t& type) :
+      _context(context), _options(options), _type(type),
+      _sample(sample_size(options, type), 0)
+    {
+    }
+
+    // Return false on failure
+    bool run()
+    {
+      if (ed247_get_stream(_context, stream_name(_type, true).c_str(), &_ping) != ED247_STATUS_SUCCESS ||
+          ed247_get_stream(_context, stream_name(_type, false).c_str(), &_pong) != ED247_STATUS_SUCCESS ||
+          ed247_get_channel(_context, (std::string(_type.name) + "_Channel").c_str(), &_channel) != ED247_STATUS_SUCCESS) {
+        return false;
+      }
+      if (_type.signal_count != 0) {
+        if (ed247_stream_get_assistant(_ping, &_ping_assistant) != ED247_STATUS_SUCCESS ||
+            ed247_stream_get_assistant(_pong, &_pong_assistant) != ED247_STATUS_SUCCESS) {
+          return false;
+        }
+        for (uint32_t index = 0; index < _type.signal_count; index++) {
+          ed247_signal_t ping_signal, pong_signal;
+          if (ed247_get_signal(_context, signal_name(_type, true, index).c_str(), &ping_signal) != ED247_STATUS_SUCCESS ||
+              ed247_get_signal(_context, signal_name(_type, false, index).c_str(), &pong_signal) != ED247_STATUS_SUCCESS) {
+            return false;
+          }
+          _ping_signals.push_back(ping_signal);
+          _pong_signals.push_back(pong_signal);
+        }
+      }
+
+      _latencies_ns.reserve(_options.iterations);
+      uint64_t total = _options.warmup + _options.iterations;
+      for (uint64_t iteration = 0; iteration < total && stop_requested == 0; iteration++) {
+        _sequence++;
+        uint64_t start_ns = now_ns();
+        if (send() == false) return false;
+
+        bool received = false;
+        uint64_t deadline_ns = start_ns + (uint64_t)_options.timeout_ms * 1000000;
+        while (true) {
+          if (receive(received) == false) return false;
+          if (received) break;
+
+          uint64_t current_ns = now_ns();
+          if (current_ns >= deadline_ns) break;
+          ed247_status_t status = ed247_wait_frame(_context, nullptr, (int32_t)((deadline_ns - current_ns + 999) / 1000));
+          if (status == ED247_STATUS_FAILURE) return false;
+        }
+        uint64_t end_ns = now_ns();
+
+        _consecutive_losses = received ? 0 : _consecutive_losses + 1;
+        if (_consecutive_losses == MAX_CONSECUTIVE_LOSSES) {
+          PRINT_ERROR("Stream " << _type.name << ": " << MAX_CONSECUTIVE_LOSSES << " consecutive pongs lost. Is the ponger running with the same options?");
+          if (iteration >= _options.warmup) _lost_count++;
+          break;
+        }
+        if (iteration < _options.warmup) continue;
+        if (received) {
+          _latencies_ns.push_back(end_ns - start_ns);
+        } else {
+          _lost_count++;
+        }
+      }
+      return true;
+    }
+
+    // Print the latencies of the measured round trips
+    void report() const
+    {
+      std::vector<uint64_t> sorted(_latencies_ns);
+      std::sort(sorted.begin(), sorted.end());
+
+      std::cout << std::left << std::setw(8) << _type.name << std::right
+                << std::setw(10) << sorted.size() << std::setw(8) << _lost_count;
+      for (double percentile : { 0.0, 0.50, 0.99, 0.999, 1.0 }) {
+        std::cout << std::setw(11);
+        if (sorted.empty()) {
+          std::cout << "-";
+        } else {
+          // Nearest-rank percentile
+          size_t rank = (size_t)std::ceil(percentile * sorted.size());
+          std::cout << std::fixed << std::setprecision(2) << sorted[rank == 0 ? 0 : rank - 1] / 1000.0;
+        }
+      }
+      std::cout << std::endl;
+    }
+
+  private:
+    bool send()
+    {
+      if (_type.signal_count == 0) {
+        memcpy(_sample.data(), &_sequence, SEQUENCE_SIZE);
+        if (ed247_stream_push_sample(_ping, _sample.data(), _sample.size(), nullptr, nullptr) != ED247_STATUS_SUCCESS) return false;
+      } else {
+        const char* sequence = (const char*)&_sequence;
+        uint32_t signal_size = SEQUENCE_SIZE / _type.signal_count;
+        for (uint32_t index = 0; index < _type.signal_count; index++) {
+          if (ed247_stream_assistant_write_signal(_ping_assistant, _ping_signals[index], sequence + index * signal_size, signal_size) != ED247_STATUS_SUCCESS) {
+            return false;
+          }
+        }
+        if (ed247_stream_assistant_push_sample(_ping_assistant, nullptr, nullptr) != ED247_STATUS_SUCCESS) return false;
+      }
+      return ed247_channel_send_pushed_samples(_channel) == ED247_STATUS_SUCCESS;
+    }
+
+    // Pop the received pongs. Set received if the current sequence number is echoed (older ones are late pongs).
+    bool receive(bool& received)
+    {
+      while (true) {
+        uint32_t sequence = 0;
+        ed247_status_t status;
+
+        if (_type.signal_count == 0) {
+          const void* sample;
+          uint32_t size;
+          status = ed247_stream_pop_sample(_pong, &sample, &size, nullptr, nullptr, nullptr, nullptr);
+          if (status == ED247_STATUS_SUCCESS && size >= SEQUENCE_SIZE) memcpy(&sequence, sample, SEQUENCE_SIZE);
+        } else {
+          status = ed247_stream_assistant_pop_sample(_pong_assistant, nullptr, nullptr, nullptr, nullptr);
+          uint32_t signal_size = SEQUENCE_SIZE / _type.signal_count;
+          for (uint32_t index = 0; status == ED247_STATUS_SUCCESS && index < _type.signal_count; index++) {
+            const void* data;
+            uint32_t size;
+            if (ed247_stream_assistant_read_signal(_pong_assistant, _pong_signals[index], &data, &size) != ED247_STATUS_SUCCESS) return false;
+            if (size == signal_size) memcpy((char*)&sequence + index * signal_size, data, signal_size);
+          }
+        }
+
+        if (status == ED247_STATUS_NODATA) return true;
+        if (status != ED247_STATUS_SUCCESS) return false;
+        if (sequence == _sequence) received = true;
+      }
+    }
+
+    ed247_context_t             _context;
+    const options_t&            _options;
+    const stream_type_t&        _type;
+    ed247_stream_t              _ping{nullptr};
+    ed247_stream_t              _pong{nullptr};
+    ed247_channel_t             _channel{nullptr};
+    ed247_stream_assistant_t    _ping_assistant{nullptr};
+    ed247_stream_assistant_t    _pong_assistant{nullptr};
+    std::vector<ed247_signal_t> _ping_signals;
+    std::vector<ed247_signal_t> _pong_signals;
+    std::vector<char>           _sample;
+    uint32_t                    _sequence{0};
+    std::vector<uint64_t>       _latencies_ns;
+    uint64_t                    _lost_count{0};
+    uint32_t                    _consecutive_losses{0};
+  };
+
+  // Ping each stream type in turn and print the latency table. Return false on failure.
+  bool ping(ed247_context_t context, const options_t& options)
+  {
+    SAY("Round trips per stream type: " << options.iterations << " (+" << options.warmup << " warm-up), byte stream sample size: "
+        << options.size << " bytes");
+    std::cout << std::left << std::setw(8) << "Stream" << std::right << std::setw(10) << "Samples" << std::setw(8) << "Lost"
+              << std::setw(11) << "Min(us)" << std::setw(11) << "P50(us)" << std::setw(11) << "P99(us)"
+              << std::setw(11) << "P99.9(us)" << std::setw(11) << "Max(us)" << std::endl;
+
+    for (const stream_type_t* type : options.types) {
+      Pinger pinger(context, options, *type);
+      if (pinger.run() == false) {
+        PRINT_ERROR("Ping of the " << type->name << " stream failed");
+        return false;
+      }
+      pinger.report();
+      if (stop_requested) break;
+    }
+    return true;
+  }
+
+
+  bool parse_unsigned(const char* arg, uint64_t& value)
+  {
+    char* last;
+    value = strtoull(arg, &last, 10);
+    return *arg != '\0' && *last == '\0';
+  }
+
+  bool parse_types(const std::string& list, std::vector<const stream_type_t*>& types)
+  {
+    std::istringstream stream(list);
+    std::string name;
+    while (std::getline(stream, name, ',')) {
+      auto type = std::find_if(std::begin(STREAM_TYPES), std::end(STREAM_TYPES),
+                               [&name](const stream_type_t& t) { return name == t.name; });
+      if (type == std::end(STREAM_TYPES)) {
+        PRINT_ERROR("Unknown stream type '" << name << "'");
+        return false;
+      }
+      types.push_back(type);
+    }
+    return types.empty() == false;
+  }
+
+  bool parse_options(int argc, char *argv[], options_t& options)
+  {
+    int index = 1;
+    for (; index < argc && argv[index][0] == '-'; index++) {
+      std::string option = argv[index];
+      if (option == "-g") {
+        options.generate_only = true;
+        continue;
+      }
+      if (option.size() != 2 || strchr("nwstlrpob", option[1]) == nullptr) {
+        PRINT_ERROR("Unknown option '" << option << "'");
+        return false;
+      }
+      if (++index == argc) {
+        PRINT_ERROR("Missing value of option '" << option << "'");
+        return false;
+      }
+
+      const char* arg = argv[index];
+      uint64_t value = 0;
+      bool valid = true;
+      switch (option[1]) {
+      case 'n': valid = parse_unsigned(arg, options.iterations); break;
+      case 'w': valid = parse_unsigned(arg, options.warmup); break;
+      case 's': valid = parse_unsigned(arg, value) && value >= SEQUENCE_SIZE && value <= 65535; options.size = value; break;
+      case 't': valid = parse_types(arg, options.types); break;
+      case 'l': options.local_ip = arg; break;
+      case 'r': options.peer_ip = arg; break;
+      case 'p': valid = parse_unsigned(arg, value) && value > 0 && value < 65535; options.port = value; break;
+      case 'o': valid = parse_unsigned(arg, value) && value > 0; options.timeout_ms = value; break;
+      case 'b': valid = parse_unsigned(arg, value); options.spin_us = value; break;
+      }
+      if (valid == false) {
+        PRINT_ERROR("Invalid value of option '" << option << "': '" << arg << "'");
+        return false;
+      }
+    }
+
+    if (index != argc - 1) return false;
+    options.mode = argv[index];
+    if (options.mode != "local" && options.mode != "ping" && options.mode != "pong") return false;
+
+    if (options.types.empty()) {
+      for (const stream_type_t& type : STREAM_TYPES) options.types.push_back(&type);
+    }
+    if (options.port + 2 * options.types.size() > 65536) {
+      PRINT_ERROR("Port range exceeds 65535");
+      return false;
+    }
+    return true;
+  }
+
+}
+
+
+int main(int argc, char *argv[])
+{
+    options_t options;
+    if (parse_options(argc, argv, options) == false) {
+      help();
+      return EXIT_FAILURE;
+    }
+
+    bool pinger = (options.mode != "pong");
+    bool ponger = (options.mode != "ping");
+
+    if (options.generate_only) {
+      if (pinger) std::cout << generate_ecic(options, true);
+      if (ponger) std::cout << generate_ecic(options, false);
+      return EXIT_SUCCESS;
+    }
+
+    signal(SIGINT, &request_stop);
+    signal(SIGTERM, &request_stop);
+
+    ed247_context_t ping_context = nullptr;
+    ed247_context_t pong_context = nullptr;
+    if ((pinger && (ping_context = load(options, true)) == nullptr) ||
+        (ponger && (pong_context = load(options, false)) == nullptr)) {
+      PRINT_ERROR("Failed to load the generated ECIC");
+      if (ping_context) ed247_unload(ping_context);
+      return EXIT_FAILURE;
+    }
+
+    bool success = true;
+    std::atomic<bool> stop_pong{false};
+    if (options.mode == "pong") {
+      SAY("Echo the pings until interrupted...");
+      success = pong(pong_context, options, stop_pong);
+    } else if (options.mode == "ping") {
+      success = ping(ping_context, options);
+    } else {
+      std::atomic<bool> pong_success{true};
+      std::thread pong_thread([&]() { pong_success = pong(pong_context, options, stop_pong); });
+      success = ping(ping_context, options);
+      stop_pong = true;
+      pong_thread.join();
+      success = success && pong_success;
+    }
+
+    if (ping_context) ed247_unload(ping_context);
+    if (pong_context) ed247_unload(pong_context);
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include <fstream>
+#include <csignal>
+
+#include <ed247.h>
+#include "ed247_logs.h"
+#include "time_tools.h"
+#include "pcap_tools.h"
+
+//
+// Record the traffic received by an ECIC into a pcapng file.
+// Each datagram is stored with its kernel receive timestamp, its addresses
+// and the name of its channel (packet comment). See the replayer utility.
+//
+
+void help() {
+  std::cout <<
+    "USAGE: recorder <ecic_file> <pcapng_file> <duration_ms>" << std::endl <<
+    "       Record during duration_ms (0: until interrupted)." << std::endl;
+}
+
+namespace {
+  volatile sig_atomic_t stop_requested = 0;
+  void request_stop(int) { stop_requested = 1; }
+
+  const int32_t WAIT_PERIOD_US = 100000;
+}
+
+void record_datagram(ed247_context_t, ed247_channel_t channel, const ed247_datagram_info_t* info,
+                     const void* frame, uint32_t frame_size, void* user_data)
+{
+  static bool write_error = false;
+  uint64_t timestamp_ns = (uint64_t)info->timestamp.epoch_s * 1000000000 + info->timestamp.offset_ns;
+
+  bool written = ((pcap::Writer*)user_data)->write(timestamp_ns,
+                                                   info->source_ip, info->source_port,
+                                                   info->destination_ip, info->destination_port,
+                                                   frame, frame_size, channel ? ed247_channel_get_name(channel) : "");
+  if (written == false && write_error == false) {
+    PRINT_ERROR("Failed to write the capture file");
+    write_error = true;
+  }
+}
+
+int main(int argc, char *argv[])
+{
+    ed247_context_t context = nullptr;
+    pcap::Writer    writer;
+
+    if (argc != 4) {
+      help();
+      return EXIT_FAILURE;
+    }
+
+    char* last;
+    uint64_t duration_us = strtoull(argv[3], &last, 10) * 1000;
+    if (*last) {
+      PRINT_ERROR("Invalid duration argument: '" << argv[3] << "'");
+      return EXIT_FAILURE;
+    }
+
+    if (ed247_load_file(argv[1], &context) != ED247_STATUS_SUCCESS) return EXIT_FAILURE;
+    PRINT_INFO("ECIC file : '" << argv[1] << "'");
+
+    if (writer.open(argv[2]) == false) {
+      PRINT_ERROR("Cannot open file '" << argv[2] << "'");
+      ed247_unload(context);
+      return EXIT_FAILURE;
+    }
+    SAY("Record to file " << argv[2]);
+
+    signal(SIGINT, &request_stop);
+    signal(SIGTERM, &request_stop);
+    ed247_set_datagram_recv_callback(context, &record_datagram, &writer);
+
+    ed247_status_t status = ED247_STATUS_SUCCESS;
+    uint64_t start_us = time_tools::get_monotonic_time_us();
+    while (stop_requested == 0 && status != ED247_STATUS_FAILURE) {
+      int32_t wait_us = WAIT_PERIOD_US;
+      if (duration_us != 0) {
+        uint64_t elapsed_us = time_tools::get_monotonic_time_us() - start_us;
+        if (elapsed_us >= duration_us) break;
+        if (duration_us - elapsed_us < (uint64_t)wait_us) wait_us = duration_us - elapsed_us;
+      }
+      status = ed247_wait_during(context, nullptr, wait_us);
+    }
+
+    ed247_set_datagram_recv_callback(context, nullptr, nullptr);
+    writer.close();
+    SAY("Recorded " << writer.get_datagram_count() << " datagrams");
+
+    ed247_unload(context);
+    return (status == ED247_STATUS_FAILURE) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,204 @@
+/******************************************************************************
+ * The MIT Licence
+ *
+ * Copyright (c) 2021 Airbus Operations S.A.S
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+#include <fstream>
+#include <cstring>
+#include <unordered_map>
+
+#include <ed247.h>
+#include "ed247_logs.h"
+#include "time_tools.h"
+#include "pcap_tools.h"
+
+//
+// Replay a pcap/pcapng capture through the output UdpSockets of an ECIC.
+// A datagram is sent in the channel named by its packet comment (see the recorder
+// utility), or in the --channel one. The inter-datagram timing of the capture is
+// reproduced, divided by the --speed factor.
+//
+// --batch sends without sleeping the datagrams due within the batch window. With
+// the UDP transport, each datagram is still sent by its own sendto(): the option
+// only saves the sleeps (datagrams may leave up to the window early). Only the
+// io_uring engine (ED247_IO_URING=1) submits a batch in a single system call.
+//
+
+void help() {
+  std::cout <<
+    "USAGE: replayer [options] <ecic_file> <capture_file>" << std::endl <<
+    "OPTIONS:" << std::endl <<
+    "  --speed <factor>  Replay <factor> times faster than recorded (default 1, 0: as fast as possible)" << std::endl <<
+    "  --batch <us>      Send without sleeping the datagrams due within <us> microseconds (default 0)." << std::endl <<
+    "                    They are submitted together by the io_uring engine only (ED247_IO_URING=1)." << std::endl <<
+    "  --loop <count>    Replay the capture <count> times (default 1, 0: forever)" << std::endl <<
+    "  --channel <name>  Channel of the datagrams without channel name (captures of other tools)" << std::endl;
+}
+
+namespace {
+  // Sleep until the last SPIN_US before a deadline, then spin
+  const uint64_t SPIN_US = 200;
+
+  struct options_t {
+    double      speed{1.0};
+    uint64_t    batch_us{0};
+    uint32_t    loop_count{1};
+    std::string default_channel;
+  };
+
+  struct statistics_t {
+    uint64_t sent{0};
+    uint64_t dropped{0};
+    uint64_t late_sum_us{0};
+    uint64_t late_max_us{0};
+  };
+}
+
+void wait_until(uint64_t deadline_us)
+{
+  uint64_t now_us = time_tools::get_monotonic_time_us();
+  if (deadline_us > now_us + SPIN_US) {
+    time_tools::sleep_us(deadline_us - now_us - SPIN_US);
+  }
+  while (time_tools::get_monotonic_time_us() < deadline_us);
+}
+
+// Return nullptr if the datagram has no known channel
+ed247_channel_t find_channel(ed247_context_t context, const options_t& options, const pcap::datagram_t& datagram)
+{
+  static std::unordered_map<std::string, ed247_channel_t> channels;
+  const std::string& name = datagram.comment.empty() ? options.default_channel : datagram.comment;
+  if (name.empty()) return nullptr;
+
+  auto found = channels.find(name);
+  if (found == channels.end()) {
+    ed247_channel_t channel = nullptr;
+    if (ed247_get_channel(context, name.c_str(), &channel) != ED247_STATUS_SUCCESS) {
+      PRINT_WARNING("Channel '" << name << "' not found in the ECIC: its datagrams are dropped");
+      channel = nullptr;
+    }
+    found = channels.emplace(name, channel).first;
+  }
+  return found->second;
+}
+
+bool replay(ed247_context_t context, const std::string& capture_file, const options_t& options, statistics_t& statistics)
+{
+  pcap::Reader reader;
+  pcap::datagram_t datagram;
+  if (reader.open(capture_file) == false) {
+    PRINT_ERROR("Cannot read capture file '" << capture_file << "'");
+    return false;
+  }
+
+  bool first = true;
+  uint64_t origin_ns = 0;
+  uint64_t start_us = 0;
+  while (reader.next(datagram)) {
+    ed247_channel_t channel = find_channel(context, options, datagram);
+    if (channel == nullptr) {
+      statistics.dropped++;
+      continue;
+    }
+
+    if (first) {
+      origin_ns = datagram.timestamp_ns;
+      start_us = time_tools::get_monotonic_time_us();
+      first = false;
+    }
+
+    if (options.speed > 0) {
+      uint64_t offset_ns = (datagram.timestamp_ns > origin_ns) ? datagram.timestamp_ns - origin_ns : 0;
+      uint64_t due_us = start_us + (uint64_t)(offset_ns / 1000 / options.speed);
+      uint64_t now_us = time_tools::get_monotonic_time_us();
+      if (due_us > now_us + options.batch_us) {
+        // End of the batch: submit the queued frames before sleeping
+        ed247_send_pushed_samples(context);
+        wait_until(due_us);
+        now_us = time_tools::get_monotonic_time_us();
+      }
+      if (now_us > due_us + options.batch_us) {
+        uint64_t late_us = now_us - due_us;
+        statistics.late_sum_us += late_us;
+        if (late_us > statistics.late_max_us) statistics.late_max_us = late_us;
+      }
+    }
+
+    if (ed247_channel_send_frame(channel, datagram.payload.data(), datagram.payload.size()) != ED247_STATUS_SUCCESS) return false;
+    statistics.sent++;
+  }
+  ed247_send_pushed_samples(context);
+
+  if (reader.get_skipped_count() != 0) {
+    PRINT_INFO(reader.get_skipped_count() << " packets are not UDP/IPv4 datagrams");
+  }
+  return true;
+}
+
+int main(int argc, char *argv[])
+{
+    ed247_context_t context = nullptr;
+    options_t       options;
+    statistics_t    statistics;
+
+    int arg = 1;
+    for (; arg + 1 < argc && strncmp(argv[arg], "--", 2) == 0; arg += 2) {
+      std::string option = argv[arg];
+      const char* value = argv[arg + 1];
+      char* last = nullptr;
+      if (option == "--speed") {
+        options.speed = strtod(value, &last);
+      } else if (option == "--batch") {
+        options.batch_us = strtoull(value, &last, 10);
+      } else if (option == "--loop") {
+        options.loop_count = strtoul(value, &last, 10);
+      } else if (option == "--channel") {
+        options.default_channel = value;
+      } else {
+        help();
+        return EXIT_FAILURE;
+      }
+      if ((last != nullptr && *last) || options.speed < 0) {
+        PRINT_ERROR("Invalid " << option << " argument: '" << value << "'");
+        return EXIT_FAILURE;
+      }
+    }
+    if (argc - arg != 2) {
+      help();
+      return EXIT_FAILURE;
+    }
+
+    if (ed247_load_file(argv[arg], &context) != ED247_STATUS_SUCCESS) return EXIT_FAILURE;
+    PRINT_INFO("ECIC file : '" << argv[arg] << "'");
+
+    bool success = true;
+    for (uint32_t loop = 0; success && (options.loop_count == 0 || loop < options.loop_count); loop++) {
+      success = replay(context, argv[arg + 1], options, statistics);
+    }
+
+    SAY("Sent " << statistics.sent << " datagrams (" << statistics.dropped << " without channel)");
+    if (options.speed > 0 && statistics.sent != 0) {
+      SAY("Lateness: mean " << statistics.late_sum_us / statistics.sent << "us, max " << statistics.late_max_us << "us");
+    }
+
+    ed247_unload(context);
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}